@@ -0,0 +1,33 @@
+#include "OpenColorIOCpu.hpp"
+
+#include <duke/base/ParallelFor.hpp>
+
+namespace OCIO = OCIO_NAMESPACE;
+
+namespace duke {
+
+OCIO::ConstProcessorRcPtr createDisplayProcessor(const std::string &inputColorSpace, const std::string &lutFilePath) {
+  OCIO::ConstConfigRcPtr config = OCIO::GetCurrentConfig();
+  if (!lutFilePath.empty()) {
+    OCIO::FileTransformRcPtr transform = OCIO::FileTransform::Create();
+    transform->setSrc(lutFilePath.c_str());
+    transform->setInterpolation(OCIO::INTERP_BEST);
+    return config->getProcessor(transform);
+  }
+  const char *display = config->getDefaultDisplay();
+  OCIO::DisplayTransformRcPtr transform = OCIO::DisplayTransform::Create();
+  transform->setInputColorSpaceName(inputColorSpace.c_str());
+  transform->setDisplay(display);
+  transform->setView(config->getDefaultView(display));
+  return config->getProcessor(transform);
+}
+
+void applyProcessor(const OCIO::ConstProcessorRcPtr &processor, RgbaImage &image, unsigned threads) {
+  if (processor->isNoOp()) return;
+  parallelFor(image.height, threads, [&](size_t begin, size_t end) {
+    OCIO::PackedImageDesc rows(image.row(begin), image.width, end - begin, 4);
+    processor->apply(rows);
+  });
+}
+
+} /* namespace duke */
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <duke/engine/ColorTransforms.hpp>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include <string>
+
+namespace duke {
+
+// The processor applied by the viewer, a lut file when lutFilePath is not
+// empty, the default display and view of the current config otherwise.
+// Throws OCIO::Exception.
+OCIO_NAMESPACE::ConstProcessorRcPtr createDisplayProcessor(const std::string &inputColorSpace,
+                                                           const std::string &lutFilePath);
+
+// Applies processor to the image in place, rows split across threads, 0 uses
+// the hardware concurrency.
+void applyProcessor(const OCIO_NAMESPACE::ConstProcessorRcPtr &processor, RgbaImage &image, unsigned threads = 0);
+
+} /* namespace duke */
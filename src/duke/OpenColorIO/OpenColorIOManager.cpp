@@ -1,208 +1,182 @@
 #include "OpenColorIOManager.hpp"
+#include <duke/OpenColorIO/OpenColorIOCpu.hpp>
+#include <duke/engine/rendering/ShaderConstants.hpp>
+#include <duke/engine/rendering/ShaderPool.hpp>
 
-namespace duke {
+#include <algorithm>
 
-  OpenColorIOManager::OpenColorIOManager(std::string ColorspaceString, std::string lutFilePath)
-{  
-  Initialize(ColorspaceString, lutFilePath);
-}
+namespace duke {
 
-  void OpenColorIOManager::Initialize(std::string ColorspaceString, std::string lutFilePath) 
-{ 
-  this->config = OCIO::GetCurrentConfig();
-   if (lutFilePath != "")
-  {
-  this->filetransform = OCIO::FileTransform::Create();
+namespace {
+
+// Number of LUTs kept by the worker, a 65^3 LUT weights 1.6MiB.
+const size_t kMaxCachedLuts = 8;
+
+// Replaces the trilinear texture3D lookups of the OCIO function. The
+// coordinates address texel centers as for texture().
+const char pSampleLut3dTetrahedral[] = R"(
+vec4 sampleLut3dTetrahedral(sampler3D lut, vec3 coordinates) {
+  vec3 size = vec3(textureSize(lut, 0));
+  vec3 position = clamp(coordinates * size - 0.5, vec3(0.0), size - 1.0);
+  vec3 base = min(floor(position), size - 2.0);
+  vec3 f = position - base;
+  ivec3 p = ivec3(base);
+  // the tetrahedron containing f goes from 000 to 111 through v1 and v2,
+  // w holds f sorted in decreasing order
+  ivec3 v1, v2;
+  vec3 w;
+  if (f.x >= f.y) {
+    if (f.y >= f.z)      { v1 = ivec3(1, 0, 0); v2 = ivec3(1, 1, 0); w = f.xyz; }
+    else if (f.x >= f.z) { v1 = ivec3(1, 0, 0); v2 = ivec3(1, 0, 1); w = f.xzy; }
+    else                 { v1 = ivec3(0, 0, 1); v2 = ivec3(1, 0, 1); w = f.zxy; }
+  } else {
+    if (f.z >= f.y)      { v1 = ivec3(0, 0, 1); v2 = ivec3(0, 1, 1); w = f.zyx; }
+    else if (f.z >= f.x) { v1 = ivec3(0, 1, 0); v2 = ivec3(0, 1, 1); w = f.yzx; }
+    else                 { v1 = ivec3(0, 1, 0); v2 = ivec3(1, 1, 0); w = f.yxz; }
   }
-  else { this->transform = OCIO::DisplayTransform::Create();}
+  vec3 rgb = (1.0 - w.x) * texelFetch(lut, p, 0).rgb       //
+             + (w.x - w.y) * texelFetch(lut, p + v1, 0).rgb  //
+             + (w.y - w.z) * texelFetch(lut, p + v2, 0).rgb  //
+             + w.z * texelFetch(lut, p + ivec3(1), 0).rgb;
+  return vec4(rgb, 1.0);
+}
+)";
+
+// The programs sampling images with the given OCIO function.
+std::vector<ShaderDescription> getImageVariants(const std::string &shaderText) {
+  std::vector<ShaderDescription> variants;
+  for (const bool tenBitUnpack : {false, true})
+    variants.push_back(ShaderDescription::createTextureDesc(false, false, false, tenBitUnpack, ColorSpace::linear,
+                                                            ColorSpace::linear, shaderText));
+  variants.push_back(ShaderDescription::createTextureDesc(false, false, false, false, ColorSpace::linear,
+                                                          ColorSpace::linear, shaderText, true));
+  return variants;
+}
 
-  this->display = config->getDefaultDisplay();
-  this->transformName = config->getDefaultView(this->display.c_str());
-  this->inputColorSpace = ColorspaceString;
-  this->lutFilePath= lutFilePath;
+}  // namespace
 
-  //std::cout << "Initializing transform Name: "<<  this->transformName.c_str() << std::endl;
-  //std::cout << "Initializing input Color Space: "<<  this->inputColorSpace.c_str() << std::endl;
-  // std::cout << "Initializing Display: "<< this->display.c_str() << std::endl;
+OpenColorIOManager::OpenColorIOManager(std::string ColorspaceString, std::string lutFilePath, unsigned lut3dEdgeSize,
+                                       std::function<void()> onReady)
+    : flag_raw(false), LUT3D_EDGE_SIZE(lut3dEdgeSize), m_OnReady(onReady), lut3dTexID(shader::LUT3D_TEXTURE_UNIT) {
+  request(ColorspaceString, lutFilePath);
+  m_Worker = std::thread(&OpenColorIOManager::workerFunction, this);
+}
 
-  this->program = 0;
-  this->lut3dTexID = 2;
-  this->LUT3D_EDGE_SIZE = 32;
-  this-> Buf3D = new Buffer3D(LUT3D_EDGE_SIZE);
+OpenColorIOManager::~OpenColorIOManager() {
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_Condition.notify_all();
+  m_Worker.join();
+}
 
-  if (ColorspaceString=="raw")
-    {
-      this->flag_raw = true;
-    }
-  else 
-    {flag_raw = false;}
+void OpenColorIOManager::request(std::string ColorspaceString, std::string lutFilePath) {
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_pRequest.reset(new Request{ColorspaceString, lutFilePath});
+  }
+  m_Condition.notify_all();
+}
 
-  //IF WE EVER NEED TO CHANGE THE EXPOSURE AND GAMMA THROUGH OCIO
-   //this->channelHot[0] = 1;  
-  //this->channelHot[1] = 1;   
-  //this->channelHot[2] = 1;   
-  //this->channelHot[3] = 1;
-  //this->exposure_fstop = 0.0f;
-  //this->display_gamma = 1.0f;
+bool OpenColorIOManager::update(const ShaderPool &shaderPool, bool wait) {
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    if (wait) m_Condition.wait(lock, [this] { return !m_pRequest && !m_Building; });
+    if (m_pReady) m_pNext = std::move(m_pReady);
+  }
+  if (!m_pNext) return false;
 
+  // keeping the current pipeline until the new programs are built
+  bool ready = true;
+  for (const auto &variant : getImageVariants(m_pNext->shaderText))
+    ready = shaderPool.prepare(variant) && ready;
+  if (!ready && !wait) return false;
 
+  if (m_pNext->lut3dCacheId != lut3dcacheid) {
+    lut3dcacheid = m_pNext->lut3dCacheId;
+    m_pNext->pLut3d->uploadTo(m_tex, lut3dTexID);
+  }
+  output = m_pNext->shaderText;
+  flag_raw = m_pNext->raw;
+  m_pNext.reset();
+  return true;
 }
 
-OpenColorIOManager::~OpenColorIOManager()
-{
-  delete Buf3D;
+bool OpenColorIOManager::isPending() const {
+  if (m_pNext) return true;
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_pRequest || m_Building || m_pReady;
 }
 
-void OpenColorIOManager::SetState()
-{
-   if (lutFilePath != "")
-     {
-       //std::cout << "SetState LutFilePath " <<lutFilePath <<std::endl;
-     filetransform->setSrc(lutFilePath.c_str());
-     filetransform->setInterpolation(OCIO::INTERP_BEST);
-
-    try
-    {
-        processor = config->getProcessor(filetransform);
-    }
-    catch(OCIO::Exception & e)
+void OpenColorIOManager::workerFunction() {
+  for (;;) {
+    Request request;
     {
-        std::cerr << e.what() << std::endl;
-        std::cout << "SetState"  <<std::endl;
-        return;
-
-    }
-    catch(...)
-    {   return;
-
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_Building = false;
+      m_Condition.notify_all();
+      m_Condition.wait(lock, [this] { return m_Stop || m_pRequest; });
+      if (m_Stop) return;
+      request = std::move(*m_pRequest);
+      m_pRequest.reset();
+      m_Building = true;
     }
-
-  }
-  
-  else
-    { //std::cout <<" Step 0: Get the processor using any of the pipelines mentioned above (LutFilePath)" <<std::endl;
-  OCIO::DisplayTransformRcPtr transform = OCIO::DisplayTransform::Create();
-  transform->setInputColorSpaceName(inputColorSpace.c_str() );
-  transform->setDisplay( display.c_str() );
-  transform->setView( transformName.c_str() );
-
-    /*
-   //IF WE EVER NEED TO CHANGE THE EXPOSURE AND GAMMA THROUGH OCIO
-       // Fstop exposure control (in SCENE_LINEAR)
-
-       {
-           float gain = powf(2.0f, exposure_fstop);
-           const float slope4f[] = { gain, gain, gain, gain };
-           float m44[16];
-           float offset4[4];
-           OCIO::MatrixTransform::Scale(m44, offset4, slope4f);
-           OCIO::MatrixTransformRcPtr mtx =  OCIO::MatrixTransform::Create();
-           mtx->setValue(m44, offset4);
-           transform->setLinearCC(mtx);
-       }
-
-       // Channel swizzling
-       {
-           float lumacoef[3];
-           config->getDefaultLumaCoefs(lumacoef);
-           float m44[16];
-           float offset[4];
-           OCIO::MatrixTransform::View(m44, offset, channelHot, lumacoef);
-           OCIO::MatrixTransformRcPtr swizzle = OCIO::MatrixTransform::Create();
-           swizzle->setValue(m44, offset);
-           transform->setChannelView(swizzle);
-       }
-
-       // Post-display transform gamma
-       {
-           float exponent = 1.0f/std::max(1e-6f, static_cast<float>(display_gamma));
-           const float exponent4f[] = { exponent, exponent, exponent, exponent };
-           OCIO::ExponentTransformRcPtr expTransform =  OCIO::ExponentTransform::Create();
-           expTransform->setValue(exponent4f);
-           transform->setDisplayCC(expTransform);
-       }
-
-  */
-
-    try
-    {
-        processor = config->getProcessor(transform);
+    SharedPipeline pPipeline;
+    try {
+      pPipeline = build(request);
+    } catch (OCIO::Exception &e) {
+      std::cerr << "OpenColorIO : " << e.what() << std::endl;
+    } catch (std::exception &e) {
+      std::cerr << "OpenColorIO : " << e.what() << std::endl;
     }
-    catch(OCIO::Exception & e)
+    if (!pPipeline) continue;  // keeping the current pipeline
     {
-        std::cerr << e.what() << std::endl;
-        std::cout << "SetState"  <<std::endl;
-        return;
-
-    }
-    catch(...)
-    {   return;
-
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_pReady = std::move(pPipeline);
     }
- }
-
-
-}
-
-
-void OpenColorIOManager::CreateGPUShaderDesc()
-{
-
-    // Step 1: Create a GPU Shader Description
-    shaderDesc.setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_0);
-    shaderDesc.setFunctionName("OCIODisplay");
-    shaderDesc.setLut3DEdgeLen(LUT3D_EDGE_SIZE);
-
- 
+    if (m_OnReady) m_OnReady();
+  }
 }
 
-void OpenColorIOManager::Compute3DLut()
-{
-  
-  // Step 2: Compute the 3D LUT
-    std::string lut3dCacheID = processor->getGpuLut3DCacheID(shaderDesc);
-    if(lut3dCacheID != lut3dcacheid)
-    {
-    
-        lut3dcacheid = lut3dCacheID;
-	
-	processor->getGpuLut3D(&Buf3D->rawBuffer[0], shaderDesc);
-	//std::cout << m_tex.id << " Here is compute3D Lut  " << m_tex.target << std::endl;
-
-	Buf3D->uploadTo(m_tex,lut3dTexID );			
-     }
-
+OpenColorIOManager::SharedPipeline OpenColorIOManager::build(const Request &request) {
+  const OCIO::ConstProcessorRcPtr processor = createDisplayProcessor(request.inputColorSpace, request.lutFilePath);
+
+  OCIO::GpuShaderDesc shaderDesc;
+  shaderDesc.setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_0);
+  shaderDesc.setFunctionName("OCIODisplay");
+  shaderDesc.setLut3DEdgeLen(LUT3D_EDGE_SIZE);
+
+  auto pPipeline = std::make_shared<Pipeline>();
+  pPipeline->pLut3d = getLut3d(processor, shaderDesc, pPipeline->lut3dCacheId);
+  pPipeline->raw = request.inputColorSpace == "raw";
+  std::string &text = pPipeline->shaderText;
+  text = processor->getGpuShaderText(shaderDesc);
+  text += '\n';
+  const std::string lookup = "texture3D(";
+  const std::string tetrahedral = "sampleLut3dTetrahedral(";
+  for (size_t pos = text.find(lookup); pos != std::string::npos; pos = text.find(lookup, pos + tetrahedral.size()))
+    text.replace(pos, lookup.size(), tetrahedral);
+  text.insert(0, pSampleLut3dTetrahedral);
+  return pPipeline;
 }
 
-std::string OpenColorIOManager::ComputeShader()
-{
-  
-    // Step 3: Compute the Shader
-    std::string shaderCacheID = processor->getGpuShaderTextCacheID(shaderDesc);
-    
-    if(program == 0 || shaderCacheID != shadercacheid)
-    {
-      //std::cerr << "Computing Shader " << shadercacheid << std::endl;
-
-        shadercacheid = shaderCacheID;
-
-	 std::ostringstream os;
-	os << processor->getGpuShaderText(shaderDesc) << "\n";
-
-        output = os.str();
-	//Remplace texture3D by texture
-	std::string goaway = "texture3D";
-	std::size_t pos = output.find(goaway); 
-	if (pos!= string::npos)
-	  {	
-	    output = output.replace(pos, goaway.length(), "texture"); 
-	  }
-	
-	}
-    return output;
+std::shared_ptr<const Buffer3D> OpenColorIOManager::getLut3d(const OCIO::ConstProcessorRcPtr &processor,
+                                                            const OCIO::GpuShaderDesc &shaderDesc,
+                                                            std::string &cacheId) {
+  cacheId = processor->getGpuLut3DCacheID(shaderDesc);
+  const auto pFound = m_Lut3dCache.find(cacheId);
+  if (pFound != m_Lut3dCache.end()) return pFound->second;
+  std::vector<float> rgb(3 * LUT3D_EDGE_SIZE * LUT3D_EDGE_SIZE * LUT3D_EDGE_SIZE);
+  processor->getGpuLut3D(rgb.data(), shaderDesc);
+  auto pLut = std::make_shared<const Buffer3D>(LUT3D_EDGE_SIZE, rgb.data());
+  if (m_Lut3dCacheOrder.size() == kMaxCachedLuts) {
+    m_Lut3dCache.erase(m_Lut3dCacheOrder.front());
+    m_Lut3dCacheOrder.pop_front();
+  }
+  m_Lut3dCacheOrder.push_back(cacheId);
+  m_Lut3dCache[cacheId] = pLut;
+  return pLut;
 }
 
-
-};//namespace duke
-
-
+} /* namespace duke */
@@ -8,7 +8,15 @@
 #include <cstring>
 #include <iostream>
 #include <vector>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <deque>
 #include "duke/gl/GlObjects.hpp"
+#include <duke/base/NonCopyable.hpp>
 
 //#include <GL/glew.h>
 #include <GL/gl.h>
@@ -33,47 +41,76 @@ OCIO_NAMESPACE_USING;
 
 namespace duke {
 
-  class OpenColorIOManager {
+struct ShaderPool;
 
-public:
-   OpenColorIOManager(std::string ColorspaceString, std::string lutFilePath);
+/**
+ * Builds the OCIO processor, its GLSL function and its 3D LUT.
+ * - Pipelines are built on a worker thread, a new request supersedes the
+ *   pending one.
+ * - LUTs are cached by their OCIO cache id so switching back and forth
+ *   between pipelines only costs the texture upload.
+ * - LUTs are stored as half floats and interpolated tetrahedrally by the
+ *   shader, the edge size trades accuracy for memory.
+ * - The render thread swaps the new pipeline in with update(), once the
+ *   programs using its shader text are built, so that changing the color
+ *   pipeline during playback does not stall the render loop.
+ */
+class OpenColorIOManager : public noncopyable {
+ public:
+  // onReady is called from the worker when a pipeline is ready to be swapped in.
+  OpenColorIOManager(std::string ColorspaceString, std::string lutFilePath, unsigned lut3dEdgeSize,
+                     std::function<void()> onReady = std::function<void()>());
   ~OpenColorIOManager();
-  
-    void SetState();
-    void CreateGPUShaderDesc();
-    void Compute3DLut();
-    std::string ComputeShader();
-   
-    std::string output;
-    gl::GlTexture3D m_tex;
-    bool flag_raw;
-  
-private:
-  void Initialize(std::string ColorspaceString, std::string lutFilePath);
-    
-    OCIO::ConstConfigRcPtr config;
-    OCIO::DisplayTransformRcPtr transform;
-    OCIO::FileTransformRcPtr filetransform;
 
+  // Asynchronous, an empty lutFilePath selects the display transform.
+  void request(std::string ColorspaceString, std::string lutFilePath);
+
+  // Render thread, returns true if a new pipeline was swapped in. When wait is
+  // set blocks until the pending request is built.
+  bool update(const ShaderPool &shaderPool, bool wait = false);
+
+  // True while a request is being built or its programs are compiling.
+  bool isPending() const;
+
+  std::string output;
+  gl::GlTexture3D m_tex;
+  bool flag_raw;
+
+ private:
+  struct Request {
     std::string inputColorSpace;
-    std::string display;
-    std::string transformName;
     std::string lutFilePath;
-  
-    GLuint program;
-    int LUT3D_EDGE_SIZE;
-    std::string lut3dcacheid;
-    std::string shadercacheid;
-    OCIO::ConstProcessorRcPtr processor;
-    OCIO::GpuShaderDesc shaderDesc;
-    GLuint lut3dTexID;
-    Buffer3D *Buf3D;
-
-    //float exposure_fstop;
-    //float display_gamma;
-    //int channelHot[4]; 
   };
-  
+  struct Pipeline {
+    std::string lut3dCacheId;
+    std::shared_ptr<const Buffer3D> pLut3d;
+    std::string shaderText;
+    bool raw;
+  };
+  typedef std::shared_ptr<const Pipeline> SharedPipeline;
+
+  void workerFunction();
+  SharedPipeline build(const Request &request);
+  std::shared_ptr<const Buffer3D> getLut3d(const OCIO::ConstProcessorRcPtr &processor,
+                                          const OCIO::GpuShaderDesc &shaderDesc, std::string &cacheId);
+
+  const unsigned LUT3D_EDGE_SIZE;
+  const std::function<void()> m_OnReady;
+  GLuint lut3dTexID;
+  std::string lut3dcacheid;
+  SharedPipeline m_pNext;  // render thread only
+
+  // worker only
+  std::map<std::string, std::shared_ptr<const Buffer3D> > m_Lut3dCache;
+  std::deque<std::string> m_Lut3dCacheOrder;
+
+  mutable std::mutex m_Mutex;
+  std::condition_variable m_Condition;
+  std::unique_ptr<Request> m_pRequest;
+  SharedPipeline m_pReady;
+  bool m_Building = false;
+  bool m_Stop = false;
+  std::thread m_Worker;
 };
 
-//#endif // OPENCOLORIOMANAGER_H
+} /* namespace duke */
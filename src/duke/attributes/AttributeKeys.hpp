@@ -17,6 +17,17 @@ DECLARE_ATTRIBUTE(DpxImageOrientation, uint8_t, "duke:frame orientation", 1);
 DECLARE_ATTRIBUTE(MediaFrameCount, uint64_t, "duke:frame count", 1);
 DECLARE_ATTRIBUTE(MediaFrame, uint64_t, "duke:frame number", 0);
 
+// Requested decode resolution as a power of two divisor (0 is full resolution).
+// Readers overwrite it with the level they actually produced.
+DECLARE_ATTRIBUTE(ProxyLevel, uint8_t, "duke:proxy level", 0);
+
+// Part of the image to decode as {x0, y0, x1, y1} grid cells, see duke::Region.
+DECLARE_ARRAY_ATTRIBUTE(RegionOfInterest, uint8_t, "duke:region of interest");
+
+// Time spent opening the file and parsing its header, then reading the pixels, in microseconds.
+DECLARE_ATTRIBUTE(IoTime, uint64_t, "duke:io time", 0);
+DECLARE_ATTRIBUTE(DecodeTime, uint64_t, "duke:decode time", 0);
+
 
 
 } /* namespace attribute */
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
+inline bool isBigEndianHost() {
+  const uint16_t one = 1;
+  return *reinterpret_cast<const unsigned char*>(&one) == 0;
+}
+
+// wantBig is a runtime value, the host byte order is tested at runtime too.
 template <typename T>
 inline T swap(const T& arg, bool wantBig) {
-#if (BYTE_ORDER == BIG_ENDIAN) == wantBig
-  return arg;  // no byte-swapping needed
-#else          // swap bytes
+  if (isBigEndianHost() == wantBig) return arg;  // no byte-swapping needed
   T ret;
 
   char* dst = reinterpret_cast<char*>(&ret);
@@ -13,5 +20,4 @@ inline T swap(const T& arg, bool wantBig) {
   for (size_t i = 0; i < sizeof(T); ++i) *dst++ = *--src;
 
   return ret;
-#endif
 }
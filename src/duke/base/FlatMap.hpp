@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/**
+ * An ordered map stored in two sorted arrays, one for the keys and one for
+ * the key/value pairs.
+ *
+ * Lookups are binary searches over the contiguous keys only, iteration walks
+ * contiguous memory. Insertion and removal are linear so this is meant for
+ * containers built once and read many times.
+ *
+ * Keys must not be modified through the iterators.
+ */
+template <typename K, typename V>
+struct FlatMap {
+  typedef K key_type;
+  typedef V mapped_type;
+  typedef std::pair<K, V> value_type;
+  typedef typename std::vector<value_type>::iterator iterator;
+  typedef typename std::vector<value_type>::const_iterator const_iterator;
+  typedef typename std::vector<value_type>::const_reverse_iterator const_reverse_iterator;
+  typedef size_t size_type;
+
+  iterator begin() { return m_Values.begin(); }
+  iterator end() { return m_Values.end(); }
+  const_iterator begin() const { return m_Values.begin(); }
+  const_iterator end() const { return m_Values.end(); }
+  const_iterator cbegin() const { return m_Values.cbegin(); }
+  const_iterator cend() const { return m_Values.cend(); }
+  const_reverse_iterator rbegin() const { return m_Values.rbegin(); }
+  const_reverse_iterator rend() const { return m_Values.rend(); }
+
+  bool empty() const { return m_Keys.empty(); }
+  size_type size() const { return m_Keys.size(); }
+  void clear() {
+    m_Keys.clear();
+    m_Values.clear();
+  }
+  void reserve(size_type count) {
+    m_Keys.reserve(count);
+    m_Values.reserve(count);
+  }
+
+  // The keys in ascending order, contiguous.
+  const std::vector<K>& keys() const { return m_Keys; }
+
+  template <typename P>
+  std::pair<iterator, bool> insert(P&& pair) {
+    value_type value(std::forward<P>(pair));
+    const size_t index = lowerIndex(value.first);
+    if (index < m_Keys.size() && m_Keys[index] == value.first) return std::make_pair(begin() + index, false);
+    m_Keys.insert(m_Keys.begin() + index, value.first);
+    m_Values.insert(m_Values.begin() + index, std::move(value));
+    return std::make_pair(begin() + index, true);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  V& operator[](const K& key) { return insert(value_type(key, V())).first->second; }
+
+  iterator erase(const_iterator itr) {
+    const size_t index = std::distance(cbegin(), itr);
+    m_Keys.erase(m_Keys.begin() + index);
+    return m_Values.erase(m_Values.begin() + index);
+  }
+
+  size_type erase(const K& key) {
+    const auto found = find(key);
+    if (found == end()) return 0;
+    erase(found);
+    return 1;
+  }
+
+  iterator lower_bound(const K& key) { return begin() + lowerIndex(key); }
+  const_iterator lower_bound(const K& key) const { return begin() + lowerIndex(key); }
+  iterator upper_bound(const K& key) { return begin() + upperIndex(key); }
+  const_iterator upper_bound(const K& key) const { return begin() + upperIndex(key); }
+
+  iterator find(const K& key) { return begin() + findIndex(key); }
+  const_iterator find(const K& key) const { return begin() + findIndex(key); }
+  size_type count(const K& key) const { return findIndex(key) == size() ? 0 : 1; }
+
+ private:
+  size_t lowerIndex(const K& key) const {
+    return std::distance(m_Keys.begin(), std::lower_bound(m_Keys.begin(), m_Keys.end(), key));
+  }
+  size_t upperIndex(const K& key) const {
+    return std::distance(m_Keys.begin(), std::upper_bound(m_Keys.begin(), m_Keys.end(), key));
+  }
+  size_t findIndex(const K& key) const {
+    const size_t index = lowerIndex(key);
+    return index < m_Keys.size() && m_Keys[index] == key ? index : m_Keys.size();
+  }
+
+  std::vector<K> m_Keys;
+  std::vector<value_type> m_Values;
+};
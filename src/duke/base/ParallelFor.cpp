@@ -0,0 +1,120 @@
+#include "ParallelFor.hpp"
+
+#include <duke/base/NonCopyable.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct Job {
+  Job(size_t chunks, const std::function<void(size_t)>& task) : task(task), chunks(chunks), next(0), errors(chunks) {}
+
+  // Returns false once all the chunks are claimed.
+  bool runNext() {
+    const size_t chunk = next++;
+    if (chunk >= chunks) return false;
+    try {
+      task(chunk);
+    } catch (...) {
+      errors[chunk] = std::current_exception();
+    }
+    return true;
+  }
+
+  const std::function<void(size_t)>& task;
+  const size_t chunks;
+  std::atomic<size_t> next;
+  size_t done = 0;  // guarded by the pool mutex
+  std::vector<std::exception_ptr> errors;
+};
+
+// Workers live as long as the process, so short calls don't pay for thread
+// creation and per thread state, eg. trace rings, is created once.
+class ThreadPool : public noncopyable {
+ public:
+  ThreadPool() {
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    for (unsigned i = 0; i < threads; ++i) m_Workers.emplace_back(&ThreadPool::workerFunction, this);
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Stop = true;
+    }
+    m_JobAvailable.notify_all();
+    for (auto& worker : m_Workers) worker.join();
+  }
+
+  static ThreadPool& instance() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  unsigned getThreadCount() const { return m_Workers.size(); }
+
+  void run(size_t chunks, const std::function<void(size_t)>& task) {
+    const auto pJob = std::make_shared<Job>(chunks, task);
+    if (!m_Workers.empty()) {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Jobs.push_back(pJob);
+      }
+      m_JobAvailable.notify_all();
+    }
+    // the chunks claimed by the workers are running, waiting for them can't
+    // deadlock even when called from a worker
+    size_t done = 0;
+    while (pJob->runNext()) ++done;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      pJob->done += done;
+      m_JobDone.wait(lock, [&] { return pJob->done == chunks; });
+      const auto pFound = std::find(m_Jobs.begin(), m_Jobs.end(), pJob);
+      if (pFound != m_Jobs.end()) m_Jobs.erase(pFound);
+    }
+    for (const auto& pError : pJob->errors)
+      if (pError) std::rethrow_exception(pError);
+  }
+
+ private:
+  void workerFunction() {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    for (;;) {
+      m_JobAvailable.wait(lock, [this] { return m_Stop || !m_Jobs.empty(); });
+      if (m_Stop) return;
+      const std::shared_ptr<Job> pJob = m_Jobs.front();
+      lock.unlock();
+      const bool ran = pJob->runNext();
+      lock.lock();
+      if (!ran) {
+        // all the chunks are claimed, the job leaves the queue
+        if (!m_Jobs.empty() && m_Jobs.front() == pJob) m_Jobs.pop_front();
+        continue;
+      }
+      if (++pJob->done == pJob->chunks) m_JobDone.notify_all();
+    }
+  }
+
+  std::mutex m_Mutex;
+  std::condition_variable m_JobAvailable;
+  std::condition_variable m_JobDone;
+  std::deque<std::shared_ptr<Job> > m_Jobs;
+  bool m_Stop = false;
+  std::vector<std::thread> m_Workers;
+};
+
+}  // namespace
+
+void runChunks(size_t chunks, const std::function<void(size_t)>& task) {
+  if (chunks == 0) return;
+  ThreadPool::instance().run(chunks, task);
+}
+
+unsigned getPoolThreadCount() { return ThreadPool::instance().getThreadCount(); }
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <thread>
+
+/**
+ * Runs task(chunk) for each chunk in [0, chunks) on a pool of threads created
+ * once for the process, the calling thread taking part.
+ * - Chunks are claimed one at a time, a task may call runChunks again.
+ * - Returns when all the chunks are processed, the first exception thrown by
+ *   a chunk is rethrown.
+ */
+void runChunks(size_t chunks, const std::function<void(size_t chunk)>& task);
+
+// Threads of the pool, not counting the calling thread.
+unsigned getPoolThreadCount();
+
+/**
+ * Calls function(begin, end) over contiguous chunks of [0, count), one chunk
+ * per thread, on the threads of runChunks.
+ * - 0 threads uses the hardware concurrency.
+ * - Returns when all the chunks are processed, the first exception thrown by
+ *   a chunk is rethrown.
+ */
+template <typename F>
+void parallelFor(size_t count, unsigned threads, F&& function) {
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  const size_t chunks = std::min<size_t>(threads, count);
+  if (chunks <= 1) {
+    if (count > 0) function(size_t(0), count);
+    return;
+  }
+  runChunks(chunks, [&](size_t chunk) { function(count * chunk / chunks, count * (chunk + 1) / chunks); });
+}
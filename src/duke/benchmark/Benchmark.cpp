@@ -1,22 +1,38 @@
 #include "Benchmark.hpp"
 
+#include <duke/benchmark/BenchmarkReport.hpp>
+#include <duke/cmdline/CmdLineParameters.hpp>
 #include <duke/gl/GlFwApp.hpp>
 #include <duke/gl/GL.hpp>
 #include <duke/gl/GLUtils.hpp>
 #include <duke/gl/Mesh.hpp>
 #include <duke/gl/GlObjects.hpp>
+#include <duke/gl/RenderState.hpp>
 #include <duke/gl/Textures.hpp>
+#include <duke/engine/ColorTransforms.hpp>
+#include <duke/engine/rendering/ImageUniforms.hpp>
+#include <duke/engine/rendering/ShaderConstants.hpp>
 #include <duke/engine/rendering/ShaderFactory.hpp>
 #include <duke/memory/Allocator.hpp>
+#include <duke/time/Clock.hpp>
 
 
 #include <glm/glm.hpp>
 
+#include <array>
 #include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <map>
 #include <memory>
 #include <algorithm>
+#include <stdexcept>
 
 using namespace std;
 
@@ -33,6 +49,7 @@ struct TextureConfiguration {
 class IUploadTest {
  public:
   virtual ~IUploadTest() {}
+  virtual bool isSupported() const { return true; }
   virtual Binder<GlTextureObject> initializeAndBind(const TextureConfiguration configuration,
                                                     const glm::uvec2 textureSize) = 0;
   virtual void updateTexture(const TextureConfiguration configuration, const glm::uvec2 textureSize, const void* pData,
@@ -54,7 +71,7 @@ class SynchronousUnpack : public IUploadTest {
     glTexSubImage2D(texture.target, 0, 0, 0, textureSize.x, textureSize.y, conf.pixel_format, conf.pixel_type, pData);
   }
   virtual void destroy() {}
-  virtual const char* name() const { return "Synchronous"; }
+  virtual const char* name() const { return "sync"; }
 
  protected:
   GlTextureRectangle texture;
@@ -73,15 +90,154 @@ class PBOUnpack : public SynchronousUnpack {
     firstUpdate = false;
   }
   virtual void destroy() { firstUpdate = true; }
-  virtual const char* name() const { return "Asynchronous"; }
+  virtual const char* name() const { return "pbo"; }
 
  private:
   GlStreamUploadPbo pbo;
   bool firstUpdate = true;
 };
 
-void benchmark() {
-  const size_t seconds = 2;
+// Cycles through several PBOs so the copy never waits for the previous upload.
+class MultiPBOUnpack : public SynchronousUnpack {
+ public:
+  virtual void updateTexture(const TextureConfiguration conf, const glm::uvec2 textureSize, const void* pData,
+                             const GLsizeiptr dataSize) {
+    const auto& pbo = pbos[current];
+    auto pboBound = pbo.scope_bind_buffer();
+    if (sizes[current] != dataSize) {
+      glBufferData(pbo.target, dataSize, 0, pbo.usage);
+      sizes[current] = dataSize;
+    }
+    GLubyte* ptr = (GLubyte*)glMapBufferRange(pbo.target, 0, dataSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    memcpy(ptr, pData, dataSize);
+    glUnmapBuffer(pbo.target);
+    glTexSubImage2D(texture.target, 0, 0, 0, textureSize.x, textureSize.y, conf.pixel_format, conf.pixel_type, nullptr);
+    current = (current + 1) % pbos.size();
+  }
+  virtual void destroy() {
+    sizes.fill(0);
+    current = 0;
+  }
+  virtual const char* name() const { return "multi-pbo"; }
+
+ private:
+  array<GlStreamUploadPbo, 3> pbos;
+  array<GLsizeiptr, 3> sizes{{0, 0, 0}};
+  size_t current = 0;
+};
+
+// A buffer mapped once for the whole test, split in segments guarded by fences.
+class PersistentMappedUnpack : public SynchronousUnpack {
+ public:
+  virtual ~PersistentMappedUnpack() { destroy(); }
+  virtual bool isSupported() const { return glfwExtensionSupported("GL_ARB_buffer_storage"); }
+  virtual void updateTexture(const TextureConfiguration conf, const glm::uvec2 textureSize, const void* pData,
+                             const GLsizeiptr dataSize) {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    if (!pBuffer) {
+      // storage is immutable, a new buffer is needed for each configuration
+      pBuffer.reset(new GlStreamUploadPbo());
+      auto pboBound = pBuffer->scope_bind_buffer();
+      glBufferStorage(pBuffer->target, dataSize * fences.size(), nullptr, flags);
+      pMapped = (GLubyte*)glMapBufferRange(pBuffer->target, 0, dataSize * fences.size(), flags);
+    }
+    auto& fence = fences[current];
+    if (fence) {
+      glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+      glDeleteSync(fence);
+    }
+    const size_t offset = current * dataSize;
+    memcpy(pMapped + offset, pData, dataSize);
+    auto pboBound = pBuffer->scope_bind_buffer();
+    glTexSubImage2D(texture.target, 0, 0, 0, textureSize.x, textureSize.y, conf.pixel_format, conf.pixel_type,
+                    reinterpret_cast<const GLvoid*>(offset));
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    current = (current + 1) % fences.size();
+  }
+  virtual void destroy() {
+    for (auto& fence : fences) {
+      if (fence) glDeleteSync(fence);
+      fence = nullptr;
+    }
+    if (pBuffer) {
+      auto pboBound = pBuffer->scope_bind_buffer();
+      glUnmapBuffer(pBuffer->target);
+    }
+    pBuffer.reset();
+    pMapped = nullptr;
+    current = 0;
+  }
+  virtual const char* name() const { return "persistent"; }
+
+ private:
+  unique_ptr<GlStreamUploadPbo> pBuffer;
+  GLubyte* pMapped = nullptr;
+  array<GLsync, 3> fences{{nullptr, nullptr, nullptr}};
+  size_t current = 0;
+};
+
+// Uploads from a dedicated thread owning a context shared with the display one.
+class UploadThreadUnpack : public SynchronousUnpack {
+ public:
+  UploadThreadUnpack(GLFWwindow* pUploadContext) : pContext(pUploadContext), worker(&UploadThreadUnpack::run, this) {}
+  virtual ~UploadThreadUnpack() {
+    {
+      lock_guard<mutex> lock(m);
+      stop = true;
+    }
+    condition.notify_all();
+    worker.join();
+    glfwDestroyWindow(pContext);
+  }
+  virtual void updateTexture(const TextureConfiguration conf, const glm::uvec2 textureSize, const void* pData,
+                             const GLsizeiptr dataSize) {
+    unique_lock<mutex> lock(m);
+    job = {conf, textureSize, pData};
+    pending = true;
+    condition.notify_all();
+    condition.wait(lock, [&] { return !pending; });
+    // the display context must not sample the texture before the upload completes
+    glWaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+    glDeleteSync(fence);
+  }
+  virtual const char* name() const { return "thread"; }
+
+ private:
+  struct Job {
+    TextureConfiguration conf;
+    glm::uvec2 size;
+    const void* pData;
+  };
+
+  void run() {
+    glfwMakeContextCurrent(pContext);
+    for (;;) {
+      unique_lock<mutex> lock(m);
+      condition.wait(lock, [&] { return pending || stop; });
+      if (stop) break;
+      // binding without the Binder, its count is shared with the display thread
+      gl::RenderState::current().bindTexture(texture.target, texture.id);
+      glTexSubImage2D(texture.target, 0, 0, 0, job.size.x, job.size.y, job.conf.pixel_format, job.conf.pixel_type,
+                      job.pData);
+      fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      glFlush();
+      pending = false;
+      condition.notify_all();
+    }
+    glfwMakeContextCurrent(nullptr);
+  }
+
+  GLFWwindow* const pContext;
+  mutex m;
+  condition_variable condition;
+  Job job;
+  GLsync fence = nullptr;
+  bool pending = false;
+  bool stop = false;
+  thread worker;
+};
+
+void benchmark(const CmdLineParameters& parameters) {
   const size_t viewportWidth = 512;
   const size_t viewportHeight = 128;
   const size_t allocatedDataSize = 120 * 1024 * 1024;  // allocating 120 MB
@@ -92,14 +248,38 @@ void benchmark() {
   generate(pData, pData + allocatedDataSize, rand);
 
   DukeGLFWApplication application;
-  //	glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
-  //	unique_ptr<DukeGLFWWindow> pUpload(application.createWindow<DukeGLFWWindow>(viewportWidth, viewportHeight,
-  //"Upload context...", nullptr, nullptr));
-  //	glfwWindowHint(GLFW_VISIBLE, GL_TRUE);
-  //	unique_ptr<DukeGLFWWindow> pWindow(application.createWindow<DukeGLFWWindow>(viewportWidth, viewportHeight,
-  //"please wait while benchmarking...", nullptr, pUpload->getHandle()));
+  if (parameters.headless) application.setHeadless();
   unique_ptr<DukeGLFWWindow> pWindow(application.createWindow<DukeGLFWWindow>(
       viewportWidth, viewportHeight, "please wait while benchmarking...", nullptr, nullptr));
+  const auto isSelected = [&](const string& name) {
+    const auto& selected = parameters.benchmarkScenarios;
+    return selected.empty() || find(selected.begin(), selected.end(), name) != selected.end();
+  };
+
+  vector<shared_ptr<IUploadTest> > vpTesters = {make_shared<SynchronousUnpack>(), make_shared<PBOUnpack>(),
+                                                make_shared<MultiPBOUnpack>(), make_shared<PersistentMappedUnpack>()};
+  if (isSelected("thread")) {
+    glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+    GLFWwindow* pUploadContext = application.createRawWindow(1, 1, "upload", nullptr, pWindow->getHandle());
+    glfwMakeContextCurrent(pWindow->getHandle());
+    vpTesters.push_back(make_shared<UploadThreadUnpack>(pUploadContext));
+  }
+  // decoding and linearizing a whole frame on the CPU or with the display
+  // shader, from the same data
+  const char* const cpuScenario = "cpu-color";
+  const char* const glScenario = "gl-color";
+  for (const auto& name : parameters.benchmarkScenarios)
+    if (name != cpuScenario && name != glScenario && none_of(vpTesters.begin(), vpTesters.end(), [&](const shared_ptr<IUploadTest>& pTester) {
+          return name == pTester->name();
+        }))
+      throw commandline_error("unknown benchmark scenario '" + name + "'");
+  vpTesters.erase(remove_if(vpTesters.begin(), vpTesters.end(), [&](const shared_ptr<IUploadTest>& pTester) {
+                    if (!isSelected(pTester->name())) return true;
+                    if (pTester->isSupported()) return false;
+                    fprintf(stderr, "skipping unsupported scenario %s\n", pTester->name());
+                    return true;
+                  }),
+                  vpTesters.end());
 
   const vector<glm::uvec2> textureSizes = {glm::uvec2(1920, 1080), glm::uvec2(2048, 1536), glm::uvec2(4096, 3072)};
   const vector<TextureConfiguration> configurations = {  //
@@ -125,8 +305,6 @@ void benchmark() {
       {GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT},              //
   };
 
-  const vector<shared_ptr<IUploadTest> > vpTesters = {make_shared<SynchronousUnpack>(), make_shared<PBOUnpack>()};
-
   glfwSwapInterval(0);  // ensuring no vsync
 
 
@@ -143,45 +321,164 @@ void main() {
 	vFragColor = texture(gTextureSampler, vVaryingTexCoord);
 }
 )"));
+  bindUniformBlocks(description, program);
+  ImageUniformBuffer uniformBuffer;
+  vector<BenchmarkRecord> records;
   for (glm::uvec2 textureSize : textureSizes) {
     for (TextureConfiguration conf : configurations) {
       for (const shared_ptr<IUploadTest>& pTester : vpTesters) {
         const GLsizeiptr dataSize =
             textureSize.x * textureSize.y * getBytePerPixels(conf.pixel_format, conf.pixel_type);
-        printf("%15s %ux%u %15s %10s %30s %10ld ",            //
-               pTester->name(),                               //
-               textureSize.x, textureSize.y,                  //
-               getInternalFormatString(conf.internalFormat),  //
-               getPixelFormatString(conf.pixel_format),       //
-               getPixelTypeString(conf.pixel_type),           //
-               dataSize);
-        fflush(stdout);
+        // progress goes to stderr, stdout may hold the report
+        fprintf(stderr, "%15s %ux%u %15s %10s %30s\n",            //
+                pTester->name(),                               //
+                textureSize.x, textureSize.y,                  //
+                getInternalFormatString(conf.internalFormat),  //
+                getPixelFormatString(conf.pixel_format),       //
+                getPixelTypeString(conf.pixel_type));
+        vector<double> samples;
         {
           auto textureBound = pTester->initializeAndBind(conf, textureSize);
           program.use();
           auto pair = getTextureDimensions(textureSize.x, textureSize.y, 0);
-          glUniform2i(program.getUniformLocation("gImage"), pair.first, pair.second);
-          glUniform2i(program.getUniformLocation("gViewport"), viewportWidth, viewportHeight);
+          ImageUniforms uniforms = ImageUniforms();
+          setSwizzle(uniforms, false, false, false);
+          uniforms.image[0] = pair.first;
+          uniforms.image[1] = pair.second;
+          uniforms.viewport[0] = viewportWidth;
+          uniforms.viewport[1] = viewportHeight;
+          uniforms.zoom = 1;
+          uniforms.pixelRatio = 1;
+          uniforms.dataWindow[2] = textureSize.x;
+          uniforms.dataWindow[3] = textureSize.y;
+          uniformBuffer.update(uniforms);
           glUniform1i(program.getUniformLocation("gTextureSampler"), 0);
-          glUniform2i(program.getUniformLocation("gPan"), 0, 0);
-          glUniform1i(program.getUniformLocation("gZoom"), 0);
-          size_t count = 0;
-          for (const auto start = chrono::steady_clock::now();
-               chrono::steady_clock::now() - start < chrono::seconds(seconds); ++count) {
+          const size_t iterations = parameters.benchmarkWarmup + parameters.benchmarkRepetitions;
+          for (size_t count = 0; count < iterations; ++count) {
+            const auto start = duke_clock::now();
             pTester->updateTexture(conf, textureSize, pData + (count % 2), dataSize);
             pMesh->draw();
+            glFinish();  // timing the whole upload and draw
+            const chrono::duration<double, milli> elapsed = duke_clock::now() - start;
+            if (count >= parameters.benchmarkWarmup) samples.push_back(elapsed.count());
             glfwSwapBuffers(pWindow->getHandle());
           }
           pTester->destroy();
-          const double gbPerSeconds = count * dataSize / 1000. / 1000 / 1000 / seconds;
-          printf("%4.1f %4.2f %4.2f\n",    //
-                 count / double(seconds),  //
-                 gbPerSeconds,             //
-                 1000 * seconds / double(count));
         }
+        const auto statistics = computeStatistics(samples);
+        BenchmarkRecord record;
+        record.add("scenario", pTester->name());
+        record.add("width", textureSize.x);
+        record.add("height", textureSize.y);
+        record.add("internal_format", getInternalFormatString(conf.internalFormat));
+        record.add("pixel_format", getPixelFormatString(conf.pixel_format));
+        record.add("pixel_type", getPixelTypeString(conf.pixel_type));
+        record.add("bytes", dataSize);
+        record.add("ms", statistics);
+        record.add("gb_per_s", statistics.mean > 0 ? dataSize / statistics.mean / 1000. / 1000. : 0);
+        records.push_back(record);
+      }
+    }
+  }
+  const vector<pair<GLuint, size_t> > colorFormats = {{GL_RGB8, 3}, {GL_RGB10_A2UI, 4}, {GL_RGB16, 6}, {GL_RGB16F, 6}};
+  const auto getColorFrame = [&](glm::uvec2 textureSize, const pair<GLuint, size_t>& format) {
+    FrameData frame;
+    frame.description.width = textureSize.x;
+    frame.description.height = textureSize.y;
+    frame.description.glFormat = format.first;
+    frame.description.dataSize = textureSize.x * textureSize.y * format.second;
+    frame.pData = pSharedData;
+    return frame;
+  };
+  const auto timeColor = [&](const char* scenario, const FrameData& frame, const function<void()>& convert) {
+    const auto& description = frame.description;
+    fprintf(stderr, "%15s %zux%zu %15s\n", scenario, description.width, description.height,
+            getInternalFormatString(description.glFormat));
+    vector<double> samples;
+    const size_t iterations = parameters.benchmarkWarmup + parameters.benchmarkRepetitions;
+    for (size_t count = 0; count < iterations; ++count) {
+      const auto start = duke_clock::now();
+      convert();
+      const chrono::duration<double, milli> elapsed = duke_clock::now() - start;
+      if (count >= parameters.benchmarkWarmup) samples.push_back(elapsed.count());
+    }
+    const auto statistics = computeStatistics(samples);
+    BenchmarkRecord record;
+    record.add("scenario", scenario);
+    record.add("width", description.width);
+    record.add("height", description.height);
+    record.add("internal_format", getInternalFormatString(description.glFormat));
+    record.add("pixel_format", getPixelFormatString(getPixelFormat(description.glFormat)));
+    record.add("pixel_type", getPixelTypeString(getPixelType(description.glFormat)));
+    record.add("bytes", description.dataSize);
+    record.add("ms", statistics);
+    record.add("gb_per_s", statistics.mean > 0 ? description.dataSize / statistics.mean / 1000. / 1000. : 0);
+    records.push_back(record);
+  };
+  if (isSelected(cpuScenario)) {
+    RgbaImage image;
+    for (glm::uvec2 textureSize : textureSizes) {
+      for (const auto& format : colorFormats) {
+        const FrameData frame = getColorFrame(textureSize, format);
+        timeColor(cpuScenario, frame, [&]() { decodeToLinear(frame, ColorSpace::Cineon, image); });
       }
     }
   }
+  if (isSelected(glScenario)) {
+    // uploading then drawing every pixel to a float framebuffer, as the
+    // display does before the viewport crops the image
+    for (glm::uvec2 textureSize : textureSizes) {
+      GlRenderbufferObject colorBuffer;
+      {
+        auto boundColorBuffer = colorBuffer.scope_bind();
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA32F, textureSize.x, textureSize.y);
+      }
+      GlFramebufferObject framebuffer;
+      auto boundFramebuffer = framebuffer.scope_bind_framebuffer();
+      glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer.id);
+      if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        throw runtime_error("unable to create the color framebuffer");
+      glViewport(0, 0, textureSize.x, textureSize.y);
+      for (const auto& format : colorFormats) {
+        const FrameData frame = getColorFrame(textureSize, format);
+        const auto colorDescription = ShaderDescription::createTextureDesc(
+            false, false, false, format.first == GL_RGB10_A2UI, ColorSpace::Cineon, ColorSpace::linear, "");
+        const SharedProgram pColorProgram = buildProgram(colorDescription);
+        ImageUniforms uniforms = ImageUniforms();
+        setSwizzle(uniforms, false, false, false);
+        const auto dimensions = getTextureDimensions(textureSize.x, textureSize.y, 0);
+        uniforms.image[0] = dimensions.first;
+        uniforms.image[1] = dimensions.second;
+        uniforms.viewport[0] = textureSize.x;
+        uniforms.viewport[1] = textureSize.y;
+        uniforms.zoom = 1;
+        uniforms.pixelRatio = 1;
+        uniforms.exposure = 1;
+        uniforms.gamma = 1;
+        uniforms.dataWindow[2] = textureSize.x;
+        uniforms.dataWindow[3] = textureSize.y;
+        uniformBuffer.update(uniforms);
+        Texture texture;
+        timeColor(glScenario, frame, [&]() {
+          RenderState::current().activeTexture(shader::IMAGE_TEXTURE_UNIT);
+          const auto boundTexture = texture.scope_bind_texture();
+          texture.initialize(frame.description, pData);
+          pColorProgram->use();
+          pColorProgram->glUniform1i(shader::gTextureSampler, shader::IMAGE_TEXTURE_UNIT);
+          pMesh->draw();
+          glFinish();  // timing the whole upload and conversion
+        });
+      }
+    }
+    glViewport(0, 0, viewportWidth, viewportHeight);
+  }
+  if (parameters.benchmarkOutput.empty()) {
+    writeReport(cout, parameters.benchmarkFormat, records);
+  } else {
+    ofstream output(parameters.benchmarkOutput);
+    if (!output) throw runtime_error("unable to write benchmark report to " + parameters.benchmarkOutput);
+    writeReport(output, parameters.benchmarkFormat, records);
+  }
 }
 
 } /* namespace duke */
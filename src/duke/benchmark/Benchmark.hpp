@@ -3,6 +3,9 @@
 
 namespace duke {
 
-void benchmark();
+struct CmdLineParameters;
+
+// Measures texture upload for each selected scenario, format and size.
+void benchmark(const CmdLineParameters& parameters);
 
 } /* namespace duke */
@@ -0,0 +1,145 @@
+#include "BenchmarkReport.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace duke {
+
+double percentile(const std::vector<double>& sortedSamples, double p) {
+  if (sortedSamples.empty()) return 0;
+  const double rank = std::min(std::max(p, 0.), 100.) / 100. * (sortedSamples.size() - 1);
+  const size_t lower = rank;
+  const size_t upper = std::min(lower + 1, sortedSamples.size() - 1);
+  const double fraction = rank - lower;
+  return sortedSamples[lower] + (sortedSamples[upper] - sortedSamples[lower]) * fraction;
+}
+
+SampleStatistics computeStatistics(std::vector<double> samples) {
+  SampleStatistics statistics;
+  if (samples.empty()) return statistics;
+  std::sort(samples.begin(), samples.end());
+  statistics.count = samples.size();
+  statistics.min = samples.front();
+  statistics.max = samples.back();
+  statistics.mean = std::accumulate(samples.begin(), samples.end(), 0.) / samples.size();
+  statistics.p50 = percentile(samples, 50);
+  statistics.p90 = percentile(samples, 90);
+  statistics.p99 = percentile(samples, 99);
+  return statistics;
+}
+
+void BenchmarkRecord::add(const std::string& key, const std::string& value) { fields.push_back({key, value, false}); }
+
+void BenchmarkRecord::add(const std::string& key, double value) {
+  std::ostringstream oss;
+  oss << value;
+  fields.push_back({key, oss.str(), true});
+}
+
+void BenchmarkRecord::add(const std::string& prefix, const SampleStatistics& statistics) {
+  add(prefix + "_min", statistics.min);
+  add(prefix + "_mean", statistics.mean);
+  add(prefix + "_p50", statistics.p50);
+  add(prefix + "_p90", statistics.p90);
+  add(prefix + "_p99", statistics.p99);
+  add(prefix + "_max", statistics.max);
+}
+
+namespace {
+
+std::string jsonEscape(const std::string& value) {
+  std::string escaped;
+  for (const char c : value) {
+    switch (c) {
+      case '"':
+      case '\\':
+        escaped += '\\';
+        escaped += c;
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      default:
+        escaped += c;
+    }
+  }
+  return escaped;
+}
+
+std::string csvEscape(const std::string& value) {
+  if (value.find_first_of(",\"\n") == std::string::npos) return value;
+  std::string escaped = "\"";
+  for (const char c : value) {
+    if (c == '"') escaped += '"';
+    escaped += c;
+  }
+  return escaped + '"';
+}
+
+void writeJson(std::ostream& stream, const std::vector<BenchmarkRecord>& records) {
+  stream << "[\n";
+  for (size_t i = 0; i < records.size(); ++i) {
+    stream << "  {";
+    const auto& fields = records[i].fields;
+    for (size_t j = 0; j < fields.size(); ++j) {
+      const auto& field = fields[j];
+      if (j) stream << ", ";
+      stream << '"' << jsonEscape(field.key) << "\": ";
+      if (field.numeric)
+        stream << field.value;
+      else
+        stream << '"' << jsonEscape(field.value) << '"';
+    }
+    stream << (i + 1 < records.size() ? "},\n" : "}\n");
+  }
+  stream << "]\n";
+}
+
+void writeCsv(std::ostream& stream, const std::vector<BenchmarkRecord>& records) {
+  if (records.empty()) return;
+  const auto writeLine = [&](const BenchmarkRecord& record, bool header) {
+    for (size_t i = 0; i < record.fields.size(); ++i) {
+      if (i) stream << ',';
+      stream << csvEscape(header ? record.fields[i].key : record.fields[i].value);
+    }
+    stream << '\n';
+  };
+  writeLine(records.front(), true);
+  for (const auto& record : records) writeLine(record, false);
+}
+
+void writeText(std::ostream& stream, const std::vector<BenchmarkRecord>& records) {
+  if (records.empty()) return;
+  // columns are as wide as their widest value
+  std::vector<size_t> widths;
+  for (const auto& field : records.front().fields) widths.push_back(field.key.size());
+  for (const auto& record : records)
+    for (size_t i = 0; i < record.fields.size() && i < widths.size(); ++i)
+      widths[i] = std::max(widths[i], record.fields[i].value.size());
+  const auto writeLine = [&](const BenchmarkRecord& record, bool header) {
+    for (size_t i = 0; i < record.fields.size() && i < widths.size(); ++i)
+      stream << std::setw(widths[i] + 1) << (header ? record.fields[i].key : record.fields[i].value);
+    stream << '\n';
+  };
+  writeLine(records.front(), true);
+  for (const auto& record : records) writeLine(record, false);
+}
+
+}  // namespace
+
+void writeReport(std::ostream& stream, ReportFormat format, const std::vector<BenchmarkRecord>& records) {
+  switch (format) {
+    case ReportFormat::TEXT:
+      return writeText(stream, records);
+    case ReportFormat::JSON:
+      return writeJson(stream, records);
+    case ReportFormat::CSV:
+      return writeCsv(stream, records);
+  }
+}
+
+} /* namespace duke */
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <duke/cmdline/ReportFormat.hpp>
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace duke {
+
+/**
+ * Summary of a set of timing samples.
+ * Percentiles are linearly interpolated between the closest ranks.
+ */
+struct SampleStatistics {
+  size_t count = 0;
+  double min = 0, mean = 0, p50 = 0, p90 = 0, p99 = 0, max = 0;
+};
+
+SampleStatistics computeStatistics(std::vector<double> samples);
+
+// Value at percentile p in [0,100] of sorted samples.
+double percentile(const std::vector<double>& sortedSamples, double p);
+
+/**
+ * One line of a benchmark report, fields keep their insertion order so all
+ * the records of a report are expected to have the same fields.
+ */
+struct BenchmarkRecord {
+  struct Field {
+    std::string key;
+    std::string value;
+    bool numeric;
+  };
+
+  void add(const std::string& key, const std::string& value);
+  void add(const std::string& key, double value);
+  // Adds min, mean, p50, p90, p99 and max, keys are prefixed.
+  void add(const std::string& prefix, const SampleStatistics& statistics);
+
+  std::vector<Field> fields;
+};
+
+void writeReport(std::ostream& stream, ReportFormat format, const std::vector<BenchmarkRecord>& records);
+
+} /* namespace duke */
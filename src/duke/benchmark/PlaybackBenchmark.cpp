@@ -0,0 +1,95 @@
+#include "PlaybackBenchmark.hpp"
+
+#include <duke/benchmark/BenchmarkReport.hpp>
+#include <duke/benchmark/SyntheticSequence.hpp>
+#include <duke/cmdline/CmdLineParameters.hpp>
+#include <duke/engine/DukeApplication.hpp>
+#include <duke/engine/DukeMainWindow.hpp>
+#include <duke/filesystem/FsUtils.hpp>
+#include <duke/gl/GlFwApp.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace duke {
+
+namespace {
+
+vector<string> getFormats(const CmdLineParameters& parameters) {
+  if (!parameters.benchmarkScenarios.empty()) return parameters.benchmarkScenarios;
+  vector<string> formats;
+  for (const char* pExtension : {"dpx", "tga", "exr"})
+    if (isSyntheticFormatSupported(pExtension)) formats.push_back(pExtension);
+  return formats;
+}
+
+// Removes the generated sequence whatever happens during playback.
+struct ScopedDirectory {
+  ScopedDirectory() : path(createTemporaryDirectory("duke-benchmark")) {}
+  ~ScopedDirectory() { removeDirectory(path); }
+  const string path;
+};
+
+double toMilliseconds(uint64_t microseconds, size_t count) { return count ? microseconds / 1000. / count : 0; }
+
+}  // namespace
+
+void playbackBenchmark(const CmdLineParameters& parameters) {
+  const size_t width = parameters.benchmarkWidth;
+  const size_t height = parameters.benchmarkHeight;
+  const size_t frames = parameters.benchmarkFrames;
+  const double targetFps = double(parameters.defaultFrameRate.denominator()) / parameters.defaultFrameRate.numerator();
+
+  DukeGLFWApplication application;
+  if (parameters.headless) application.setHeadless();
+
+  vector<BenchmarkRecord> records;
+  for (const string& format : getFormats(parameters)) {
+    if (!isSyntheticFormatSupported(format)) throw commandline_error("can't generate a '" + format + "' sequence");
+    ScopedDirectory directory;
+    cerr << "writing " << frames << " " << format << " frames in " << directory.path << endl;
+    writeSyntheticSequence(directory.path, format, width, height, frames);
+
+    cerr << "playing " << format << " sequence" << endl;
+    GLFWwindow* pWindow = application.createRawWindow(width / 2, height / 2, "please wait while benchmarking...",
+                                                      nullptr, nullptr);
+    DukeMainWindow window(pWindow, parameters);
+    window.load(buildTimeline({directory.path}), parameters.defaultFrameRate, FitMode::INNER, 0);
+    const auto statistics = window.benchmarkPlayback();
+
+    const double seconds = statistics.elapsed.count() / 1000. / 1000.;
+    const size_t requested = statistics.displayed + statistics.notReady;
+    BenchmarkRecord record;
+    record.add("format", format);
+    record.add("width", width);
+    record.add("height", height);
+    record.add("frames", frames);
+    record.add("target_fps", targetFps);
+    record.add("fps", seconds > 0 ? statistics.displayed / seconds : 0);
+    record.add("displayed", statistics.displayed);
+    record.add("dropped", statistics.dropped);
+    record.add("repeated", statistics.repeated);
+    record.add("not_ready", statistics.notReady);
+    record.add("ready_rate", requested ? double(statistics.displayed) / requested : 0);
+    record.add("ms_io", toMilliseconds(statistics.ioMicroseconds, statistics.displayed));
+    record.add("ms_decode", toMilliseconds(statistics.decodeMicroseconds, statistics.displayed));
+    record.add("ms_upload", toMilliseconds(statistics.uploadMicroseconds, statistics.uploads));
+    records.push_back(record);
+  }
+
+  if (parameters.benchmarkOutput.empty()) {
+    writeReport(cout, parameters.benchmarkFormat, records);
+  } else {
+    ofstream output(parameters.benchmarkOutput);
+    if (!output) throw runtime_error("unable to write benchmark report to " + parameters.benchmarkOutput);
+    writeReport(output, parameters.benchmarkFormat, records);
+  }
+}
+
+} /* namespace duke */
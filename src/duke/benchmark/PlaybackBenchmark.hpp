@@ -0,0 +1,13 @@
+#pragma once
+
+namespace duke {
+
+struct CmdLineParameters;
+
+// Plays synthetic on disk sequences through the whole pipeline, from file
+// reading to display, and reports sustained frame rate and time breakdowns.
+// ready_rate is the share of refreshes where the frame to show was already
+// decoded and uploaded, it says nothing of the image cache hits.
+void playbackBenchmark(const CmdLineParameters& parameters);
+
+} /* namespace duke */
@@ -0,0 +1,89 @@
+#include "SyntheticSequence.hpp"
+
+#include <duke/engine/SequenceWriter.hpp>
+#include <duke/gl/GL.hpp>
+#include <duke/imageio/DukeIO.hpp>
+#include <duke/math/HalfFloat.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+
+namespace duke {
+
+namespace {
+
+// Channel value in [0,1] for a gradient scrolling horizontally.
+inline float getValue(size_t x, size_t y, size_t width, size_t height, size_t frame, size_t channel) {
+  switch (channel) {
+    case 0:
+      return float((x + frame * 8) % width) / width;
+    case 1:
+      return float(y) / height;
+    default:
+      return float(frame % 64) / 64;
+  }
+}
+
+template <typename T, typename ENCODE>
+void fill(FrameData& frame, size_t index, ENCODE encode) {
+  const size_t width = frame.description.width;
+  const size_t height = frame.description.height;
+  T* pValue = reinterpret_cast<T*>(frame.pData.get());
+  for (size_t y = 0; y < height; ++y)
+    for (size_t x = 0; x < width; ++x)
+      for (size_t c = 0; c < 3; ++c) *pValue++ = encode(getValue(x, y, width, height, index, c));
+}
+
+size_t getSyntheticFormat(const std::string& extension) {
+  if (extension == "dpx") return GL_RGB16;
+  if (extension == "tga") return GL_RGB8;
+  return GL_RGB16F;
+}
+
+}  // namespace
+
+FrameData makeSyntheticFrame(size_t width, size_t height, size_t frame, size_t glFormat) {
+  const size_t channelSize = glFormat == GL_RGB8 ? 1 : 2;
+  FrameData data;
+  auto& description = data.description;
+  description.width = width;
+  description.height = height;
+  description.glFormat = glFormat;
+  description.dataSize = width * height * 3 * channelSize;
+  data.pData.reset(new char[description.dataSize], [](char* pData) { delete[] pData; });
+  switch (glFormat) {
+    case GL_RGB8:
+      fill<uint8_t>(data, frame, [](float value) { return uint8_t(value * 255); });
+      break;
+    case GL_RGB16:
+      fill<uint16_t>(data, frame, [](float value) { return uint16_t(value * 65535); });
+      break;
+    case GL_RGB16F:
+      fill<uint16_t>(data, frame, [](float value) { return toHalf(value); });
+      break;
+    default:
+      throw std::invalid_argument("unsupported synthetic frame format");
+  }
+  return data;
+}
+
+bool isSyntheticFormatSupported(const std::string& extension) {
+  return IODescriptors::instance().findWriterDescriptor(extension.c_str()) != nullptr;
+}
+
+void writeSyntheticSequence(const std::string& directory, const std::string& extension, size_t width, size_t height,
+                            size_t frameCount) {
+  if (!isSyntheticFormatSupported(extension))
+    throw std::runtime_error("can't generate synthetic '" + extension + "' files");
+  const size_t glFormat = getSyntheticFormat(extension);
+  SequenceWriter writer;
+  for (size_t frame = 0; frame < frameCount; ++frame) {
+    char name[32];
+    snprintf(name, sizeof(name), "/synthetic.%04zu.", frame);
+    writer.push(directory + name + extension, makeSyntheticFrame(width, height, frame, glFormat));
+  }
+  writer.finish();
+}
+
+} /* namespace duke */
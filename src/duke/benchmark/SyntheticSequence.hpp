@@ -0,0 +1,22 @@
+#pragma once
+
+#include <duke/image/FrameData.hpp>
+
+#include <string>
+
+namespace duke {
+
+// A gradient scrolling with the frame number, RGB in GL_RGB8, GL_RGB16 or
+// GL_RGB16F, rows top to bottom.
+FrameData makeSyntheticFrame(size_t width, size_t height, size_t frame, size_t glFormat);
+
+// True if a registered plugin can write this extension.
+bool isSyntheticFormatSupported(const std::string& extension);
+
+// Writes frames 'synthetic.0000.ext' to 'synthetic.<frameCount-1>.ext' in the
+// directory with the image writers. dpx are 10 bits, tga 8 bits and other
+// formats get half float frames.
+void writeSyntheticSequence(const std::string& directory, const std::string& extension, size_t width, size_t height,
+                            size_t frameCount);
+
+} /* namespace duke */
@@ -54,6 +54,19 @@ CmdLineParameters::CmdLineParameters(int argc, const char* const* argv) {
       fullscreen = true;
     else if (matches(pOption, "--unlimited"))
       unlimitedFPS = true;
+    else if (matches(pOption, "--proxy"))
+      proxyDecode = true;
+    else if (matches(pOption, "--roi"))
+      regionDecode = true;
+    else if (matches(pOption, "--mipmap"))
+      mipmapDisplay = true;
+    else if (matches(pOption, "--probe-formats"))
+      probeTextureFormats = true;
+    else if (matches(pOption, "--metrics-port")) {
+      getArgs(argc, argv, ++i, metricsPort);
+      if (metricsPort > 65535) throw logic_error("invalid metrics port");
+    } else if (matches(pOption, "--tile-size"))
+      getArgs(argc, argv, ++i, textureTileSize);
     else if (matches(pOption, "--threads", "-t"))
       getArgs(argc, argv, ++i, workerThreadDefault);
     else if (matches(pOption, "--max-cache-size")) {
@@ -74,6 +87,49 @@ CmdLineParameters::CmdLineParameters(int argc, const char* const* argv) {
       }
     } else if (matches(pOption, "--benchmark"))
       mode = ApplicationMode::BENCHMARK;
+    else if (matches(pOption, "--playback-benchmark"))
+      mode = ApplicationMode::PLAYBACK_BENCHMARK;
+    else if (matches(pOption, "--benchmark-frames"))
+      getArgs(argc, argv, ++i, benchmarkFrames);
+    else if (matches(pOption, "--benchmark-resolution")) {
+      string arg;
+      getArgs(argc, argv, ++i, arg);
+      istringstream stream(arg);
+      char separator = 0;
+      stream >> benchmarkWidth >> separator >> benchmarkHeight;
+      if (stream.fail() || separator != 'x' || benchmarkWidth == 0 || benchmarkHeight == 0)
+        throw logic_error("invalid benchmark resolution, expected WIDTHxHEIGHT");
+    }
+    else if (matches(pOption, "--benchmark-scenarios")) {
+      string arg;
+      getArgs(argc, argv, ++i, arg);
+      istringstream stream(arg);
+      for (string scenario; getline(stream, scenario, ',');)
+        if (!scenario.empty()) benchmarkScenarios.push_back(scenario);
+    } else if (matches(pOption, "--benchmark-warmup"))
+      getArgs(argc, argv, ++i, benchmarkWarmup);
+    else if (matches(pOption, "--benchmark-repeat"))
+      getArgs(argc, argv, ++i, benchmarkRepetitions);
+    else if (matches(pOption, "--benchmark-format")) {
+      string arg;
+      getArgs(argc, argv, ++i, arg);
+      benchmarkFormat = getReportFormat(arg);
+    } else if (matches(pOption, "--benchmark-output"))
+      getArgs(argc, argv, ++i, benchmarkOutput);
+    else if (matches(pOption, "--headless"))
+      headless = true;
+    else if (matches(pOption, "--render")) {
+      getArgs(argc, argv, ++i, renderOutput);
+      mode = ApplicationMode::RENDER;
+    } else if (matches(pOption, "--render-resolution")) {
+      string arg;
+      getArgs(argc, argv, ++i, arg);
+      istringstream stream(arg);
+      char separator = 0;
+      stream >> renderWidth >> separator >> renderHeight;
+      if (stream.fail() || separator != 'x' || renderWidth == 0 || renderHeight == 0)
+        throw logic_error("invalid render resolution, expected WIDTHxHEIGHT");
+    }
     else if (matches(pOption, "--help", "-h"))
       mode = ApplicationMode::HELP;
     else if (matches(pOption, "--version", "-v"))
@@ -90,6 +146,11 @@ CmdLineParameters::CmdLineParameters(int argc, const char* const* argv) {
       outputColorSpace = resolveFromName(colorSpaceString.c_str());
     } else if (matches(pOption, "--viewinglut"))
 			getArgs(argc, argv, ++i, lutFilePath);
+    else if (matches(pOption, "--lut-size")) {
+      getArgs(argc, argv, ++i, lutEdgeSize);
+      if (lutEdgeSize != 17 && lutEdgeSize != 33 && lutEdgeSize != 65)
+        throw logic_error("invalid lut size, expected 17, 33 or 65");
+    }
     else if (*pOption != '-')
       additionnalOptions.push_back(pOption);
     else
@@ -102,6 +163,34 @@ void CmdLineParameters::printHelpMessage() const {
   -h, --help                 display this help and exit
   -v, --version              output version information and exit
       --benchmark            tests current machine's performance.
+      --benchmark-scenarios LIST
+                             comma separated upload scenarios to run
+                             [sync, pbo, multi-pbo, persistent, thread,
+                             cpu-color, gl-color],
+                             all by default.
+      --benchmark-warmup N   untimed iterations per test, default is 10.
+      --benchmark-repeat N   timed iterations per test, default is 100.
+      --benchmark-format FMT report as text, json or csv.
+      --benchmark-output FILE
+                             write the report to FILE instead of stdout.
+      --playback-benchmark   plays synthetic dpx, tga and exr sequences
+                             from a temporary folder and reports the
+                             sustained framerate. Formats can be chosen
+                             with --benchmark-scenarios.
+      --benchmark-frames N   frames per sequence, default is 100.
+      --benchmark-resolution WxH
+                             sequence resolution, default is 2048x1556.
+      --headless             benchmark in a hidden window, using EGL
+                             when available.
+      --render PATTERN       render the files in a hidden window, color
+                             pipeline and overlays included, and write
+                             each frame in the format of the PATTERN
+                             extension (dpx, tga and OpenImageIO formats).
+                             '#' in PATTERN are replaced by the frame
+                             number (out/f.####.dpx). GLFW still needs a
+                             display server, even with EGL.
+      --render-resolution WxH
+                             rendered image size, default is 1920x1080.
       --swapinterval SIZE    specifies SIZE mandatory count of wait for
                              vblank before displaying a frame, default is 1.
 
@@ -120,6 +209,23 @@ void CmdLineParameters::printHelpMessage() const {
       --viewinglut           allow to apply a 3D lookup table on your file
                              file supported : 3dl, cube, csp.
 
+      --lut-size SIZE        edge of the 3D LUT applying the color pipeline,
+                             17, 33 or 65, default is 33.
+
+      --proxy                decode at reduced resolution during playback
+                             when the image is displayed zoomed out.
+      --roi                  decode only the visible part of the image
+                             during playback when zoomed in.
+      --mipmap               filter minified images with a mip chain
+                             generated on the GPU at upload time.
+      --tile-size SIZE       display images larger than SIZE pixels as
+                             tiles streamed on demand, images larger than
+                             the GPU texture limit are always tiled.
+      --probe-formats        time uploads to pick the fastest texture
+                             format for this driver and remember it.
+      --metrics-port PORT    serve playback and cache metrics in
+                             Prometheus format on localhost:PORT/metrics.
+
   -f, --fullscreen           switch to fullscreen mode.
   -l, --list-formats         output supported formats and exit
   -s, --cache-size SIZE      size of the in-memory cache system in MiB,
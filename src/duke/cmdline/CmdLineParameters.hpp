@@ -6,6 +6,7 @@
 
 #include <duke/time/FrameUtils.hpp>
 #include <duke/engine/ColorSpace.hpp>
+#include <duke/cmdline/ReportFormat.hpp>
 
 namespace duke {
 
@@ -16,6 +17,8 @@ struct commandline_error : std::runtime_error {
 enum class ApplicationMode {
   DUKE,
   BENCHMARK,
+  PLAYBACK_BENCHMARK,
+  RENDER,
   HELP,
   VERSION,
   LIST_SUPPORTED_FORMAT
@@ -27,6 +30,12 @@ struct CmdLineParameters {
   unsigned swapBufferInterval = 1;
   bool fullscreen = false;
   bool unlimitedFPS = false;
+  bool proxyDecode = false;
+  bool regionDecode = false;
+  bool mipmapDisplay = false;
+  size_t textureTileSize = 0;  // 0 only tiles images larger than the texture size limit
+  bool probeTextureFormats = false;  // times uploads instead of trusting the driver, refreshes the cache
+  unsigned metricsPort = 0;  // 0 disables the metrics server
   unsigned workerThreadDefault = getDefaultConcurrency();
   size_t imageCacheSizeDefault = getDefaultCacheSize();
   ApplicationMode mode = ApplicationMode::DUKE;
@@ -35,6 +44,22 @@ struct CmdLineParameters {
   ColorSpace inputColorSpace = ColorSpace::linear;
   ColorSpace outputColorSpace = ColorSpace::linear;
   std::string lutFilePath;
+  unsigned lutEdgeSize = 33;  // of the 3D LUT applying the color pipeline
+  // benchmark mode
+  std::vector<std::string> benchmarkScenarios;  // empty runs all of them, formats for playback
+  size_t benchmarkWarmup = 10;
+  size_t benchmarkRepetitions = 100;
+  ReportFormat benchmarkFormat = ReportFormat::TEXT;
+  std::string benchmarkOutput;  // standard output when empty
+  bool headless = false;
+  // playback benchmark mode
+  size_t benchmarkFrames = 100;
+  size_t benchmarkWidth = 2048;
+  size_t benchmarkHeight = 1556;
+  // render mode
+  std::string renderOutput;  // '#' are replaced by the frame number
+  size_t renderWidth = 1920;
+  size_t renderHeight = 1080;
   static unsigned getDefaultConcurrency();
   static size_t getDefaultCacheSize();
 };
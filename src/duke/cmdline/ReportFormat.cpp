@@ -0,0 +1,14 @@
+#include "ReportFormat.hpp"
+
+#include <stdexcept>
+
+namespace duke {
+
+ReportFormat getReportFormat(const std::string& name) {
+  if (name == "text") return ReportFormat::TEXT;
+  if (name == "json") return ReportFormat::JSON;
+  if (name == "csv") return ReportFormat::CSV;
+  throw std::logic_error("unknown report format '" + name + "', expected text, json or csv");
+}
+
+}  // namespace duke
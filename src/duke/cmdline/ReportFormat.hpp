@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+
+namespace duke {
+
+// Layout of the benchmark reports.
+enum class ReportFormat {
+  TEXT,
+  JSON,
+  CSV
+};
+
+// Throws on unknown names, accepts "text", "json" and "csv".
+ReportFormat getReportFormat(const std::string& name);
+
+}  // namespace duke
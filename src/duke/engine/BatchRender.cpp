@@ -0,0 +1,79 @@
+#include "BatchRender.hpp"
+
+#include <duke/attributes/AttributeKeys.hpp>
+#include <duke/cmdline/CmdLineParameters.hpp>
+#include <duke/engine/DukeApplication.hpp>
+#include <duke/engine/DukeMainWindow.hpp>
+#include <duke/engine/SequenceWriter.hpp>
+#include <duke/gl/GL.hpp>
+#include <duke/gl/GlFwApp.hpp>
+
+#include <cstdio>
+#include <iostream>
+
+namespace duke {
+
+namespace {
+
+// The readback is BGRA bottom to top, the alpha is dropped.
+FrameData getRenderedFrame(size_t width, size_t height, const char* pBgra) {
+  FrameData frame;
+  auto& description = frame.description;
+  description.width = width;
+  description.height = height;
+  description.glFormat = GL_RGB8;
+  description.swapRedAndBlue = true;
+  description.dataSize = width * height * 3;
+  attribute::set<attribute::DpxImageOrientation>(frame.attributes, 4);
+  frame.pData.reset(new char[description.dataSize], [](char* pData) { delete[] pData; });
+  char* pOut = frame.pData.get();
+  for (size_t i = 0, pixels = width * height; i < pixels; ++i, pBgra += 4) {
+    *pOut++ = pBgra[0];
+    *pOut++ = pBgra[1];
+    *pOut++ = pBgra[2];
+  }
+  return frame;
+}
+
+}  // namespace
+
+std::string getFrameFilename(const std::string& pattern, size_t frame) {
+  const size_t last = pattern.rfind('#');
+  if (last == std::string::npos) {
+    const size_t separator = pattern.find_last_of("/.");
+    const bool hasExtension = separator != std::string::npos && pattern[separator] == '.';
+    return getFrameFilename(hasExtension ? pattern.substr(0, separator) + ".####" + pattern.substr(separator)
+                                         : pattern + ".####",
+                            frame);
+  }
+  size_t first = last;
+  while (first > 0 && pattern[first - 1] == '#') --first;
+  char number[32];
+  snprintf(number, sizeof(number), "%0*zu", int(last + 1 - first), frame);
+  return pattern.substr(0, first) + number + pattern.substr(last + 1);
+}
+
+void batchRender(const CmdLineParameters& parameters) {
+  if (parameters.additionnalOptions.empty()) throw commandline_error("nothing to render");
+  const Timeline timeline = buildTimeline(parameters.additionnalOptions);
+  if (timeline.empty()) throw commandline_error("nothing to render");
+  const size_t width = parameters.renderWidth;
+  const size_t height = parameters.renderHeight;
+
+  DukeGLFWApplication application;
+  application.setHeadless();
+  DukeMainWindow window(application.createRawWindow(width, height, "duke", nullptr, nullptr), parameters);
+  window.load(timeline, parameters.defaultFrameRate, FitMode::INNER, 0);
+
+  const Range range = timeline.getRange();
+  std::cerr << "rendering frames " << range.first << " to " << range.last << std::endl;
+  // encoding and writing overlap with the rendering of the next frames
+  SequenceWriter writer;
+  window.renderOffscreen(range, glm::ivec2(width, height), [&](size_t frame, const char* pData, size_t) {
+    writer.push(getFrameFilename(parameters.renderOutput, frame), getRenderedFrame(width, height, pData));
+  });
+  writer.finish();
+  std::cerr << writer.getWrittenCount() << " frames written" << std::endl;
+}
+
+} /* namespace duke */
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+namespace duke {
+
+struct CmdLineParameters;
+
+// Replaces the last run of '#' in pattern by the zero padded frame number,
+// the number is inserted before the extension when there is none.
+std::string getFrameFilename(const std::string& pattern, size_t frame);
+
+// Renders the timeline in a hidden window and writes every frame as
+// displayed, color pipeline and overlays included, to parameters.renderOutput.
+// The file format follows the extension, frames are encoded in parallel.
+void batchRender(const CmdLineParameters& parameters);
+
+} /* namespace duke */
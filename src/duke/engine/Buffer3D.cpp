@@ -1,70 +1,44 @@
 #include <duke/engine/Buffer3D.hpp>
+#include <duke/gl/RenderState.hpp>
+#include <duke/math/HalfFloat.hpp>
 
 namespace duke {
 
-  //Buffer3D to store and bind the texture generated by the OpenColorIOManager object
-
-  Buffer3D::Buffer3D(uint size){   
-    typedef float ComponentType;// GL_UNSIGNED_BYTE or GL_FLOAT ?
-    this->nbChannel=3; // GL_RGB
-    this->nbSamplePerChannel=32; // Resolved at creation, generally 16 or 32
-    this->rawBuffer = new ComponentType[nbChannel*size*size*size];
-
-    Buffer3D::createIDLut(size, rawBuffer); 
-  } 
-
-  Buffer3D::~Buffer3D() {
-    if (rawBuffer) 
-      delete [] rawBuffer;
+Buffer3D::Buffer3D(unsigned int size) : Buffer3D(size, createIDLut(size).data()) {}
+
+Buffer3D::Buffer3D(unsigned int size, const float *pRgb) : nbChannel(3), nbSamplePerChannel(size) {
+  rawBuffer.resize(nbChannel * size * size * size);
+  for (auto &component : rawBuffer) component = toHalf(*pRgb++);
+}
+
+void Buffer3D::uploadTo(gl::GlTexture3D &tex, unsigned int textID) const {
+  auto &renderState = gl::RenderState::current();
+  const GLuint previousUnit = renderState.getActiveTexture();
+  renderState.activeTexture(textID);
+  {
+    auto textureBound = tex.scope_bind_texture();
+    // the shader interpolates with texelFetch, see OpenColorIOManager
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    glTexImage3D(GL_TEXTURE_3D, 0, GL_RGB16F, nbSamplePerChannel, nbSamplePerChannel, nbSamplePerChannel, 0, GL_RGB,
+                 GL_HALF_FLOAT, rawBuffer.data());
   }
-  
-  void Buffer3D::uploadTo(gl::GlTexture3D &tex, uint textID) {
-	
-    GLint memID;
-        glGetIntegerv(GL_ACTIVE_TEXTURE, &memID);
-	switch(textID)
-	  {
-	  case '1':
-	    glActiveTexture(GL_TEXTURE1);
-	    break;
-	  case '2':
-	    glActiveTexture(GL_TEXTURE2);
-	     break;	
-	  case '3':
-	    glActiveTexture(GL_TEXTURE3);
-	    break;
-	  default:
-	    glActiveTexture(GL_TEXTURE0);
-	    break;
-   
-	  }
-
-	//glEnable(GL_TEXTURE_3D);
-	auto textureBound = tex.scope_bind_texture();
-	// Interpolation ?
-	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-	// Initialize the bounds of the 3d texture
-	glTexImage3D(GL_TEXTURE_3D, 0, GL_RGB, 
-		     nbSamplePerChannel, nbSamplePerChannel, nbSamplePerChannel, 
-		     0, GL_RGB, GL_FLOAT, &rawBuffer[0]);//TODO if not rgb or float
-        glActiveTexture(memID);
-  }
-
-
-  void Buffer3D::createIDLut(uint size, ComponentType *rawBuffer) {//create identity lut
-
-    // Precompute the inverse of the size
-    float invSizef = float(1. / ( size - 1. ));
-    // Pull the colors on the LUT - RGB
-    for(uint i = 0; i < size * size * size; i++)
-        {
-            *rawBuffer++ = (float)(i%size) * invSizef;
-            *rawBuffer++ = (float)((i/size)%size) * invSizef;
-            *rawBuffer++ = (float)((i/size/size)%size) * invSizef;
-        }	
+  renderState.activeTexture(previousUnit);
+}
+
+std::vector<float> Buffer3D::createIDLut(unsigned int size) {
+  std::vector<float> lut;
+  lut.reserve(3 * size * size * size);
+  const float invSizef = 1.f / (size - 1);
+  for (unsigned int i = 0; i < size * size * size; i++) {
+    lut.push_back((i % size) * invSizef);
+    lut.push_back(((i / size) % size) * invSizef);
+    lut.push_back(((i / size / size) % size) * invSizef);
   }
- 
+  return lut;
+}
 
-};//namespace duke
+}  // namespace duke
@@ -1,31 +1,26 @@
 #pragma once
-#include <fstream>
-#include <sstream>
-#include <cstdio> // sscanf
-#include <cmath>
-#include <cstdlib>
-#include <cstring>
-#include <iostream>
+
+#include <cstdint>
 #include <vector>
 
 #include "duke/gl/GlObjects.hpp"
 
-
 namespace duke {
 
+// A 3D LUT stored as half floats, uploaded as a GL_RGB16F texture.
 struct Buffer3D {
-	
-  typedef float ComponentType;// GL_UNSIGNED_BYTE or GL_FLOAT ?
-  ComponentType *rawBuffer;
+  typedef uint16_t ComponentType;  // IEEE half float
+  std::vector<ComponentType> rawBuffer;
   unsigned int nbChannel;
-  unsigned int nbSamplePerChannel;    
- 
-  Buffer3D(uint size);
-  ~Buffer3D();
-  void uploadTo(gl::GlTexture3D  &tex, uint textID);
-  void createIDLut(uint size, ComponentType *rawBuffer);
+  unsigned int nbSamplePerChannel;
 
-};
+  // Identity LUT.
+  Buffer3D(unsigned int size);
+  // From size^3 RGB float triplets, red varying fastest as OCIO lays them out.
+  Buffer3D(unsigned int size, const float *pRgb);
 
-};//namespace duke
+  void uploadTo(gl::GlTexture3D &tex, unsigned int textID) const;
+  static std::vector<float> createIDLut(unsigned int size);
+};
 
+}  // namespace duke
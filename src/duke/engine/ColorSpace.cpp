@@ -1,6 +1,9 @@
 #include "duke/engine/ColorSpace.hpp"
+#include "duke/attributes/AttributeKeys.hpp"
 #include "duke/base/StringUtils.hpp"
+#include "duke/filesystem/FsUtils.hpp"
 
+#include <mutex>
 #include <stdexcept>
 #include <set>
 #include <string>
@@ -35,7 +38,10 @@ ColorSpace resolveFromExtension(const char* pFileExtension) {
     if (streq(pFileExtension, "jpg")) return ColorSpace::sRGB;
     if (streq(pFileExtension, "png")) return ColorSpace::sRGB;
   }
+  // thumbnails are resolved from worker threads
+  static std::mutex mutex;
   static std::set<std::string> reported;
+  std::lock_guard<std::mutex> lock(mutex);
   if (reported.find(pFileExtension) == reported.end()) {
     printf("Unable to find default ColorSpace for extension '%s' assuming sRGB\n", pFileExtension);
     reported.insert(pFileExtension);
@@ -77,5 +83,12 @@ ColorSpace resolveFromExtension(const char* pFileExtension) {
     throw std::runtime_error("unknown colorspace");
     }
 
+ColorSpace resolveColorSpace(const attribute::Attributes& attributes, ColorSpace forced) {
+  if (forced != ColorSpace::linear) return forced;
+  const ColorSpace reported = resolveFromName(attribute::getWithDefault<attribute::OiioColorspace>(attributes));
+  if (reported != ColorSpace::linear) return reported;
+  return resolveFromExtension(fileExtension(attribute::getOrDie<attribute::File>(attributes)));
+}
+
   
 }  // namespace duke
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <duke/attributes/Attributes.hpp>
+
 namespace duke {
 
 enum class ColorSpace {
@@ -23,5 +25,8 @@ enum class ColorSpace {
 ColorSpace resolveFromExtension(const char* pFileExtension);
 ColorSpace resolveFromName(const char* pColorspace);
 const char* getColorspaceString(ColorSpace &colorspace);
+// The colorspace of a decoded image: 'forced' unless linear, then the one
+// reported by the reader, then the one deduced from the file extension.
+ColorSpace resolveColorSpace(const attribute::Attributes& attributes, ColorSpace forced);
 
 } /* namespace duke */
@@ -0,0 +1,359 @@
+#include "ColorTransforms.hpp"
+
+#include <duke/base/ParallelFor.hpp>
+#include <duke/gl/GL.hpp>
+#include <duke/gl/GLUtils.hpp>
+#include <duke/math/HalfFloat.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace duke {
+
+namespace {
+
+// Log curves defined on 10 bits code values, linear = gain * 10^((code - offset) / scale) - black.
+struct LogCurve {
+  float white;  // code value of linear 1
+  float scale;
+  float black;  // linear value of code 0 before normalization
+  float gain;   // 1 / (1 - black)
+
+  LogCurve(float blackCode, float whiteCode, float codesPerDecade)
+      : white(whiteCode), scale(codesPerDecade), black(std::pow(10.f, (blackCode - whiteCode) / codesPerDecade)) {
+    gain = 1.f / (1.f - black);
+  }
+
+  float toLinear(float value) const { return (std::pow(10.f, (value * 1023.f - white) / scale) - black) * gain; }
+  float fromLinear(float value) const {
+    return (white + scale * std::log10(std::max(value / gain + black, 1e-10f))) / 1023.f;
+  }
+};
+
+const LogCurve kCineon(95, 685, 300);
+const LogCurve kPanalog(64, 681, 444);
+const LogCurve kREDLog(0, 1023, 511);
+
+// ARRI LogC v3, exposure index 800
+const float kLogCCut = 0.010591f, kLogCA = 5.555556f, kLogCB = 0.052272f, kLogCC = 0.247190f, kLogCD = 0.385537f,
+            kLogCE = 5.367655f, kLogCF = 0.092809f;
+
+float srgbToLinear(float value) {
+  return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+float linearToSrgb(float value) {
+  return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+}
+
+float rec709ToLinear(float value) { return value < 0.081f ? value / 4.5f : std::pow((value + 0.099f) / 1.099f, 1.f / 0.45f); }
+
+float linearToRec709(float value) { return value < 0.018f ? value * 4.5f : 1.099f * std::pow(value, 0.45f) - 0.099f; }
+
+float logCToLinear(float value) {
+  return value > kLogCE * kLogCCut + kLogCF ? (std::pow(10.f, (value - kLogCD) / kLogCC) - kLogCB) / kLogCA
+                                             : (value - kLogCF) / kLogCE;
+}
+
+float linearToLogC(float value) {
+  return value > kLogCCut ? kLogCC * std::log10(kLogCA * value + kLogCB) + kLogCD : kLogCE * value + kLogCF;
+}
+
+// Josh Pines' log, 0.18 at code 445
+float plogToLinear(float value) { return std::pow(10.f, (value * 1023.f - 445.f) * 0.002f / 0.6f) * 0.18f; }
+
+float linearToPlog(float value) {
+  return (445.f + std::log10(std::max(value / 0.18f, 1e-10f)) * 0.6f / 0.002f) / 1023.f;
+}
+
+float viperToLinear(float value) { return std::pow(10.f, (value * 1023.f - 1023.f) / 500.f); }
+
+float linearToViper(float value) { return (1023.f + 500.f * std::log10(std::max(value, 1e-10f))) / 1023.f; }
+
+// Sony S-Log (first version)
+float slogToLinear(float value) { return std::pow(10.f, (value - 0.616596f - 0.03f) / 0.432699f) - 0.037584f; }
+
+float linearToSlog(float value) {
+  return 0.432699f * std::log10(std::max(value + 0.037584f, 1e-10f)) + 0.616596f + 0.03f;
+}
+
+float gammaToLinear(float value, float gamma) { return std::pow(std::max(value, 0.f), gamma); }
+
+template <typename F>
+void transform(float *pValues, size_t count, F function) {
+  for (size_t i = 0; i < count; ++i) pValues[i] = function(pValues[i]);
+}
+
+typedef float (*Transfer)(float);
+
+// nullptr for the colorspaces that are already linear.
+Transfer getToLinear(ColorSpace colorspace) {
+  switch (colorspace) {
+    case ColorSpace::linear:
+    case ColorSpace::raw:
+      return nullptr;
+    case ColorSpace::sRGB:
+    case ColorSpace::sRGBf:
+      return &srgbToLinear;
+    case ColorSpace::rec709:
+      return &rec709ToLinear;
+    case ColorSpace::Cineon:
+      return [](float value) { return kCineon.toLinear(value); };
+    case ColorSpace::Panalog:
+      return [](float value) { return kPanalog.toLinear(value); };
+    case ColorSpace::REDLog:
+      return [](float value) { return kREDLog.toLinear(value); };
+    case ColorSpace::ViperLog:
+      return &viperToLinear;
+    case ColorSpace::AlexaV3LogC:
+      return &logCToLinear;
+    case ColorSpace::PLogLin:
+      return &plogToLinear;
+    case ColorSpace::SLog:
+      return &slogToLinear;
+    case ColorSpace::Gamma18:
+      return [](float value) { return gammaToLinear(value, 1.8f); };
+    case ColorSpace::Gamma22:
+      return [](float value) { return gammaToLinear(value, 2.2f); };
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+float toLinear(ColorSpace colorspace, float value) {
+  toLinear(colorspace, &value, 1);
+  return value;
+}
+
+float fromLinear(ColorSpace colorspace, float value) {
+  fromLinear(colorspace, &value, 1);
+  return value;
+}
+
+void toLinear(ColorSpace colorspace, float *pValues, size_t count) {
+  const Transfer transfer = getToLinear(colorspace);
+  if (transfer) transform(pValues, count, transfer);
+}
+
+void fromLinear(ColorSpace colorspace, float *pValues, size_t count) {
+  switch (colorspace) {
+    case ColorSpace::linear:
+    case ColorSpace::raw:
+      return;
+    case ColorSpace::sRGB:
+    case ColorSpace::sRGBf:
+      return transform(pValues, count, &linearToSrgb);
+    case ColorSpace::rec709:
+      return transform(pValues, count, &linearToRec709);
+    case ColorSpace::Cineon:
+      return transform(pValues, count, [](float value) { return kCineon.fromLinear(value); });
+    case ColorSpace::Panalog:
+      return transform(pValues, count, [](float value) { return kPanalog.fromLinear(value); });
+    case ColorSpace::REDLog:
+      return transform(pValues, count, [](float value) { return kREDLog.fromLinear(value); });
+    case ColorSpace::ViperLog:
+      return transform(pValues, count, &linearToViper);
+    case ColorSpace::AlexaV3LogC:
+      return transform(pValues, count, &linearToLogC);
+    case ColorSpace::PLogLin:
+      return transform(pValues, count, &linearToPlog);
+    case ColorSpace::SLog:
+      return transform(pValues, count, &linearToSlog);
+    case ColorSpace::Gamma18:
+      return transform(pValues, count, [](float value) { return gammaToLinear(value, 1.f / 1.8f); });
+    case ColorSpace::Gamma22:
+      return transform(pValues, count, [](float value) { return gammaToLinear(value, 1.f / 2.2f); });
+  }
+}
+
+namespace {
+
+enum class Encoding { UNORM8, UNORM16, HALF, FLOAT, PACKED10 };
+
+inline uint16_t load16(const char *pData, bool swap) {
+  uint16_t value;
+  memcpy(&value, pData, sizeof(value));
+  return swap ? uint16_t((value >> 8) | (value << 8)) : value;
+}
+
+inline uint32_t load32(const char *pData, bool swap) {
+  uint32_t value;
+  memcpy(&value, pData, sizeof(value));
+  if (swap)
+    value = (value >> 24) | ((value >> 8) & 0xff00) | ((value << 8) & 0xff0000) | (value << 24);
+  return value;
+}
+
+inline float loadFloat(const char *pData, bool swap) {
+  const uint32_t bits = load32(pData, swap);
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Everything a row decoder needs, resolved once per frame.
+struct Decoding {
+  std::vector<float> table;  // linear value of each code value, empty for floats
+  Transfer toLinear;         // for floats only
+  bool swapEndianness;
+  bool swapRedAndBlue;
+};
+
+// Component loaders, one per Encoding. Colors go through the code value table,
+// floats through the transfer function. Alpha is never transformed.
+struct Unorm8 {
+  static const size_t SIZE = 1;
+  static float color(const char *pData, const Decoding &decoding) { return decoding.table[uint8_t(*pData)]; }
+  static float alpha(const char *pData, bool) { return uint8_t(*pData) / 255.f; }
+};
+
+struct Unorm16 {
+  static const size_t SIZE = 2;
+  static float color(const char *pData, const Decoding &decoding) {
+    return decoding.table[load16(pData, decoding.swapEndianness)];
+  }
+  static float alpha(const char *pData, bool swap) { return load16(pData, swap) / 65535.f; }
+};
+
+struct Half {
+  static const size_t SIZE = 2;
+  static float color(const char *pData, const Decoding &decoding) { return Unorm16::color(pData, decoding); }
+  static float alpha(const char *pData, bool swap) { return fromHalf(load16(pData, swap)); }
+};
+
+struct Float {
+  static const size_t SIZE = 4;
+  static float color(const char *pData, const Decoding &decoding) {
+    const float value = loadFloat(pData, decoding.swapEndianness);
+    return decoding.toLinear ? decoding.toLinear(value) : value;
+  }
+  static float alpha(const char *pData, bool swap) { return loadFloat(pData, swap); }
+};
+
+// Colors, alpha and the red/blue swap in a single pass over the row, the
+// format is a template parameter so the loop has no per pixel switch.
+template <typename COMPONENT, size_t CHANNELS>
+void decodeRow(const char *pRow, const Decoding &decoding, size_t width, float *pOut) {
+  const size_t red = decoding.swapRedAndBlue ? 2 : 0;
+  const size_t blue = 2 - red;
+  const size_t size = COMPONENT::SIZE;
+  for (size_t x = 0; x < width; ++x, pRow += CHANNELS * size, pOut += 4) {
+    if (CHANNELS == 1) {
+      pOut[0] = pOut[1] = pOut[2] = COMPONENT::color(pRow, decoding);
+    } else {
+      pOut[red] = COMPONENT::color(pRow, decoding);
+      pOut[1] = COMPONENT::color(pRow + size, decoding);
+      pOut[blue] = COMPONENT::color(pRow + 2 * size, decoding);
+    }
+    pOut[3] = CHANNELS == 4 ? COMPONENT::alpha(pRow + 3 * size, decoding.swapEndianness) : 1.f;
+  }
+}
+
+// DPX 10 bits method A, red in the most significant bits.
+void decodePacked10Row(const char *pRow, const Decoding &decoding, size_t width, float *pOut) {
+  const size_t red = decoding.swapRedAndBlue ? 2 : 0;
+  const size_t blue = 2 - red;
+  for (size_t x = 0; x < width; ++x, pRow += 4, pOut += 4) {
+    const uint32_t word = load32(pRow, decoding.swapEndianness);
+    pOut[red] = decoding.table[(word >> 22) & 0x3ff];
+    pOut[1] = decoding.table[(word >> 12) & 0x3ff];
+    pOut[blue] = decoding.table[(word >> 2) & 0x3ff];
+    pOut[3] = 1.f;
+  }
+}
+
+typedef void (*RowDecoder)(const char *pRow, const Decoding &decoding, size_t width, float *pOut);
+
+struct Layout {
+  Encoding encoding;
+  size_t bytesPerPixel;
+  RowDecoder decodeRow;
+};
+
+Layout getLayout(size_t glFormat) {
+  switch (glFormat) {
+    case GL_R8:
+      return {Encoding::UNORM8, 1, &decodeRow<Unorm8, 1>};
+    case GL_RGB8:
+      return {Encoding::UNORM8, 3, &decodeRow<Unorm8, 3>};
+    case GL_RGBA8:
+      return {Encoding::UNORM8, 4, &decodeRow<Unorm8, 4>};
+    case GL_R16:
+      return {Encoding::UNORM16, 2, &decodeRow<Unorm16, 1>};
+    case GL_RGB16:
+      return {Encoding::UNORM16, 6, &decodeRow<Unorm16, 3>};
+    case GL_RGBA16:
+      return {Encoding::UNORM16, 8, &decodeRow<Unorm16, 4>};
+    case GL_R16F:
+      return {Encoding::HALF, 2, &decodeRow<Half, 1>};
+    case GL_RGB16F:
+      return {Encoding::HALF, 6, &decodeRow<Half, 3>};
+    case GL_RGBA16F:
+      return {Encoding::HALF, 8, &decodeRow<Half, 4>};
+    case GL_R32F:
+      return {Encoding::FLOAT, 4, &decodeRow<Float, 1>};
+    case GL_RGB32F:
+      return {Encoding::FLOAT, 12, &decodeRow<Float, 3>};
+    case GL_RGBA32F:
+      return {Encoding::FLOAT, 16, &decodeRow<Float, 4>};
+    case GL_RGB10_A2UI:
+      return {Encoding::PACKED10, 4, &decodePacked10Row};
+    default:
+      throw std::runtime_error(std::string("no CPU color conversion for ") + getInternalFormatString(glFormat));
+  }
+}
+
+// Linear value of each code value.
+std::vector<float> buildTable(ColorSpace colorspace, Encoding encoding) {
+  std::vector<float> table;
+  switch (encoding) {
+    case Encoding::UNORM8:
+      table.resize(1 << 8);
+      for (size_t i = 0; i < table.size(); ++i) table[i] = i / 255.f;
+      break;
+    case Encoding::PACKED10:
+      table.resize(1 << 10);
+      for (size_t i = 0; i < table.size(); ++i) table[i] = i / 1023.f;
+      break;
+    case Encoding::UNORM16:
+      table.resize(1 << 16);
+      for (size_t i = 0; i < table.size(); ++i) table[i] = i / 65535.f;
+      break;
+    case Encoding::HALF:
+      table.resize(1 << 16);
+      for (size_t i = 0; i < table.size(); ++i) table[i] = fromHalf(i);
+      break;
+    case Encoding::FLOAT:
+      return table;
+  }
+  toLinear(colorspace, table.data(), table.size());
+  return table;
+}
+
+}  // namespace
+
+void decodeToLinear(const FrameData &frame, ColorSpace colorspace, RgbaImage &image, unsigned threads) {
+  const Layout layout = getLayout(frame.description.glFormat);
+  const auto &description = frame.description;
+  image.width = description.getDataWidth();
+  image.height = description.getDataHeight();
+  image.pixels.resize(image.width * image.height * 4);
+  const size_t stride = image.width * layout.bytesPerPixel;
+  if (description.dataSize < stride * image.height) throw std::runtime_error("frame data is smaller than its description");
+  const char *pData = frame.pData.get();
+  Decoding decoding;
+  decoding.table = buildTable(colorspace, layout.encoding);
+  decoding.toLinear = getToLinear(colorspace);
+  decoding.swapEndianness = description.swapEndianness;
+  decoding.swapRedAndBlue = description.swapRedAndBlue;
+  parallelFor(image.height, threads, [&](size_t begin, size_t end) {
+    for (size_t y = begin; y < end; ++y) layout.decodeRow(pData + y * stride, decoding, image.width, image.row(y));
+  });
+}
+
+} /* namespace duke */
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <duke/engine/ColorSpace.hpp>
+#include <duke/image/FrameData.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace duke {
+
+// Transfer functions between an encoded value and scene linear, matching the
+// OCIO reference configurations. Cineon like curves map the reference black
+// to 0 and the reference white to 1, fromLinear(toLinear(x)) == x.
+float toLinear(ColorSpace colorspace, float value);
+float fromLinear(ColorSpace colorspace, float value);
+
+// In place over count values, the transfer function is resolved once per call
+// rather than per value.
+void toLinear(ColorSpace colorspace, float *pValues, size_t count);
+void fromLinear(ColorSpace colorspace, float *pValues, size_t count);
+
+// Interleaved RGBA floats, rows in the order of the frame data.
+struct RgbaImage {
+  size_t width = 0;
+  size_t height = 0;
+  std::vector<float> pixels;
+
+  float *row(size_t y) { return pixels.data() + y * width * 4; }
+  const float *row(size_t y) const { return pixels.data() + y * width * 4; }
+};
+
+/**
+ * Decodes the frame to linear RGBA floats without a GPU, eg. for scopes,
+ * thumbnails or exports on a render node.
+ * - Grayscale images are replicated on RGB, alpha is 1 when absent and is
+ *   never transformed.
+ * - Integer and half float data goes through a table indexed by code value,
+ *   the transfer function is only evaluated once per code value.
+ * - Rows are split across threads, 0 uses the hardware concurrency.
+ * Throws for formats it does not know.
+ */
+void decodeToLinear(const FrameData &frame, ColorSpace colorspace, RgbaImage &image, unsigned threads = 0);
+
+} /* namespace duke */
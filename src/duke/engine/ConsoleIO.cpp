@@ -3,7 +3,7 @@
 
 using namespace std;
 
-ConsoleIO::ConsoleIO() {
+ConsoleIO::ConsoleIO(const std::function<void()>& onInput) : m_OnInput(onInput) {
   m_Poller = thread(&ConsoleIO::run, this);
   m_Poller.detach();
 }
@@ -14,5 +14,8 @@ void ConsoleIO::poll(std::vector<std::string>& strings) { commands.drainTo(strin
 
 void ConsoleIO::run() {
   std::string line;
-  while (getline(cin, line)) commands.push(line);
+  while (getline(cin, line)) {
+    commands.push(line);
+    if (m_OnInput) m_OnInput();
+  }
 }
@@ -1,12 +1,14 @@
 #pragma once
 
 #include <concurrent/queue.hpp>
+#include <functional>
 #include <thread>
 #include <string>
 #include <vector>
 
 struct ConsoleIO {
-  ConsoleIO();
+  // onInput is called from the reading thread after each line.
+  ConsoleIO(const std::function<void()>& onInput = nullptr);
   ~ConsoleIO();
   void poll(std::vector<std::string>& strings);
 
@@ -14,5 +16,6 @@ struct ConsoleIO {
   void run();
 
   concurrent::queue<std::string> commands;
+  const std::function<void()> m_OnInput;
   std::thread m_Poller;
 };
@@ -40,8 +40,8 @@ struct Context {
   // file
   std::string filename;
   // current drawing
-  const FrameDescriptionAndAttributes *pCurrentImage;
-  const IMediaStream *pCurrentMediaStream;
+  const FrameDescriptionAndAttributes *pCurrentImage = nullptr;
+  const IMediaStream *pCurrentMediaStream = nullptr;
 };
 
 } /* namespace duke */
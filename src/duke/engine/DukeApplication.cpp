@@ -1,6 +1,7 @@
 #include "DukeApplication.hpp"
 
 #include <duke/attributes/AttributeKeys.hpp>
+#include <duke/base/ParallelFor.hpp>
 #include <duke/cmdline/CmdLineParameters.hpp>
 #include <duke/engine/streams/DiskMediaStream.hpp>
 #include <duke/engine/overlay/DukeSplashStream.hpp>
@@ -38,25 +39,36 @@ bool isValid(const std::string& filename) {
   return true;
 }
 
-void AddItemToTrack(const attribute::Attributes& options, const Item& item, Track& track, size_t& offset) {
-  auto pMediaStream(std::make_shared<DiskMediaStream>(options, item));
-  using namespace attribute;
-  const auto frameCount = getWithDefault<MediaFrameCount>(pMediaStream->getState());
-  track.add(offset, Clip{frameCount, std::move(pMediaStream), nullptr});
-  offset += frameCount;
+// Streams defer their I/O, only movies open a reader here to count their
+// frames, in parallel. Startup does not depend on the number of sequences.
+Track buildTrack(const attribute::Attributes& options, const std::vector<Item>& items) {
+  std::vector<std::shared_ptr<DiskMediaStream>> streams(items.size());
+  std::vector<size_t> frameCounts(items.size());
+  parallelFor(items.size(), 0, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      streams[i] = std::make_shared<DiskMediaStream>(options, items[i]);
+      frameCounts[i] = streams[i]->getFrameCount();
+    }
+  });
+  Track track;
+  size_t offset = 0;
+  for (size_t i = 0; i < items.size(); ++i) {
+    track.add(offset, Clip{frameCounts[i], std::move(streams[i]), nullptr});
+    offset += frameCounts[i];
+  }
+  return track;
 }
 
 }  // namespace
 
 Timeline buildTimeline(const std::vector<std::string>& paths) {
-  Track track;
-  size_t offset = 0;
+  std::vector<Item> items;
   attribute::Attributes options;
   for (const std::string& path : paths) {
     const std::string absolutePath = getAbsoluteFilename(path.c_str());
     switch (getFileStatus(absolutePath.c_str())) {
       case FileStatus::FILE:
-        AddItemToTrack(options, Item(absolutePath), track, offset);
+        items.emplace_back(absolutePath);
         break;
       case FileStatus::DIRECTORY:
         for (Item item : sequence::parseDir(getParserConf(), absolutePath.c_str()).files) {
@@ -67,7 +79,7 @@ Timeline buildTimeline(const std::vector<std::string>& paths) {
           switch (type) {
             case Item::SINGLE:
             case Item::PACKED:
-              AddItemToTrack(options, item, track, offset);
+              items.push_back(item);
               break;
             case Item::INDICED:
             default:
@@ -79,7 +91,7 @@ Timeline buildTimeline(const std::vector<std::string>& paths) {
         throw commandline_error("'" + absolutePath + "' is not a file nor a directory");
     }
   }
-  return {track};
+  return {buildTrack(options, items)};
 }
 
 Timeline buildDemoTimeline() {
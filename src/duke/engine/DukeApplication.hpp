@@ -3,10 +3,16 @@
 #include <duke/engine/DukeMainWindow.hpp>
 #include <duke/gl/GlFwApp.hpp>
 
+#include <string>
+#include <vector>
+
 namespace duke {
 
 struct CmdLineParameters;
 
+// Builds a single track timeline out of files and directories.
+Timeline buildTimeline(const std::vector<std::string> &paths);
+
 class DukeApplication : private DukeGLFWApplication {
  public:
   DukeApplication(const CmdLineParameters &parameters);
@@ -4,21 +4,44 @@
 #include <duke/engine/overlay/StatisticsOverlay.hpp>
 #include <duke/engine/overlay/OnScreenDisplayOverlay.hpp>
 #include <duke/engine/overlay/AttributesOverlay.hpp>
+#include <duke/engine/overlay/ContactSheetOverlay.hpp>
 #include <duke/engine/ConsoleIO.hpp>
 #include <duke/engine/rendering/ImageRenderer.hpp>
+#include <duke/engine/rendering/ShaderConstants.hpp>
 #include <duke/engine/commands/Commands.hpp>
 #include <duke/engine/ColorSpace.hpp>
 #include <duke/OpenColorIO/OpenColorIOManager.hpp>
 #include <duke/time/Clock.hpp>
+#include <duke/time/Trace.hpp>
 #include <duke/gl/GL.hpp>
-
+#include <duke/gl/PixelReadback.hpp>
+#include <duke/gl/RenderState.hpp>
+#include <duke/gl/SyncControl.hpp>
+#include <duke/gl/TextureFormats.hpp>
+#include <duke/engine/FramePacer.hpp>
+#include <duke/engine/Thumbnails.hpp>
+#include <duke/filesystem/FsUtils.hpp>
+#include <duke/metrics/Metrics.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
 #include <string>
 #include <sstream>
+#include <thread>
 
 namespace duke {
 
+namespace {
+
+const size_t kThumbnailSize = 192;
+
+}  // namespace
+
 DukeMainWindow::DukeMainWindow(GLFWwindow *pWindow, const CmdLineParameters &parameters)
-    : DukeGLFWWindow(pWindow), m_CmdLine(parameters), m_Player(parameters), m_GlyphRenderer(m_GeometryRenderer) {
+    : DukeGLFWWindow(pWindow), m_ProxyDecode(parameters.proxyDecode), m_RegionDecode(parameters.regionDecode), m_CmdLine(parameters), m_Player(parameters), m_GeometryRenderer(ProgramBinaryCache::getDefaultDirectory()), m_GlyphRenderer(m_GeometryRenderer) {
     m_Context.pGlyphRenderer = &m_GlyphRenderer;
     m_Context.pGeometryRenderer = &m_GeometryRenderer;
     m_Context.fileColorSpace = parameters.inputColorSpace;
@@ -35,7 +58,26 @@ DukeMainWindow::DukeMainWindow(GLFWwindow *pWindow, const CmdLineParameters &par
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glDisable(GL_DEPTH_TEST);
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    negotiateTextureFormats(parameters.probeTextureFormats);
+    m_GeometryRenderer.shaderPool.prewarm(m_pWindow);
+
+    // the color pipeline is built in the background, the render loop swaps it in
+    m_OCIOColorSpace = getColorspaceString(m_Context.screenColorSpace);
+    m_OCIOLutFile = parameters.lutFilePath;
+    m_pOCIOManager.reset(new OpenColorIOManager(m_OCIOColorSpace, m_OCIOLutFile, parameters.lutEdgeSize, &glfwPostEmptyEvent));
 
+    // rendering to files needs neither input nor the console
+    if (parameters.mode != ApplicationMode::RENDER) setupInteraction();
+
+    if (parameters.metricsPort) {
+        m_pMetricsServer.reset(new MetricsServer(parameters.metricsPort));
+        std::cout << "Serving metrics on http://localhost:" << m_pMetricsServer->getPort() << "/metrics" << std::endl;
+    }
+}
+
+DukeMainWindow::~DukeMainWindow() {}
+
+void DukeMainWindow::setupInteraction() {
     using std::bind;
     using std::placeholders::_1;
     using std::placeholders::_2;
@@ -45,6 +87,8 @@ DukeMainWindow::DukeMainWindow(GLFWwindow *pWindow, const CmdLineParameters &par
     mousePosCallback = bind(&DukeMainWindow::onMouseMove, this, _1, _2);
     scrollCallback = bind(&DukeMainWindow::onScroll, this, _1, _2);
     windowResizeCallback = bind(&DukeMainWindow::onWindowResize, this, _1, _2);
+    // uncovered or resized while paused, the framebuffer content is lost
+    windowRefreshFunCallback = [this]() { m_Dirty = true; };
     charCallback = bind(&DukeMainWindow::onChar, this, _1);
     keyCallback = bind(&DukeMainWindow::onKey, this, _1, _2);
     registerCallbacks();
@@ -69,6 +113,49 @@ DukeMainWindow::DukeMainWindow(GLFWwindow *pWindow, const CmdLineParameters &par
     [&]() {
         m_Player.cue(m_Player.getTimeline().getRange().last);
     });
+    m_Commands.addAndBind<FunctionCmd>({"proxy", "toggle reduced resolution decoding while playing"},
+    [&]() {
+        m_ProxyDecode = !m_ProxyDecode;
+        std::cout << "proxy decoding " << (m_ProxyDecode ? "on" : "off") << std::endl;
+    });
+    m_Commands.addAndBind<FunctionCmd>({"roi", "toggle decoding of the visible region only while playing"},
+    [&]() {
+        m_RegionDecode = !m_RegionDecode;
+        std::cout << "region of interest decoding " << (m_RegionDecode ? "on" : "off") << std::endl;
+    });
+    m_Commands.addAndBind<FunctionCmd>({"trace", "toggle tracing, stopping writes duke-trace.json"},
+    [&]() {
+        const bool tracing = !trace::isEnabled();
+        trace::setEnabled(tracing);
+        if (tracing)
+            std::cout << "tracing" << std::endl;
+        else if (trace::dumpChromeTrace("duke-trace.json"))
+            std::cout << "trace written to duke-trace.json" << std::endl;
+        else
+            std::cout << "unable to write duke-trace.json" << std::endl;
+    });
+    m_Commands.addAndBind<FunctionCmd>({"resetstats", "reset the latency distributions and frame counters"},
+    [&]() {
+        m_ResetStatistics = true;
+    });
+    m_Commands.addAndBind<FunctionWithArgCmd>({"colorspace", "change the OpenColorIO input colorspace", {value}},
+    [&](const std::string &colorspace) -> std::string {
+        if (colorspace.empty()) return "current colorspace is " + m_OCIOColorSpace;
+        m_OCIOColorSpace = colorspace;
+        m_pOCIOManager->request(m_OCIOColorSpace, m_OCIOLutFile);
+        return {};
+    });
+    m_Commands.addAndBind<FunctionWithArgCmd>({"lut", "apply a lut file instead of the display transform, none to reset", {path}},
+    [&](const std::string &path) -> std::string {
+        if (path.empty()) return m_OCIOLutFile.empty() ? "no lut file" : "current lut file is " + m_OCIOLutFile;
+        m_OCIOLutFile = path == "none" ? std::string() : path;
+        m_pOCIOManager->request(m_OCIOColorSpace, m_OCIOLutFile);
+        return {};
+    });
+    m_Commands.addAndBind<FunctionCmd>({"contactsheet", "toggle the thumbnails of all the clips"},
+    [&]() {
+        toggleContactSheet();
+    });
     m_Commands.addAndBind<FunctionCmd>({"quit", "quit the application"},
     [&]() {
         glfwSetWindowShouldClose(getHandle(), true);
@@ -79,8 +166,46 @@ DukeMainWindow::DukeMainWindow(GLFWwindow *pWindow, const CmdLineParameters &par
     std::cout << "Type 'cmds' to list available commands" << std::endl;
 }
 
+void DukeMainWindow::toggleContactSheet() {
+    m_ShowContactSheet = !m_ShowContactSheet;
+    m_Dirty = true;
+    if (!m_ShowContactSheet || m_pThumbnailEngine) return;
+    // thumbnails are generated once, the first time the sheet is shown
+    std::vector<const IMediaStream *> streams;
+    m_ContactSheetFrames.clear();
+    for (const Track &track : m_Player.getTimeline()) {
+        for (const auto &trackClip : track) {
+            if (!trackClip.second.pStream) continue;
+            streams.push_back(trackClip.second.pStream.get());
+            m_ContactSheetFrames.push_back(trackClip.first);
+        }
+    }
+    if (!m_pContactSheet) m_pContactSheet.reset(new ContactSheetOverlay(m_GlyphRenderer, kThumbnailSize));
+    m_pContactSheet->reset(streams.size());
+    m_pThumbnailEngine.reset(new ThumbnailEngine(streams, kThumbnailSize, m_Context.fileColorSpace,
+                                                 ThumbnailCache::getDefaultDirectory(), 0, &glfwPostEmptyEvent));
+}
+
+bool DukeMainWindow::updateContactSheet() {
+    if (!m_pThumbnailEngine) return false;
+    std::vector<ThumbnailEngine::Result> results;
+    m_pThumbnailEngine->collect(results);
+    for (const auto &result : results) {
+        const char *pLabel = strrchr(result.filename.c_str(), '/');
+        const std::string label = pLabel ? pLabel + 1 : result.filename;
+        if (result.error.empty())
+            m_pContactSheet->setThumbnail(result.index, result.thumbnail, label);
+        else
+            m_pContactSheet->setError(result.index, label);
+    }
+    return !results.empty();
+}
+
 void DukeMainWindow::load(const Timeline &timeline, const FrameDuration &frameDuration, const FitMode fitMode,
                           int speed) {
+    // the thumbnails refer to the streams of the previous timeline
+    m_pThumbnailEngine.reset();
+    m_ShowContactSheet = false;
     m_Player.load(timeline, frameDuration);
     m_Player.setPlaybackSpeed(speed);
     m_Context.fitMode = fitMode;
@@ -88,10 +213,12 @@ void DukeMainWindow::load(const Timeline &timeline, const FrameDuration &frameDu
 
 void DukeMainWindow::onKey(int key, int action) {
     if (action == GLFW_PRESS || action == GLFW_REPEAT) m_KeyStrokes.push_back(key);
+    m_Dirty = true;
 }
 
 void DukeMainWindow::onChar(unsigned int unicodeCodePoint) {
     m_CharStrokes.push_back(unicodeCodePoint);
+    m_Dirty = true;
 }
 
 void DukeMainWindow::onWindowResize(int width, int height) {
@@ -99,6 +226,7 @@ void DukeMainWindow::onWindowResize(int width, int height) {
     m_WindowDim.x = width;
     m_WindowDim.y = height;
     m_Context.resetFitMode = true;
+    m_Dirty = true;
 }
 
 void DukeMainWindow::onMouseMove(int x, int y) {
@@ -110,10 +238,22 @@ void DukeMainWindow::onMouseMove(int x, int y) {
 }
 
 void DukeMainWindow::onMouseClick(int buttonId, int buttonState) {
+    m_Dirty = true;
     if (buttonId == GLFW_MOUSE_BUTTON_LEFT)
     {
         m_MouseLeftDown = buttonState == GLFW_PRESS;
 
+        if (m_ShowContactSheet) {
+            // clicking a thumbnail moves to its clip
+            const int cell = m_MouseLeftDown ? m_pContactSheet->getCellAt(m_Context.viewport, m_MousePos) : -1;
+            if (cell >= 0) {
+                m_Player.cue(m_ContactSheetFrames[cell]);
+                m_ShowContactSheet = false;
+            }
+            m_MouseLeftDown = false;
+            return;
+        }
+
         if (m_MousePos.y >m_WindowDim.y-TimelineHeight)
         {
             int framenumber  = floor(m_MousePos.x*((float)m_Player.getTimeline().getRange().last/m_WindowDim.x));
@@ -123,6 +263,11 @@ void DukeMainWindow::onMouseClick(int buttonId, int buttonState) {
 }
 
 void DukeMainWindow::onScroll(double x, double y) {
+    m_Dirty = true;
+    if (m_ShowContactSheet) {
+        m_pContactSheet->scroll(m_Context.viewport, -y * 40);
+        return;
+    }
     const auto oldZoom = m_Context.zoom;
     auto newZoom = oldZoom;
     newZoom = logf(newZoom);
@@ -138,6 +283,7 @@ void DukeMainWindow::onScroll(double x, double y) {
 }
 
 void DukeMainWindow::onMouseDrag(int dx, int dy) {
+    m_Dirty = true;
 
     if (m_MousePos.y >m_WindowDim.y-TimelineHeight)
     {
@@ -194,10 +340,198 @@ const char *getFitModeString(FitMode &mode) {
 
  
 
+Time getMonitorRefreshPeriod(GLFWwindow *pWindow) {
+    GLFWmonitor *pMonitor = glfwGetWindowMonitor(pWindow);
+    if (!pMonitor) pMonitor = glfwGetPrimaryMonitor();
+    const GLFWvidmode *pMode = pMonitor ? glfwGetVideoMode(pMonitor) : nullptr;
+    // video modes round rates, eg. 59.94 Hz is reported as 59 or 60
+    const int rate = pMode && pMode->refreshRate > 0 ? pMode->refreshRate : 60;
+    return FramePacer::snapToStandardRate(Time(1, rate));
+}
+
 }  // namespace
 
+DukeMainWindow::PlaybackStatistics DukeMainWindow::benchmarkPlayback() {
+    m_PlaybackStatistics = PlaybackStatistics();
+    m_Player.setPlaybackMode(Player::STOP);
+    m_Player.cue(m_Player.getTimeline().getRange().first);
+    m_Player.setPlaybackSpeed(1);
+    m_ExitWhenStopped = true;
+    const auto start = duke_clock::now();
+    run();
+    m_ExitWhenStopped = false;
+    const auto &uploads = m_Player.getTextureCache().getStatistics();
+    m_PlaybackStatistics.uploads = uploads.uploads;
+    m_PlaybackStatistics.uploadMicroseconds = uploads.uploadMicroseconds;
+    m_PlaybackStatistics.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(duke_clock::now() - start);
+    return m_PlaybackStatistics;
+}
+
+void DukeMainWindow::drawImage(const Mesh *pMesh, const MediaFrameReference &mfr, const TexturePackedFrame &image) {
+    const auto &shaderPool = m_GeometryRenderer.shaderPool;
+    const auto &OCIOManager = *m_pOCIOManager;
+    if (image.pTiles) {
+        // streaming the tiles visible with the current zoom and pan
+        m_Player.getTextureCache().streamTiles(mfr, getVisibleRegion(m_Context));
+        for (const auto &tile : image.pTiles->getPageTable()) {
+            if (!tile.pTexture) continue;
+            auto &texture = *tile.pTexture;
+            auto boundTexture = texture.scope_bind_texture();
+            glTexParameteri(texture.target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(texture.target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            renderWithBoundTexture(shaderPool, pMesh, m_Context, OCIOManager.output, OCIOManager.flag_raw, &tile);
+        }
+    } else {
+        auto &texture = *image.pTexture;
+        // trilinear filtering when minified, texels stay visible when magnified
+        const bool mipmapped = texture.target == GL_TEXTURE_2D;
+
+        auto boundTexture = texture.scope_bind_texture();
+        glTexParameteri(texture.target, GL_TEXTURE_MIN_FILTER, mipmapped ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST);
+        glTexParameteri(texture.target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        renderWithBoundTexture(shaderPool, pMesh, m_Context, OCIOManager.output, OCIOManager.flag_raw, nullptr, mipmapped);
+    }
+}
+
+void DukeMainWindow::renderOffscreen(const Range &frames, glm::ivec2 dimensions, const FrameCallback &onFrame) {
+    // frames in flight between the draw and their copy to memory
+    const size_t readbackDepth = 3;
+    // a frame still not decoded after this delay is rendered without its image
+    const auto decodeTimeout = std::chrono::seconds(10);
+
+    gl::GlRenderbufferObject colorBuffer;
+    {
+        auto boundColorBuffer = colorBuffer.scope_bind();
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, dimensions.x, dimensions.y);
+    }
+    gl::GlFramebufferObject framebuffer;
+    auto boundFramebuffer = framebuffer.scope_bind_framebuffer();
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer.id);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        throw std::runtime_error("unable to create the offscreen framebuffer");
+    glViewport(0, 0, dimensions.x, dimensions.y);
+    PixelReadback readback(dimensions.x, dimensions.y, readbackDepth, onFrame);
+
+    auto &OCIOManager = *m_pOCIOManager;
+    OCIOManager.update(m_GeometryRenderer.shaderPool, true);
+    SharedMesh pSquare = createSquare();
+    auto &textureCache = m_Player.getTextureCache();
+    const auto &timeline = m_Player.getTimeline();
+    m_Context.viewport = Viewport(glm::ivec2(), dimensions);
+
+    for (size_t frame = frames.first; frame <= frames.last; ++frame) {
+        DUKE_TRACE_FRAME(frame, nullptr);
+        // the cache decodes and uploads the next frames while this one is drawn
+        const auto deadline = duke_clock::now() + decodeTimeout;
+        for (bool ready = false; !ready;) {
+            textureCache.prepare(frame, IterationMode::FORWARD);
+            ready = true;
+            for (const Track &track : timeline) {
+                if (track.disabled || track.clipContaining(frame) == track.end()) continue;
+                const MediaFrameReference mfr = track.getMediaFrameReferenceAt(frame);
+                if (mfr.pStream && !textureCache.getLoadedTexture(mfr)) ready = false;
+            }
+            if (ready) break;
+            if (duke_clock::now() > deadline) {
+                std::cerr << "frame " << frame << " is not decoded, rendering it without its image" << std::endl;
+                break;
+            }
+            readback.poll();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        m_Player.cue(frame);
+        m_Context.currentFrame = m_Player.getCurrentFrame();
+        m_Context.playbackTime = m_Player.getPlaybackTime();
+        glClear(GL_COLOR_BUFFER_BIT);
+        gl::RenderState::current().bindTexture(shader::LUT3D_TEXTURE_UNIT, GL_TEXTURE_3D, OCIOManager.m_tex.id);
+        gl::RenderState::current().activeTexture(shader::IMAGE_TEXTURE_UNIT);
+        for (const Track &track : timeline) {
+            if (track.disabled) continue;
+            const auto pTrackItr = track.clipContaining(frame);
+            if (pTrackItr == track.end()) continue;
+            m_Context.pCurrentImage = nullptr;
+            m_Context.pCurrentMediaStream = nullptr;
+            const MediaFrameReference mfr = track.getMediaFrameReferenceAt(frame);
+            const auto pLoadedTexture = mfr.pStream ? textureCache.getLoadedTexture(mfr) : nullptr;
+            if (pLoadedTexture) {
+                m_Context.pCurrentImage = pLoadedTexture;
+                m_Context.pCurrentMediaStream = mfr.pStream;
+                if (m_Context.fitMode != FitMode::FREE) {
+                    m_Context.zoom = getZoomValue(m_Context);
+                    m_Context.pan = glm::ivec2();
+                }
+                drawImage(pSquare.get(), mfr, *pLoadedTexture);
+            }
+            const auto &pOverlayTrack = pTrackItr->second.pOverlay;
+            if (pOverlayTrack) pOverlayTrack->render(m_Context);
+        }
+        readback.read(frame);
+        readback.poll();
+    }
+    readback.poll(true);
+    glViewport(0, 0, m_WindowDim.x, m_WindowDim.y);
+}
+
+void DukeMainWindow::publishMetrics(const StatisticsOverlay &overlay, uint64_t cacheWeight) {
+    auto &textureCache = m_Player.getTextureCache();
+    const auto &imageCache = textureCache.getImageCache();
+    const auto &uploads = textureCache.getStatistics();
+    MetricsSnapshot snapshot;
+    snapshot.add("duke_image_cache_bytes", "Memory used by decoded frames.", MetricType::GAUGE, cacheWeight);
+    snapshot.add("duke_image_cache_capacity_bytes", "Memory available for decoded frames.", MetricType::GAUGE,
+                 imageCache.getMaxWeight());
+    for (const auto &entry : overlay.cacheState) {
+        size_t frames = 0;
+        for (const Range &range : entry.second) frames += range.count();
+        const std::string stream = attribute::getWithDefault<attribute::File>(entry.first->getState());
+        snapshot.add("duke_image_cache_frames", "Decoded frames held in memory per stream.", MetricType::GAUGE,
+                     frames, {{"stream", stream}});
+    }
+    snapshot.add("duke_decode_workers", "Threads reading frames.", MetricType::GAUGE, imageCache.getWorkerCount());
+    snapshot.add("duke_decode_busy_seconds_total", "Time spent reading frames, all workers summed.",
+                 MetricType::COUNTER, imageCache.getBusyMicroseconds() / 1e6);
+    for (const auto &entry : m_DecodeTimesByFormat) {
+        const auto &histogram = entry.second;
+        snapshot.addSummary("duke_decode_seconds", "Time to decode a displayed frame per file format.",
+                            {{"format", entry.first}},
+                            {{0.5, histogram.percentile(50) / 1e6},
+                             {0.95, histogram.percentile(95) / 1e6},
+                             {0.99, histogram.percentile(99) / 1e6}},
+                            histogram.mean() * histogram.count() / 1e6, histogram.count());
+    }
+    snapshot.add("duke_pbo_pool_bytes", "Memory allocated for pixel buffer objects.", MetricType::GAUGE,
+                 textureCache.getPboPoolSize());
+    snapshot.add("duke_texture_pool_textures", "Textures allocated by the texture pools.", MetricType::GAUGE,
+                 textureCache.getTexturePoolCount());
+    snapshot.add("duke_texture_uploads_total", "Frames uploaded to textures.", MetricType::COUNTER, uploads.uploads);
+    snapshot.add("duke_texture_upload_seconds_total", "Time spent submitting texture uploads.", MetricType::COUNTER,
+                 uploads.uploadMicroseconds / 1e6);
+    snapshot.add("duke_refresh_rate_hz", "Screen refreshes per second.", MetricType::GAUGE,
+                 overlay.vBlankMetronom.getFPS());
+    snapshot.add("duke_frame_rate_hz", "Displayed frames per second.", MetricType::GAUGE,
+                 overlay.frameMetronom.getFPS());
+    const Metronom &refresh = overlay.vBlankMetronom;
+    for (const auto &stat : {std::make_pair("min", refresh.getMin()), std::make_pair("mean", refresh.getMean()),
+                             std::make_pair("max", refresh.getMax()), std::make_pair("stddev", refresh.getStdDev())})
+        snapshot.add("duke_refresh_interval_milliseconds", "Time between screen refreshes over the last 100.",
+                     MetricType::GAUGE, stat.second, {{"stat", stat.first}});
+    snapshot.add("duke_frames_displayed_total", "Frames displayed.", MetricType::COUNTER,
+                 m_PlaybackStatistics.displayed);
+    snapshot.add("duke_frames_dropped_total", "Frames skipped to keep up with the frame rate.", MetricType::COUNTER,
+                 m_PlaybackStatistics.dropped);
+    snapshot.add("duke_frames_repeated_total", "Missed refreshes which kept the previous image on screen.",
+                 MetricType::COUNTER, m_PlaybackStatistics.repeated);
+    snapshot.add("duke_frames_not_ready_total", "Refreshes where the current frame was not decoded yet.",
+                 MetricType::COUNTER, m_PlaybackStatistics.notReady);
+    std::ostringstream text;
+    writePrometheus(text, snapshot);
+    m_pMetricsServer->publish(text.str());
+}
+
 void DukeMainWindow::run() {
-    ConsoleIO console;
+    ConsoleIO console([]() { ::glfwPostEmptyEvent(); });
     std::vector<std::string> commands;
     AttributesOverlay metadataOverlay(m_GlyphRenderer);
     OnScreenDisplayOverlay statusOverlay(m_GlyphRenderer);
@@ -208,7 +542,14 @@ void DukeMainWindow::run() {
     SharedMesh pSquare = createSquare();
 
     size_t lastFrame = 0;
+    size_t lastDisplayedFrame = std::numeric_limits<size_t>::max();
+    size_t dueFrame = std::numeric_limits<size_t>::max();
+    auto frameDueTime = duke_clock::now();
+    uint64_t lastUploads = m_Player.getTextureCache().getStatistics().uploads;
+    uint64_t lastUploadMicroseconds = m_Player.getTextureCache().getStatistics().uploadMicroseconds;
     auto milestone = duke_clock::now();
+    uint64_t lastCacheWeight = 0;
+    bool waitingForFrame = false;  // paused on a frame which is not decoded yet
     bool running = true;
 
     const auto keyPressed = [=](int key)->bool {
@@ -243,104 +584,31 @@ void DukeMainWindow::run() {
         m_Context.resetFitMode = false;
     };
 
-//--Handling of ColorSpaces and lutfiles------------------------------------------------------------------  
-   OpenColorIOManager OCIOManager(getColorspaceString(m_Context.screenColorSpace), m_CmdLine.lutFilePath);
- 
-  OCIOManager.SetState();
-  OCIOManager.CreateGPUShaderDesc();
-  OCIOManager.Compute3DLut();
-  OCIOManager.ComputeShader();
-
-//--------------------------------------------------------------------
+    // nothing is displayed yet, the first color pipeline is worth waiting for
+    auto &OCIOManager = *m_pOCIOManager;
+    OCIOManager.update(m_GeometryRenderer.shaderPool, true);
+
+    // images are presented every swapinterval refreshes, playback advances by whole presentation periods
+    const unsigned swapInterval = m_CmdLine.swapBufferInterval;
+    FramePacer pacer(getMonitorRefreshPeriod(m_pWindow) * Time::int_type(swapInterval));
+    const SyncControl syncControl(m_pWindow);
+    int32_t rateNumerator = 0;
+    int32_t rateDenominator = 0;
+    if (syncControl.getRefreshRate(rateNumerator, rateDenominator))
+        pacer.setRefreshPeriod(Time(Time::int_type(rateDenominator) * swapInterval, rateNumerator));
+    int64_t lastCounter = 0;
+    const bool useCounter = swapInterval > 0 && syncControl.getCounter(lastCounter);
 
     while (running) {
-        // fetching user inputs
-        ::glfwPollEvents();
-
-        // setting up context
-        m_Context.viewport = Viewport(glm::ivec2(), m_WindowDim);
-        m_Context.currentFrame = m_Player.getCurrentFrame();
-        m_Context.playbackTime = m_Player.getPlaybackTime();
-
-        // current frame
-        const size_t frame = m_Context.currentFrame.round();
-
-        // preparing current frame textures
-        auto &textureCache = m_Player.getTextureCache();
-        const auto speed = m_Player.getPlaybackSpeed();
-        const auto mode =
-            speed < 0 ? IterationMode::BACKWARD : (speed > 0 ? IterationMode::FORWARD : IterationMode::PINGPONG);
-        textureCache.prepare(frame, mode);
-
-        // rendering tracks
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        for (const Track &track : m_Player.getTimeline()) {
-            if (track.disabled) continue;
-
-            const auto pTrackItr = track.clipContaining(frame);
-            if (pTrackItr == track.end()) continue;
-
-            m_Context.pCurrentImage = nullptr;
-            m_Context.pCurrentMediaStream = nullptr;
-            const MediaFrameReference mfr = track.getMediaFrameReferenceAt(frame);
-            const auto pMediaStream = mfr.pStream;
-
-      glActiveTexture(GL_TEXTURE2);
-      auto bound3dTexture = OCIOManager.m_tex.scope_bind_texture();
-      glActiveTexture(GL_TEXTURE0);
-
-            if (pMediaStream) { 
-                auto pLoadedTexture = textureCache.getLoadedTexture(mfr);
-      
-                // Mode where we force the texture to be ready before displaying something
-                if (m_CmdLine.unlimitedFPS) { 
-                    int MaxTry = 1000;
-                    while (!pLoadedTexture) { 
-                        // The texture was not ready, re-ask for it
-                        textureCache.prepare(frame, mode);
-                        pLoadedTexture = textureCache.getLoadedTexture(mfr);
-                        if (MaxTry-- <= 0) continue;
-                    }
-                }
-                if (pLoadedTexture) { 
-                    m_Context.pCurrentImage = pLoadedTexture;
-                    m_Context.pCurrentMediaStream = pMediaStream;
-                    setupZoom();
-		   
-                    auto &texture = *pLoadedTexture->pTexture;
-		    
-                    auto boundTexture = texture.scope_bind_texture();
-                    glTexParameteri(texture.target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-                    glTexParameteri(texture.target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		   
-		    renderWithBoundTexture(m_GlyphRenderer.getGeometryRenderer().shaderPool, pSquare.get(), m_Context, OCIOManager.output, OCIOManager.flag_raw);
-		     
-                } else {
-                    drawText(m_GlyphRenderer, m_Context.viewport, "caching", 100, 100, 1, 3);
-                }
-            }
-            const auto &pOverlayTrack = pTrackItr->second.pOverlay;
-            if (pOverlayTrack) pOverlayTrack->render(m_Context);
-            if (showMetadataOverlay) metadataOverlay.render(m_Context);
-        }
-	 
-        if (showStatisticOverlay) statisticOverlay.render(m_Context);
-        statusOverlay.render(m_Context);
-
-        // displaying
-        ::glfwSwapBuffers(m_pWindow);
-
-        // updating time
-        const auto elapsedMicroSeconds = statisticOverlay.vBlankMetronom.tick();
-        const Time offset = m_CmdLine.unlimitedFPS ? m_Player.getFrameDuration() : Time(elapsedMicroSeconds);
-        m_Player.offsetPlaybackTime(offset);
-
-        m_Context.liveTime += Time(elapsedMicroSeconds.count(), 1000000);
-
-        if (frame != lastFrame) {
-            statisticOverlay.frameMetronom.tick();
-            lastFrame = frame;
-        }
+        // fetching user inputs, sleeping until something happens when the
+        // screen is up to date. Console input, the color pipeline and the
+        // thumbnails wake us up, a frame still loading is polled every 10 ms.
+        const bool animating = m_Player.getPlaybackSpeed() != 0 || statusOverlay.isVisible(m_Context.liveTime);
+        const bool waiting = !animating && !m_Dirty;
+        if (waiting)
+            ::glfwWaitEventsTimeout(waitingForFrame || OCIOManager.isPending() ? 0.01 : 0.1);
+        else
+            ::glfwPollEvents();
 
         // handling input by char
         for (const int key : m_CharStrokes) {
@@ -380,6 +648,9 @@ void DukeMainWindow::run() {
             case 's':
                 showStatisticOverlay = !showStatisticOverlay;
                 break;
+            case 'c':
+                commands.emplace_back("contactsheet");
+                break;
             case 'f':
                 setNextMode(m_Context.fitMode);
                 m_Context.resetFitMode = true;
@@ -416,23 +687,197 @@ void DukeMainWindow::run() {
 
         // checking incoming commands
         console.poll(commands);
+        if (!commands.empty()) m_Dirty = true;
         for (const auto &cmd : commands) {
             auto result = m_Commands.execute(cmd);
             if (!result.empty()) std::cout << result << std::endl;
         }
         commands.clear();
 
+        // swapping a new color pipeline in, once its programs are built
+        if (OCIOManager.update(m_GeometryRenderer.shaderPool)) m_Dirty = true;
+
+        // uploading the thumbnails produced since the last refresh
+        if (updateContactSheet() && m_ShowContactSheet) m_Dirty = true;
+
         // check stop
         running = !(shouldClose() || (keyPressed(GLFW_KEY_ESCAPE)));
+        if (m_ExitWhenStopped && m_Player.getPlaybackSpeed() == 0) running = false;
 
-        // dumping cache state every 200 ms
+        // dumping cache state every 100 ms
+        auto &textureCache = m_Player.getTextureCache();
         const auto now = duke_clock::now();
         if ((now - milestone) > std::chrono::milliseconds(100)) {
-            textureCache.getImageCache().dumpState(statisticOverlay.cacheState);
+            const auto cacheWeight = textureCache.getImageCache().dumpState(statisticOverlay.cacheState);
+            // the cache state is displayed while paused too
+            if (showStatisticOverlay && cacheWeight != lastCacheWeight) m_Dirty = true;
+            lastCacheWeight = cacheWeight;
             statisticOverlay.vBlankMetronom.compute();
             statisticOverlay.frameMetronom.compute();
+            if (m_pMetricsServer) publishMetrics(statisticOverlay, cacheWeight);
             milestone = now;
         }
+
+        if (!running) break;
+        if (!animating && !m_Dirty && !waitingForFrame) continue;
+        m_Dirty = false;
+        waitingForFrame = false;
+        if (waiting) {
+            // the idle time must not move playback forward
+            statisticOverlay.vBlankMetronom.restart();
+            if (useCounter) syncControl.getCounter(lastCounter);
+        }
+
+        // setting up context
+        m_Context.viewport = Viewport(glm::ivec2(), m_WindowDim);
+        m_Context.currentFrame = m_Player.getCurrentFrame();
+        m_Context.playbackTime = m_Player.getPlaybackTime();
+
+        // current frame
+        const size_t frame = m_Context.currentFrame.round();
+        DUKE_TRACE_FRAME(frame, nullptr);
+        if (frame != dueFrame) {
+            dueFrame = frame;
+            frameDueTime = duke_clock::now();
+        }
+        bool newFrameDisplayed = false;
+
+        // preparing current frame textures
+        const auto speed = m_Player.getPlaybackSpeed();
+        const auto mode =
+            speed < 0 ? IterationMode::BACKWARD : (speed > 0 ? IterationMode::FORWARD : IterationMode::PINGPONG);
+        // full resolution is fetched when paused or zoomed in
+        const uint8_t proxyLevel = m_ProxyDecode && speed != 0 ? getProxyLevel(m_Context.zoom) : 0;
+        // the whole image is fetched when paused, the region is based on the last displayed image
+        const Region region = m_RegionDecode && speed != 0 ? getVisibleRegion(m_Context) : Region();
+        {
+            DUKE_TRACE_SCOPE("prepare");
+            textureCache.prepare(frame, mode, proxyLevel, region);
+        }
+        const auto &cacheStatistics = textureCache.getStatistics();
+        if (cacheStatistics.uploads > lastUploads) {
+            const auto uploads = cacheStatistics.uploads - lastUploads;
+            statisticOverlay.uploadTimes.record((cacheStatistics.uploadMicroseconds - lastUploadMicroseconds) / uploads);
+            lastUploads = cacheStatistics.uploads;
+            lastUploadMicroseconds = cacheStatistics.uploadMicroseconds;
+        }
+
+        // rendering tracks
+        StopWatch renderWatch;
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        // the lut keeps its own texture unit, this is a no-op unless it was re-uploaded
+        gl::RenderState::current().bindTexture(shader::LUT3D_TEXTURE_UNIT, GL_TEXTURE_3D, OCIOManager.m_tex.id);
+        gl::RenderState::current().activeTexture(shader::IMAGE_TEXTURE_UNIT);
+        for (const Track &track : m_Player.getTimeline()) {
+            if (track.disabled || m_ShowContactSheet) continue;
+
+            const auto pTrackItr = track.clipContaining(frame);
+            if (pTrackItr == track.end()) continue;
+
+            m_Context.pCurrentImage = nullptr;
+            m_Context.pCurrentMediaStream = nullptr;
+            const MediaFrameReference mfr = track.getMediaFrameReferenceAt(frame);
+            const auto pMediaStream = mfr.pStream;
+
+            if (pMediaStream) { 
+                auto pLoadedTexture = textureCache.getLoadedTexture(mfr);
+      
+                // Mode where we force the texture to be ready before displaying something
+                if (m_CmdLine.unlimitedFPS) { 
+                    int MaxTry = 1000;
+                    while (!pLoadedTexture) { 
+                        // The texture was not ready, re-ask for it
+                        textureCache.prepare(frame, mode, proxyLevel, region);
+                        pLoadedTexture = textureCache.getLoadedTexture(mfr);
+                        if (MaxTry-- <= 0) continue;
+                    }
+                }
+                if (pLoadedTexture && frame != lastDisplayedFrame) {
+                    using namespace attribute;
+                    auto &statistics = m_PlaybackStatistics;
+                    const bool skipped = lastDisplayedFrame != std::numeric_limits<size_t>::max() && frame > lastDisplayedFrame + 1;
+                    if (skipped) statistics.dropped += frame - lastDisplayedFrame - 1;
+                    if (skipped && speed != 0) statisticOverlay.droppedFrames += frame - lastDisplayedFrame - 1;
+                    ++statistics.displayed;
+                    const auto decodeMicroseconds = getWithDefault<DecodeTime>(pLoadedTexture->attributes);
+                    statistics.ioMicroseconds += getWithDefault<IoTime>(pLoadedTexture->attributes);
+                    statistics.decodeMicroseconds += decodeMicroseconds;
+                    statisticOverlay.decodeTimes.record(decodeMicroseconds);
+                    if (m_pMetricsServer) {
+                        const char *pExtension = fileExtension(getWithDefault<File>(pLoadedTexture->attributes));
+                        m_DecodeTimesByFormat[pExtension ? pExtension : ""].record(decodeMicroseconds);
+                    }
+                    lastDisplayedFrame = frame;
+                    newFrameDisplayed = true;
+                } else if (!pLoadedTexture) {
+                    ++m_PlaybackStatistics.notReady;
+                    if (speed != 0) ++statisticOverlay.lateRefreshes;
+                }
+                if (pLoadedTexture) { 
+                    m_Context.pCurrentImage = pLoadedTexture;
+                    m_Context.pCurrentMediaStream = pMediaStream;
+                    setupZoom();
+		   
+                    drawImage(pSquare.get(), mfr, *pLoadedTexture);
+		     
+                } else {
+                    drawText(m_GlyphRenderer, m_Context.viewport, "caching", 100, 100, 1, 3);
+                    waitingForFrame = true;
+                }
+            }
+            const auto &pOverlayTrack = pTrackItr->second.pOverlay;
+            if (pOverlayTrack) pOverlayTrack->render(m_Context);
+            if (showMetadataOverlay) metadataOverlay.render(m_Context);
+        }
+	 
+        if (m_ShowContactSheet) m_pContactSheet->render(m_Context);
+        if (showStatisticOverlay) statisticOverlay.render(m_Context);
+        statusOverlay.render(m_Context);
+        statisticOverlay.renderTimes.record(renderWatch.elapsedMicroSeconds().count());
+
+        // displaying
+        {
+            DUKE_TRACE_SCOPE("swap buffers");
+            ::glfwSwapBuffers(m_pWindow);
+        }
+        if (newFrameDisplayed) {
+            const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(duke_clock::now() - frameDueTime);
+            statisticOverlay.displayLatencies.record(latency.count());
+        }
+        if (m_ResetStatistics) {
+            statisticOverlay.resetStatistics();
+            m_ResetStatistics = false;
+        }
+
+        // updating time
+        const auto elapsedMicroSeconds = statisticOverlay.vBlankMetronom.tick();
+        Time offset(elapsedMicroSeconds);  // no vsync to lock on
+        if (m_CmdLine.unlimitedFPS) {
+            offset = m_Player.getFrameDuration();
+        } else if (swapInterval > 0) {
+            // the refresh counter is exact, the clock is used otherwise
+            uint64_t refreshes = 0;
+            int64_t counter = 0;
+            if (useCounter && syncControl.getCounter(counter)) {
+                refreshes = std::max<int64_t>(1, (counter - lastCounter + swapInterval / 2) / swapInterval);
+                lastCounter = counter;
+            } else {
+                refreshes = pacer.countRefreshes(elapsedMicroSeconds);
+            }
+            if (speed != 0 && refreshes > 1) {
+                statisticOverlay.repeatedRefreshes += refreshes - 1;
+                m_PlaybackStatistics.repeated += refreshes - 1;
+            }
+            offset = pacer.advance(refreshes);
+        }
+        m_Player.offsetPlaybackTime(offset);
+
+        m_Context.liveTime += Time(elapsedMicroSeconds.count(), 1000000);
+
+        if (frame != lastFrame) {
+            statisticOverlay.frameMetronom.tick();
+            lastFrame = frame;
+        }
     }
 }
 
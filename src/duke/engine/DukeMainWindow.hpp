@@ -10,17 +10,56 @@
 #include <duke/engine/rendering/GeometryRenderer.hpp>
 #include <duke/engine/rendering/GlyphRenderer.hpp>
 #include <duke/gl/GlFwApp.hpp>
+#include <duke/metrics/MetricsServer.hpp>
+#include <duke/time/LatencyHistogram.hpp>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
 
 namespace duke {
 
+class StatisticsOverlay;
+class ContactSheetOverlay;
+class ThumbnailEngine;
+class OpenColorIOManager;
+class Mesh;
+
 class DukeMainWindow : public DukeGLFWWindow {
 public:
     DukeMainWindow(GLFWwindow *pWindow, const CmdLineParameters &parameters);
+    ~DukeMainWindow();
 
     void load(const Timeline &timeline, const FrameDuration &frameDuration, const FitMode fitMode, int speed);
     void run();
 
+    // Counters gathered while playing, reported by the playback benchmark.
+    struct PlaybackStatistics {
+        size_t displayed = 0;
+        size_t dropped = 0;   // frames skipped to keep up with the frame rate
+        size_t repeated = 0;  // missed refreshes which kept the previous image on screen
+        size_t notReady = 0;  // refreshes where the current frame was not decoded yet
+        uint64_t ioMicroseconds = 0;
+        uint64_t decodeMicroseconds = 0;
+        uint64_t uploads = 0;
+        uint64_t uploadMicroseconds = 0;
+        std::chrono::microseconds elapsed;
+    };
+    // Plays the loaded timeline once at nominal speed and returns when it stops.
+    PlaybackStatistics benchmarkPlayback();
+
+    // Receives a rendered frame as BGRA 8 bits rows, bottom to top.
+    typedef std::function<void(size_t frame, const char *pData, size_t dataSize)> FrameCallback;
+    // Renders frames of the loaded timeline with the color pipeline and the
+    // overlay tracks into an offscreen framebuffer of the given dimensions.
+    // Decoding, drawing and reading back overlap over several frames.
+    void renderOffscreen(const Range &frames, glm::ivec2 dimensions, const FrameCallback &onFrame);
+
 private:
+    // Input callbacks and console commands.
+    void setupInteraction();
     void onKey(int key, int action);
     void onChar(unsigned int unicodeCodePoint);
     void onWindowResize(int width, int height);
@@ -30,6 +69,10 @@ private:
     void onScroll(double x, double y);
 
     bool togglePlayStop();
+    void toggleContactSheet();
+    bool updateContactSheet();
+    void drawImage(const Mesh *pMesh, const MediaFrameReference &mfr, const TexturePackedFrame &image);
+    void publishMetrics(const StatisticsOverlay &overlay, uint64_t cacheWeight);
 
     glm::ivec2 m_MousePos;
     glm::ivec2 m_WindowDim;
@@ -37,12 +80,27 @@ private:
     std::vector<unsigned int> m_CharStrokes;
     std::vector<int> m_KeyStrokes;
     bool m_MouseLeftDown = false;
+    bool m_ProxyDecode;
+    bool m_RegionDecode;
+    bool m_ExitWhenStopped = false;
+    bool m_ResetStatistics = false;
+    bool m_Dirty = true;  // the screen must be redrawn even if playback is paused
+    PlaybackStatistics m_PlaybackStatistics;
+    std::unique_ptr<MetricsServer> m_pMetricsServer;
+    std::map<std::string, LatencyHistogram> m_DecodeTimesByFormat;  // only filled when serving metrics
 
     const CmdLineParameters &m_CmdLine;
     Player m_Player;
     GeometryRenderer m_GeometryRenderer;
     GlyphRenderer m_GlyphRenderer;
     Context m_Context;
+    std::unique_ptr<OpenColorIOManager> m_pOCIOManager;
+    std::string m_OCIOColorSpace;
+    std::string m_OCIOLutFile;
+    std::unique_ptr<ThumbnailEngine> m_pThumbnailEngine;
+    std::unique_ptr<ContactSheetOverlay> m_pContactSheet;
+    std::vector<size_t> m_ContactSheetFrames;  // first frame of each cell's clip
+    bool m_ShowContactSheet = false;
 
     cmd::Commands m_Commands;
     Parameters m_Parameters;
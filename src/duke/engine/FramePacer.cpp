@@ -0,0 +1,55 @@
+#include "FramePacer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace duke {
+
+namespace {
+
+const uint32_t kEstimationSamples = 120;
+
+// Refresh rates in Hz as numerator / denominator.
+const int64_t kStandardRates[][2] = {{24000, 1001}, {24, 1},  {25, 1},  {30000, 1001}, {30, 1},
+                                     {48, 1},       {50, 1},  {60000, 1001}, {60, 1},  {72, 1},
+                                     {75, 1},       {85, 1},  {90, 1},  {100, 1},      {120000, 1001},
+                                     {120, 1},      {144, 1}, {165, 1}, {240, 1}};
+
+}  // namespace
+
+FramePacer::FramePacer(const Time& refreshPeriod) : m_RefreshPeriod(refreshPeriod) {}
+
+void FramePacer::setRefreshPeriod(const Time& period) {
+  m_RefreshPeriod = period;
+  m_Exact = true;
+}
+
+uint64_t FramePacer::countRefreshes(std::chrono::microseconds interval) {
+  const double period = m_RefreshPeriod.asDouble() * std::micro::den;
+  const int64_t refreshes = std::max<int64_t>(1, std::llround(interval.count() / period));
+  // intervals far from a whole number of periods are not used for the estimate
+  const bool onTime = refreshes == 1 && std::abs(interval.count() - period) < period / 4;
+  if (!m_Exact && onTime) {
+    m_IntervalSum += interval.count();
+    if (++m_IntervalCount == kEstimationSamples) {
+      // whole microseconds keep the playback time denominator small when not snapped
+      const int64_t mean = std::llround(double(m_IntervalSum) / kEstimationSamples);
+      m_RefreshPeriod = snapToStandardRate(Time(mean, std::micro::den));
+      m_IntervalSum = 0;
+      m_IntervalCount = 0;
+    }
+  }
+  return refreshes;
+}
+
+Time FramePacer::snapToStandardRate(const Time& period) {
+  const double rate = 1 / period.asDouble();
+  for (const auto& standard : kStandardRates) {
+    const double standardRate = double(standard[0]) / standard[1];
+    if (std::abs(rate - standardRate) / standardRate < 500e-6) return Time(standard[1], standard[0]);
+  }
+  return period;
+}
+
+} /* namespace duke */
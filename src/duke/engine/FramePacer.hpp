@@ -0,0 +1,47 @@
+#pragma once
+
+#include <duke/time/FrameUtils.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+namespace duke {
+
+/**
+ * Decides how much playback time elapses between two presented images.
+ * Playback advances by whole refresh periods so the frame displayed at each
+ * refresh only depends on the refresh count: 24 fps on a 60 Hz screen gives
+ * a steady 3:2 cadence instead of following the jitter of the clock.
+ *
+ * The refresh period is either given exactly, eg. by GLX_OML_sync_control,
+ * or estimated from the measured presentation intervals and snapped to the
+ * closest standard rate.
+ */
+class FramePacer {
+ public:
+  FramePacer(const Time& refreshPeriod);
+
+  // Exact refresh period, estimation is disabled.
+  void setRefreshPeriod(const Time& period);
+  const Time& getRefreshPeriod() const { return m_RefreshPeriod; }
+
+  // Refreshes elapsed during a measured presentation interval, at least one.
+  // On time presentations refine the period estimate.
+  uint64_t countRefreshes(std::chrono::microseconds interval);
+
+  // Playback time to add after presenting. Refreshes beyond the first one
+  // kept the previous image on screen, they are repeats.
+  Time advance(uint64_t refreshes) const { return m_RefreshPeriod * Time::int_type(refreshes); }
+
+  // Standard refresh rate closest to the period if within 500 ppm, the period otherwise.
+  static Time snapToStandardRate(const Time& period);
+
+ private:
+  Time m_RefreshPeriod;
+  bool m_Exact = false;
+  // on time intervals since the last estimate
+  int64_t m_IntervalSum = 0;
+  uint32_t m_IntervalCount = 0;
+};
+
+} /* namespace duke */
@@ -8,6 +8,8 @@
 #include <duke/image/FrameDescription.hpp>
 #include <duke/imageio/DukeIO.hpp>
 #include <duke/memory/Allocator.hpp>
+#include <duke/time/Clock.hpp>
+#include <duke/time/Trace.hpp>
 
 #include <sstream>
 
@@ -28,15 +30,25 @@ ReadFrameResult error(const std::string& error, ReadFrameResult& result) {
 ReadFrameResult tryReader(const char* filename, const IIODescriptor* pDescriptor,
                           const attribute::Attributes& readOptions, const LoadCallback& callback,
                           ReadFrameResult&& result) {
+  // mapped pages are only read when decoding, the file outlives the reader
+  std::unique_ptr<MemoryMappedFile> pFile;
   std::unique_ptr<IImageReader> pReader;
-  if (pDescriptor->supports(IIODescriptor::Capability::READER_READ_FROM_MEMORY)) {
-    MemoryMappedFile file(filename);
-    if (!file) return error("unable to map file to memory", result);
-    pReader.reset(pDescriptor->getReaderFromMemory(readOptions, file.pFileData, file.fileSize));
-  } else {
-    pReader.reset(pDescriptor->getReaderFromFile(readOptions, filename));
+  StopWatch watch;
+  {
+    DUKE_TRACE_SCOPE("read file");
+    if (pDescriptor->supports(IIODescriptor::Capability::READER_READ_FROM_MEMORY)) {
+      pFile.reset(new MemoryMappedFile(filename));
+      if (!*pFile) return error("unable to map file to memory", result);
+      pReader.reset(pDescriptor->getReaderFromMemory(readOptions, pFile->pFileData, pFile->fileSize));
+    } else {
+      pReader.reset(pDescriptor->getReaderFromFile(readOptions, filename));
+    }
   }
-  return loadImage(pReader.get(), callback, move(result));
+  attribute::set<attribute::IoTime>(result.attributes(), watch.elapsedMicroSeconds().count());
+  DUKE_TRACE_SCOPE("decode");
+  result = loadImage(pReader.get(), callback, move(result));
+  attribute::set<attribute::DecodeTime>(result.attributes(), watch.elapsedMicroSeconds().count());
+  return move(result);
 }
 
 ReadFrameResult load(const char* pFilename, const char* pExtension, const attribute::Attributes& readOptions,
@@ -50,6 +62,37 @@ ReadFrameResult load(const char* pFilename, const char* pExtension, const attrib
   return error("no reader succeeded, last message was : '" + result.error + "'", result);
 }
 
+bool takeHeader(IImageReader* pReader, ReadFrameResult& result) {
+  if (!pReader) {
+    result.error = "reader can't open files";
+    return false;
+  }
+  if (pReader->hasError()) {
+    result.error = pReader->getError();
+    return false;
+  }
+  result.readerAttributes = pReader->moveAttributes();
+  result.status = IOResult::SUCCESS;
+  return true;
+}
+
+bool tryHeader(const char* filename, const IIODescriptor* pDescriptor, const attribute::Attributes& readOptions,
+               ReadFrameResult& result) {
+  std::unique_ptr<IImageReader> pReader;
+  if (pDescriptor->supports(IIODescriptor::Capability::READER_READ_FROM_MEMORY)) {
+    // only the pages holding the header are read
+    MemoryMappedFile file(filename);
+    if (!file) {
+      result.error = "unable to map file to memory";
+      return false;
+    }
+    pReader.reset(pDescriptor->getReaderFromMemory(readOptions, file.pFileData, file.fileSize));
+    return takeHeader(pReader.get(), result);
+  }
+  pReader.reset(pDescriptor->getReaderFromFile(readOptions, filename));
+  return takeHeader(pReader.get(), result);
+}
+
 }  // namespace
 
 ReadFrameResult loadImage(IImageReader* pReader, const LoadCallback& callback, ReadFrameResult&& result) {
@@ -79,6 +122,18 @@ ReadFrameResult load(const attribute::Attributes& readOptions, const LoadCallbac
   return load(pFilename, pExtension, readOptions, callback, move(result));
 }
 
+ReadFrameResult loadHeader(const attribute::Attributes& readOptions, const char* pFilename) {
+  DUKE_TRACE_SCOPE("read header");
+  ReadFrameResult result;
+  const char* pExtension = fileExtension(pFilename);
+  if (!pExtension) return error("no extension", result);
+  const auto& descriptors = IODescriptors::instance().findDescriptor(pExtension);
+  if (descriptors.empty()) return error("no reader available", result);
+  for (const IIODescriptor* pDescriptor : descriptors)
+    if (tryHeader(pFilename, pDescriptor, readOptions, result)) return move(result);
+  return error("no reader succeeded, last message was : '" + result.error + "'", result);
+}
+
 ReadFrameResult load(const char* pFilename, Texture& texture) {
   CHECK(pFilename);
   ReadFrameResult result;
@@ -19,6 +19,11 @@ ReadFrameResult loadImage(IImageReader* pRawReader, const LoadCallback& callback
 
 ReadFrameResult load(const attribute::Attributes& options, const LoadCallback& callback, ReadFrameResult&& result);
 
+// Opens the file with the first reader accepting it and returns the reader
+// attributes in readerAttributes. Readers parse the header when constructed,
+// the image is not decoded.
+ReadFrameResult loadHeader(const attribute::Attributes& options, const char* pFilename);
+
 struct Texture;
 ReadFrameResult load(const char* pFilename, Texture& texture);
 
@@ -0,0 +1,105 @@
+#include "SequenceWriter.hpp"
+
+#include <duke/filesystem/FsUtils.hpp>
+#include <duke/imageio/DukeIO.hpp>
+#include <duke/time/Trace.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+namespace duke {
+
+void writeImage(const std::string& filename, const FrameData& frame) {
+  DUKE_TRACE_SCOPE("write file");
+  const char* pExtension = fileExtension(filename.c_str());
+  if (!pExtension) throw std::runtime_error("no extension to pick a writer for " + filename);
+  const IIODescriptor* pDescriptor = IODescriptors::instance().findWriterDescriptor(pExtension);
+  if (!pDescriptor) throw std::runtime_error(std::string("no writer available for '") + pExtension + "' files");
+  std::unique_ptr<IImageWriter> pWriter(pDescriptor->getWriterToFile(frame.attributes, filename.c_str()));
+  if (!pWriter) throw std::runtime_error("unable to create a writer for " + filename);
+  if (pWriter->setup(frame)) pWriter->writeImageData(frame.pData.get());
+  if (pWriter->hasError()) throw std::runtime_error("unable to write " + filename + " : " + pWriter->getError());
+}
+
+namespace {
+
+unsigned getThreadCount(unsigned threads) { return threads ? threads : std::max(1u, std::thread::hardware_concurrency()); }
+
+}  // namespace
+
+SequenceWriter::SequenceWriter(unsigned threads, size_t maxPending, WriteFunction write)
+    : m_Write(write), m_MaxPending(maxPending ? maxPending : 2 * getThreadCount(threads)) {
+  for (unsigned i = 0; i < getThreadCount(threads); ++i) m_Workers.emplace_back(&SequenceWriter::workerFunction, this);
+}
+
+SequenceWriter::~SequenceWriter() {
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_JobDone.wait(lock, [this] { return m_Jobs.empty() && m_Running == 0; });
+    m_Stop = true;
+  }
+  m_JobAvailable.notify_all();
+  for (auto& worker : m_Workers) worker.join();
+}
+
+void SequenceWriter::push(std::string filename, FrameData frame) {
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_JobDone.wait(lock, [this] { return m_Jobs.size() < m_MaxPending || m_pError; });
+    rethrowError();
+    m_Jobs.push_back(Job{std::move(filename), std::move(frame)});
+  }
+  m_JobAvailable.notify_one();
+}
+
+void SequenceWriter::finish() {
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_JobDone.wait(lock, [this] { return m_Jobs.empty() && m_Running == 0; });
+  rethrowError();
+}
+
+size_t SequenceWriter::getWrittenCount() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Written;
+}
+
+void SequenceWriter::rethrowError() {
+  if (!m_pError) return;
+  auto pError = m_pError;
+  m_pError = nullptr;
+  std::rethrow_exception(pError);
+}
+
+void SequenceWriter::workerFunction() {
+  for (;;) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_JobAvailable.wait(lock, [this] { return m_Stop || !m_Jobs.empty(); });
+      if (m_Jobs.empty()) return;
+      job = std::move(m_Jobs.front());
+      m_Jobs.pop_front();
+      ++m_Running;
+    }
+    std::exception_ptr pError;
+    try {
+      m_Write(job.filename, job.frame);
+    } catch (...) {
+      pError = std::current_exception();
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      --m_Running;
+      if (pError) {
+        if (!m_pError) m_pError = pError;
+        m_Jobs.clear();
+      } else {
+        ++m_Written;
+      }
+    }
+    m_JobDone.notify_all();
+  }
+}
+
+} /* namespace duke */
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <duke/base/NonCopyable.hpp>
+#include <duke/image/FrameData.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace duke {
+
+// Writes the frame with the first plugin able to write the filename
+// extension, throws a std::runtime_error if none succeeds.
+void writeImage(const std::string& filename, const FrameData& frame);
+
+/**
+ * Encodes and writes frames on a pool of threads.
+ * - frames are written in parallel and out of order, each by its own
+ *   writer instance.
+ * - push() blocks while maxPending frames wait for a thread, bounding the
+ *   memory held by the queue.
+ * - the first failure is rethrown by the next push() or by finish(), the
+ *   frames still queued at that time are dropped.
+ */
+class SequenceWriter : public noncopyable {
+ public:
+  typedef std::function<void(const std::string& filename, const FrameData& frame)> WriteFunction;
+
+  // 0 threads uses the hardware concurrency, 0 maxPending twice the threads.
+  SequenceWriter(unsigned threads = 0, size_t maxPending = 0, WriteFunction write = &writeImage);
+  // Waits for the queued frames, errors are ignored.
+  ~SequenceWriter();
+
+  void push(std::string filename, FrameData frame);
+  // Waits for all the frames to be written.
+  void finish();
+
+  size_t getWrittenCount() const;
+
+ private:
+  struct Job {
+    std::string filename;
+    FrameData frame;
+  };
+  void workerFunction();
+  void rethrowError();
+
+  const WriteFunction m_Write;
+  const size_t m_MaxPending;
+  mutable std::mutex m_Mutex;
+  std::condition_variable m_JobAvailable;
+  std::condition_variable m_JobDone;
+  std::deque<Job> m_Jobs;
+  size_t m_Running = 0;
+  size_t m_Written = 0;
+  bool m_Stop = false;
+  std::exception_ptr m_pError;
+  std::vector<std::thread> m_Workers;
+};
+
+} /* namespace duke */
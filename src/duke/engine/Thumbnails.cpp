@@ -0,0 +1,231 @@
+#include "Thumbnails.hpp"
+
+#include <duke/attributes/AttributeKeys.hpp>
+#include <duke/base/ParallelFor.hpp>
+#include <duke/engine/streams/IMediaStream.hpp>
+#include <duke/engine/streams/MediaFrameReference.hpp>
+#include <duke/filesystem/FsUtils.hpp>
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace duke {
+
+namespace {
+
+const char kMagic[4] = {'D', 'K', 'T', 'H'};
+const uint32_t kMaxDimension = 4096;
+
+void fnv1a(uint64_t &hash, const void *pData, size_t size) {
+  const unsigned char *pBytes = static_cast<const unsigned char *>(pData);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= pBytes[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+// The source pixels covered by a destination pixel, never empty.
+inline void getSpan(size_t index, size_t sourceSize, size_t size, size_t &begin, size_t &end) {
+  begin = index * sourceSize / size;
+  end = std::max(begin + 1, (index + 1) * sourceSize / size);
+}
+
+inline uint8_t quantize(float value) { return uint8_t(std::min(std::max(value, 0.f), 1.f) * 255.f + .5f); }
+
+}  // namespace
+
+void downscale(const RgbaImage &source, size_t width, size_t height, RgbaImage &destination, unsigned threads) {
+  if (width == 0 || height == 0 || width > source.width || height > source.height)
+    throw std::invalid_argument("downscale can only shrink a non empty image");
+  destination.width = width;
+  destination.height = height;
+  destination.pixels.assign(width * height * 4, 0.f);
+  parallelFor(height, threads, [&](size_t begin, size_t end) {
+    for (size_t y = begin; y < end; ++y) {
+      size_t y0, y1;
+      getSpan(y, source.height, height, y0, y1);
+      float *pDestination = destination.row(y);
+      for (size_t x = 0; x < width; ++x, pDestination += 4) {
+        size_t x0, x1;
+        getSpan(x, source.width, width, x0, x1);
+        for (size_t sy = y0; sy < y1; ++sy) {
+          const float *pSource = source.row(sy) + x0 * 4;
+          for (size_t sx = x0; sx < x1; ++sx, pSource += 4)
+            for (size_t c = 0; c < 4; ++c) pDestination[c] += pSource[c];
+        }
+        const float weight = 1.f / ((y1 - y0) * (x1 - x0));
+        for (size_t c = 0; c < 4; ++c) pDestination[c] *= weight;
+      }
+    }
+  });
+}
+
+Thumbnail createThumbnail(const FrameData &frame, ColorSpace colorspace, size_t maxSize, unsigned threads) {
+  RgbaImage image;
+  decodeToLinear(frame, colorspace, image, threads);
+  if (image.width == 0 || image.height == 0) throw std::runtime_error("empty image");
+  // averaging in linear light, filtering encoded values darkens the details
+  const float scale = std::min(1.f, float(maxSize) / std::max(image.width, image.height));
+  const size_t width = std::max<size_t>(1, std::lround(image.width * scale));
+  const size_t height = std::max<size_t>(1, std::lround(image.height * scale));
+  if (width != image.width || height != image.height) {
+    RgbaImage scaled;
+    downscale(image, width, height, scaled, threads);
+    image = std::move(scaled);
+  }
+  fromLinear(ColorSpace::sRGB, image.pixels.data(), image.pixels.size());
+
+  const bool bottomUp = attribute::getWithDefault<attribute::DpxImageOrientation>(frame.attributes) == 4;
+  Thumbnail thumbnail;
+  thumbnail.width = width;
+  thumbnail.height = height;
+  thumbnail.pixels.resize(width * height * 3);
+  for (size_t y = 0; y < height; ++y) {
+    const float *pSource = image.row(bottomUp ? height - 1 - y : y);
+    uint8_t *pDestination = thumbnail.pixels.data() + y * width * 3;
+    for (size_t x = 0; x < width; ++x, pSource += 4)
+      for (size_t c = 0; c < 3; ++c) *pDestination++ = quantize(pSource[c]);
+  }
+  return thumbnail;
+}
+
+ThumbnailCache::ThumbnailCache(const std::string &directory) {
+  if (createDirectories(directory)) m_Directory = directory;
+}
+
+std::string ThumbnailCache::getDefaultDirectory() {
+  const std::string cache = getUserCacheDirectory();
+  return cache.empty() ? cache : cache + "/duke/thumbnails";
+}
+
+std::string ThumbnailCache::getEntryFilename(const std::string &filename, size_t maxSize) const {
+  struct stat statbuf;
+  if (m_Directory.empty() || stat(filename.c_str(), &statbuf) != 0) return {};
+  const int64_t modification = statbuf.st_mtime;
+  const int64_t size = statbuf.st_size;
+  const uint64_t thumbnailSize = maxSize;
+  uint64_t hash = 14695981039346656037ULL;
+  fnv1a(hash, filename.data(), filename.size());
+  fnv1a(hash, &modification, sizeof(modification));
+  fnv1a(hash, &size, sizeof(size));
+  fnv1a(hash, &thumbnailSize, sizeof(thumbnailSize));
+  char name[32];
+  snprintf(name, sizeof(name), "/%016llx", static_cast<unsigned long long>(hash));
+  return m_Directory + name;
+}
+
+bool ThumbnailCache::load(const std::string &filename, size_t maxSize, Thumbnail &thumbnail) const {
+  const std::string entry = getEntryFilename(filename, maxSize);
+  if (entry.empty()) return false;
+  FILE *pFile = fopen(entry.c_str(), "rb");
+  if (!pFile) return false;
+  char magic[sizeof(kMagic)];
+  uint32_t dimensions[2] = {0, 0};
+  bool valid = fread(magic, sizeof(magic), 1, pFile) == 1 && memcmp(magic, kMagic, sizeof(kMagic)) == 0 &&
+               fread(dimensions, sizeof(dimensions), 1, pFile) == 1;
+  valid = valid && dimensions[0] > 0 && dimensions[1] > 0 && dimensions[0] <= kMaxDimension &&
+          dimensions[1] <= kMaxDimension;
+  if (valid) {
+    thumbnail.width = dimensions[0];
+    thumbnail.height = dimensions[1];
+    thumbnail.pixels.resize(thumbnail.width * thumbnail.height * 3);
+    valid = fread(thumbnail.pixels.data(), 1, thumbnail.pixels.size(), pFile) == thumbnail.pixels.size();
+  }
+  fclose(pFile);
+  return valid;
+}
+
+bool ThumbnailCache::store(const std::string &filename, size_t maxSize, const Thumbnail &thumbnail) const {
+  const std::string entry = getEntryFilename(filename, maxSize);
+  if (entry.empty() || thumbnail.pixels.size() != thumbnail.width * thumbnail.height * 3) return false;
+  if (thumbnail.width > kMaxDimension || thumbnail.height > kMaxDimension) return false;
+  return writeFileAtomically(entry, [&](FILE *pFile) {
+    const uint32_t dimensions[2] = {uint32_t(thumbnail.width), uint32_t(thumbnail.height)};
+    return fwrite(kMagic, sizeof(kMagic), 1, pFile) == 1 && fwrite(dimensions, sizeof(dimensions), 1, pFile) == 1 &&
+           fwrite(thumbnail.pixels.data(), 1, thumbnail.pixels.size(), pFile) == thumbnail.pixels.size();
+  });
+}
+
+ThumbnailEngine::ThumbnailEngine(const std::vector<const IMediaStream *> &streams, size_t maxSize,
+                                 ColorSpace colorspace, const std::string &cacheDirectory, unsigned threads,
+                                 std::function<void()> onReady)
+    : m_Streams(streams),
+      m_MaxSize(maxSize),
+      m_ColorSpace(colorspace),
+      m_Cache(cacheDirectory),
+      m_OnReady(onReady),
+      m_Remaining(streams.size()),
+      m_Next(0),
+      m_Stop(false) {
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  // decoding blocks on file reads, the workers don't run on the shared pool
+  const size_t count = std::min<size_t>(threads, m_Streams.size());
+  for (size_t i = 0; i < count; ++i) m_Workers.emplace_back(&ThumbnailEngine::workerFunction, this);
+}
+
+ThumbnailEngine::~ThumbnailEngine() {
+  m_Stop = true;
+  for (auto &worker : m_Workers) worker.join();
+}
+
+void ThumbnailEngine::workerFunction() {
+  while (!m_Stop) {
+    const size_t index = m_Next++;
+    if (index >= m_Streams.size()) return;
+    Result result = generate(index);
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Results.push_back(std::move(result));
+      --m_Remaining;
+    }
+    if (m_OnReady) m_OnReady();
+  }
+}
+
+void ThumbnailEngine::collect(std::vector<Result> &results) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  for (auto &result : m_Results) results.push_back(std::move(result));
+  m_Results.clear();
+}
+
+bool ThumbnailEngine::isPending() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Remaining > 0 || !m_Results.empty();
+}
+
+ThumbnailEngine::Result ThumbnailEngine::generate(size_t index) const {
+  using namespace attribute;
+  Result result;
+  result.index = index;
+  const IMediaStream &stream = *m_Streams[index];
+  const auto &state = stream.getState();
+  result.filename = getWithDefault<File>(state);
+  if (contains<Error>(state)) {
+    result.error = getOrDie<Error>(state);
+    return result;
+  }
+  if (m_Cache.load(result.filename, m_MaxSize, result.thumbnail)) return result;
+  Attributes request;
+  set<ProxyLevel>(request, MAX_PROXY_LEVEL);
+  const ReadFrameResult read = stream.process(0, request);
+  if (!read) {
+    result.error = read.error;
+    return result;
+  }
+  try {
+    // each worker already decodes its own stream
+    result.thumbnail = createThumbnail(read.frame, resolveColorSpace(read.attributes(), m_ColorSpace), m_MaxSize, 1);
+  } catch (const std::exception &e) {
+    result.error = e.what();
+    return result;
+  }
+  m_Cache.store(result.filename, m_MaxSize, result.thumbnail);
+  return result;
+}
+
+} /* namespace duke */
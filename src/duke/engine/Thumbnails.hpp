@@ -0,0 +1,106 @@
+#pragma once
+
+#include <duke/base/NonCopyable.hpp>
+#include <duke/engine/ColorSpace.hpp>
+#include <duke/engine/ColorTransforms.hpp>
+#include <duke/image/FrameData.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace duke {
+
+class IMediaStream;
+
+// A display referred preview, sRGB 8 bits RGB, rows top to bottom.
+struct Thumbnail {
+  size_t width = 0;
+  size_t height = 0;
+  std::vector<uint8_t> pixels;
+};
+
+// Box filter, each destination pixel averages the source pixels it covers.
+// Meant for shrinking, rows are split across threads.
+void downscale(const RgbaImage &source, size_t width, size_t height, RgbaImage &destination, unsigned threads = 0);
+
+// Fits the frame in a maxSize square keeping its aspect ratio, never enlarges.
+Thumbnail createThumbnail(const FrameData &frame, ColorSpace colorspace, size_t maxSize, unsigned threads = 0);
+
+/**
+ * Thumbnails stored on disk, one small file each.
+ * - Entries are keyed by the file path, modification time and size, an edited
+ *   file gets a new entry, stale ones are left for the user to clean.
+ * - Files are written atomically so several instances can share the cache.
+ * - An empty or unusable directory disables the cache.
+ */
+class ThumbnailCache {
+ public:
+  explicit ThumbnailCache(const std::string &directory);
+
+  // USER_CACHE/duke/thumbnails, empty if there is no user cache directory.
+  static std::string getDefaultDirectory();
+
+  bool load(const std::string &filename, size_t maxSize, Thumbnail &thumbnail) const;
+  bool store(const std::string &filename, size_t maxSize, const Thumbnail &thumbnail) const;
+
+  bool isEnabled() const { return !m_Directory.empty(); }
+
+ private:
+  // Empty if the file can't be stat'ed.
+  std::string getEntryFilename(const std::string &filename, size_t maxSize) const;
+
+  std::string m_Directory;
+};
+
+/**
+ * Creates the thumbnails of the first frame of streams in the background.
+ * - Streams are decoded at the lowest proxy level, EXR files read a mip level
+ *   and DPX files are subsampled so only a fraction of each file is decoded.
+ * - Thumbnails found in the cache are not decoded again.
+ * - Threads take the next stream from a shared index as they finish one, a
+ *   slow stream only holds its own thread. 0 uses the hardware concurrency.
+ * The streams must outlive the engine, the destructor stops the workers
+ * after the streams being processed.
+ */
+class ThumbnailEngine : public noncopyable {
+ public:
+  struct Result {
+    size_t index;  // in the requested streams
+    std::string filename;
+    Thumbnail thumbnail;
+    std::string error;
+  };
+
+  // A linear colorspace is resolved per stream as for display, onReady is
+  // called from a worker thread after each result.
+  ThumbnailEngine(const std::vector<const IMediaStream *> &streams, size_t maxSize, ColorSpace colorspace,
+                  const std::string &cacheDirectory, unsigned threads = 0, std::function<void()> onReady = nullptr);
+  ~ThumbnailEngine();
+
+  // Moves the results produced since the last call.
+  void collect(std::vector<Result> &results);
+  bool isPending() const;
+
+ private:
+  void workerFunction();
+  Result generate(size_t index) const;
+
+  const std::vector<const IMediaStream *> m_Streams;
+  const size_t m_MaxSize;
+  const ColorSpace m_ColorSpace;
+  const ThumbnailCache m_Cache;
+  const std::function<void()> m_OnReady;
+  mutable std::mutex m_Mutex;
+  std::vector<Result> m_Results;
+  size_t m_Remaining;
+  std::atomic<size_t> m_Next;
+  std::atomic<bool> m_Stop;
+  std::vector<std::thread> m_Workers;
+};
+
+} /* namespace duke */
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <duke/base/FlatMap.hpp>
 #include <duke/engine/streams/MediaFrameReference.hpp>
 
 #include <string>
@@ -43,7 +44,9 @@ struct Clip {
   std::shared_ptr<IOverlay> pOverlay;
 };
 
-struct Track : public std::map<size_t, Clip> {
+// Clips sorted by start frame, stored contiguously so the per frame lookups
+// are binary searches over an array of start frames.
+struct Track : public FlatMap<size_t, Clip> {
   typedef value_type TrackClip;
 
   void add(size_t frame, Clip&& clip);
@@ -0,0 +1,61 @@
+#include "TimelineIndex.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace duke {
+
+TimelineIndex::TimelineIndex(const Timeline& timeline) {
+  for (size_t track = 0; track < timeline.size(); ++track) {
+    const Track& clips = timeline[track];
+    for (auto pClip = clips.begin(); pClip != clips.end(); ++pClip) {
+      // as in Track::clipContaining, a clip ends where the next one starts,
+      // even if the next one has no media
+      Range range = rangeutils::getRange(*pClip);
+      const auto pNext = std::next(pClip);
+      if (pNext != clips.end()) range.last = std::min(range.last, pNext->first - 1);
+      if (pClip->second.pStream) m_Entries.push_back(Entry{range, track, pClip->second.pStream.get()});
+    }
+  }
+  std::stable_sort(m_Entries.begin(), m_Entries.end(),
+                   [](const Entry& a, const Entry& b) { return a.range.first < b.range.first; });
+  m_SubtreeLast.resize(m_Entries.size());
+  build(0, m_Entries.size());
+
+  for (const Entry& entry : m_Entries) {
+    if (!m_MediaRanges.empty() && m_MediaRanges.back().last + 1 >= entry.range.first)
+      m_MediaRanges.back().last = std::max(m_MediaRanges.back().last, entry.range.last);
+    else
+      m_MediaRanges.push_back(entry.range);
+  }
+}
+
+size_t TimelineIndex::build(size_t lo, size_t hi) {
+  if (lo == hi) return 0;
+  const size_t mid = lo + (hi - lo) / 2;
+  size_t last = m_Entries[mid].range.last;
+  if (lo < mid) last = std::max(last, build(lo, mid));
+  if (mid + 1 < hi) last = std::max(last, build(mid + 1, hi));
+  return m_SubtreeLast[mid] = last;
+}
+
+void TimelineIndex::query(const Range& frames, std::vector<Entry>& entries) const {
+  const size_t previousSize = entries.size();
+  query(0, m_Entries.size(), frames, entries);
+  std::sort(entries.begin() + previousSize, entries.end(), [](const Entry& a, const Entry& b) {
+    return a.track != b.track ? a.track < b.track : a.range.first < b.range.first;
+  });
+}
+
+void TimelineIndex::query(size_t lo, size_t hi, const Range& frames, std::vector<Entry>& entries) const {
+  if (lo == hi) return;
+  const size_t mid = lo + (hi - lo) / 2;
+  if (m_SubtreeLast[mid] < frames.first) return;  // everything ends before frames
+  query(lo, mid, frames, entries);
+  const Entry& entry = m_Entries[mid];
+  if (entry.range.first > frames.last) return;  // entries on the right start even later
+  if (entry.range.last >= frames.first) entries.push_back(entry);
+  query(mid + 1, hi, frames, entries);
+}
+
+}  // namespace duke
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <duke/engine/Timeline.hpp>
+
+#include <vector>
+
+namespace duke {
+
+/**
+ * An interval tree over the media clips of all the tracks of a Timeline.
+ *
+ * The clips are sorted by start frame and each node of the implicit binary
+ * tree built over this array knows the last frame of its subtree, so a query
+ * costs O(log(clips) + matches) whatever the number of tracks.
+ *
+ * Clips overlapping the next clip of their track are cut where it starts, so
+ * a frame finds the clip Track::clipContaining finds, at most one per track.
+ *
+ * The index refers to the streams of the timeline, which must outlive it.
+ */
+struct TimelineIndex {
+  struct Entry {
+    Range range;  // in timeline frames, cut by the next clip of the track
+    size_t track;
+    const IMediaStream* pStream;
+  };
+
+  TimelineIndex() = default;
+  explicit TimelineIndex(const Timeline& timeline);
+
+  // Appends the media clips overlapping frames, sorted by track then start.
+  void query(const Range& frames, std::vector<Entry>& entries) const;
+
+  // Sorted union of the media clip ranges.
+  const Ranges& getMediaRanges() const { return m_MediaRanges; }
+
+  bool empty() const { return m_Entries.empty(); }
+
+ private:
+  void query(size_t lo, size_t hi, const Range& frames, std::vector<Entry>& entries) const;
+  size_t build(size_t lo, size_t hi);
+
+  std::vector<Entry> m_Entries;        // sorted by start frame
+  std::vector<size_t> m_SubtreeLast;  // last frame of the subtree rooted at each entry
+  Ranges m_MediaRanges;
+};
+
+} /* namespace duke */
@@ -0,0 +1,82 @@
+#include "CacheResidency.hpp"
+
+#include <duke/base/Check.hpp>
+
+namespace duke {
+
+void FrameIntervalSet::add(size_t frame) {
+  if (m_Counts[frame]++ > 0) return;
+  auto next = m_Intervals.upper_bound(frame);
+  const bool joinsNext = next != m_Intervals.end() && next->first == frame + 1;
+  if (next != m_Intervals.begin()) {
+    auto previous = std::prev(next);
+    if (previous->second + 1 == frame) {
+      previous->second = joinsNext ? next->second : frame;
+      if (joinsNext) m_Intervals.erase(next);
+      return;
+    }
+  }
+  const size_t last = joinsNext ? next->second : frame;
+  if (joinsNext) m_Intervals.erase(next);
+  m_Intervals.emplace(frame, last);
+}
+
+void FrameIntervalSet::remove(size_t frame) {
+  const auto count = m_Counts.find(frame);
+  CHECK(count != m_Counts.end()) << "frame " << frame << " is not in the set";
+  if (--count->second > 0) return;
+  m_Counts.erase(count);
+  auto interval = std::prev(m_Intervals.upper_bound(frame));
+  const size_t first = interval->first;
+  const size_t last = interval->second;
+  if (first == frame)
+    m_Intervals.erase(interval);
+  else
+    interval->second = frame - 1;
+  if (last != frame) m_Intervals.emplace(frame + 1, last);
+}
+
+bool FrameIntervalSet::contains(size_t frame) const { return m_Counts.find(frame) != m_Counts.end(); }
+
+void FrameIntervalSet::getRanges(Ranges& ranges) const {
+  ranges.clear();
+  for (const auto& interval : m_Intervals) ranges.emplace_back(interval.first, interval.second);
+}
+
+std::shared_ptr<CacheResidency> CacheResidency::create() { return std::shared_ptr<CacheResidency>(new CacheResidency()); }
+
+CacheResidency::Token CacheResidency::acquire(const MediaFrameReference& mfr, uint64_t weight) {
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Streams[mfr.pStream].add(mfr.frame);
+    m_Weight += weight;
+  }
+  // The token may outlive the residency, eg. in a cache destroyed later on.
+  const std::weak_ptr<CacheResidency> pResidency(shared_from_this());
+  return Token(nullptr, [=](void*) {
+    if (const auto pLocked = pResidency.lock()) pLocked->release(mfr, weight);
+  });
+}
+
+void CacheResidency::release(const MediaFrameReference& mfr, uint64_t weight) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto stream = m_Streams.find(mfr.pStream);
+  CHECK(stream != m_Streams.end());
+  stream->second.remove(mfr.frame);
+  if (stream->second.empty()) m_Streams.erase(stream);
+  m_Weight -= weight;
+}
+
+uint64_t CacheResidency::snapshot(State& state) const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  for (auto itr = state.begin(); itr != state.end();) {
+    if (m_Streams.find(itr->first) == m_Streams.end())
+      itr = state.erase(itr);
+    else
+      ++itr;
+  }
+  for (const auto& stream : m_Streams) stream.second.getRanges(state[stream.first]);
+  return m_Weight;
+}
+
+} /* namespace duke */
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <duke/base/NonCopyable.hpp>
+#include <duke/engine/Timeline.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace duke {
+
+/**
+ * A set of frames stored as disjoint closed intervals.
+ * - A frame can be added several times, eg. at different proxy levels and
+ *   regions, it leaves the set when it has been removed as many times.
+ * - Adding or removing a frame is O(log(ranges)).
+ */
+struct FrameIntervalSet {
+  void add(size_t frame);
+  void remove(size_t frame);
+
+  bool contains(size_t frame) const;
+  bool empty() const { return m_Intervals.empty(); }
+  size_t rangeCount() const { return m_Intervals.size(); }
+  void getRanges(Ranges& ranges) const;
+
+ private:
+  std::map<size_t, size_t> m_Intervals;  // first -> last
+  std::unordered_map<size_t, uint32_t> m_Counts;
+};
+
+/**
+ * Tracks which frames of which streams are held by a cache.
+ * The cache stores the token returned by acquire() alongside the frame. When
+ * the cache drops the frame the token dies and the frame leaves the set, so
+ * evictions are accounted for without the cache reporting them.
+ * Thread safe.
+ */
+struct CacheResidency : public noncopyable, public std::enable_shared_from_this<CacheResidency> {
+  typedef std::shared_ptr<void> Token;
+  typedef std::map<const IMediaStream*, Ranges> State;
+
+  static std::shared_ptr<CacheResidency> create();
+
+  Token acquire(const MediaFrameReference& mfr, uint64_t weight);
+
+  // Fills state with the resident ranges per stream and returns the resident
+  // weight. Runs in O(ranges), reusing the vectors already in state.
+  uint64_t snapshot(State& state) const;
+
+ private:
+  CacheResidency() = default;
+  void release(const MediaFrameReference& mfr, uint64_t weight);
+
+  mutable std::mutex m_Mutex;
+  std::map<const IMediaStream*, FrameIntervalSet> m_Streams;
+  uint64_t m_Weight = 0;
+};
+
+} /* namespace duke */
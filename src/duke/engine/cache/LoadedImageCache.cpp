@@ -2,14 +2,18 @@
 #include <duke/base/Check.hpp>
 #include <duke/attributes/AttributeKeys.hpp>
 #include <duke/engine/streams/IMediaStream.hpp>
+#include <duke/time/Clock.hpp>
+#include <duke/time/Trace.hpp>
 
 namespace duke {
 
 LoadedImageCache::LoadedImageCache(unsigned workerThreadDefault, size_t maxSizeDefault)
     : m_MaxWeight(maxSizeDefault),
+      m_pResidency(CacheResidency::create()),
       m_Cache(m_MaxWeight),
       m_TimelineHasMovie(false),
-      m_WorkerCount(workerThreadDefault) {}
+      m_WorkerCount(workerThreadDefault),
+      m_BusyMicroseconds(0) {}
 
 LoadedImageCache::~LoadedImageCache() { stopWorkers(); }
 
@@ -27,66 +31,55 @@ bool clipIsForwardStream(const std::pair<size_t, Clip> &pair) {
   return clip.pStream && clip.pStream->isForwardOnly();
 }
 
-bool trackHasForwardStream(const Track &track) { return std::any_of(begin(track), end(track), &clipIsForwardStream); }
+bool trackHasForwardStream(const Track &track) { return std::any_of(track.begin(), track.end(), &clipIsForwardStream); }
 
 bool timelineHasMovie(const Timeline &timeline) {
   return std::any_of(begin(timeline), end(timeline), &trackHasForwardStream);
 }
 
+attribute::Attributes getReadRequest(const MediaFrameReference &mfr) {
+  attribute::Attributes request;
+  if (mfr.proxyLevel > 0) attribute::set<attribute::ProxyLevel>(request, mfr.proxyLevel);
+  if (!mfr.region.isFull()) setRegionOfInterest(request, mfr.region);
+  return request;
+}
+
 }  // namespace
 
 void LoadedImageCache::load(const Timeline &timeline) {
   stopWorkers();
   m_Timeline = timeline;
-  m_MediaRanges = getMediaRanges(m_Timeline);
+  m_TimelineIndex = TimelineIndex(m_Timeline);
   m_TimelineHasMovie = timelineHasMovie(m_Timeline);
-  if (m_MediaRanges.empty()) return;
+  const Ranges &mediaRanges = m_TimelineIndex.getMediaRanges();
+  if (mediaRanges.empty()) return;
   startWorkers();
-  cue(m_MediaRanges.begin()->first, m_TimelineHasMovie ? IterationMode::FORWARD : IterationMode::PINGPONG);
+  cue(mediaRanges.begin()->first, m_TimelineHasMovie ? IterationMode::FORWARD : IterationMode::PINGPONG);
 }
 
-void LoadedImageCache::cue(size_t frame, IterationMode mode) {
-  m_Cache.process(TimelineIterator(&m_Timeline, &m_MediaRanges, frame, mode));
+void LoadedImageCache::cue(size_t frame, IterationMode mode, uint8_t proxyLevel, Region region) {
+  m_Cache.process(TimelineIterator(&m_TimelineIndex, frame, mode, proxyLevel, region));
 }
 
 void LoadedImageCache::terminate() { stopWorkers(); }
 
-bool LoadedImageCache::get(const MediaFrameReference &id, FrameData &data) const { return m_Cache.get(id, data); }
+bool LoadedImageCache::get(const MediaFrameReference &id, FrameData &data) const {
+  CachedFrame cached;
+  if (!m_Cache.get(id, cached)) return false;
+  data = std::move(cached.frame);
+  return true;
+}
 
 uint64_t LoadedImageCache::dumpState(std::map<const IMediaStream *, std::vector<Range> > &state) const {
-  state.clear();
-
-  const auto currentWeight = m_Cache.dumpKeys(m_DumpStateTmp);
-  std::sort(begin(m_DumpStateTmp), end(m_DumpStateTmp));
-
-  const IMediaStream *pLastMedia = nullptr;
-  std::vector<Range> mediaRanges;
-
-  for (const auto &key : m_DumpStateTmp) {
-    const IMediaStream *pCurrentMedia = key.pStream;
-    const size_t frame = key.frame;
-    const bool newMedia = pCurrentMedia != pLastMedia;
-    if (newMedia) {
-      if (pLastMedia != nullptr) state.insert(std::make_pair(pLastMedia, std::move(mediaRanges)));
-      mediaRanges.clear();
-      mediaRanges.emplace_back(frame, frame);
-    } else {
-      if (mediaRanges.back().last + 1 == frame)
-        ++mediaRanges.back().last;
-      else
-        mediaRanges.emplace_back(frame, frame);
-    }
-    pLastMedia = pCurrentMedia;
-  }
-  if (pLastMedia != nullptr) state.insert(std::make_pair(pLastMedia, std::move(mediaRanges)));
-
-  return currentWeight;
+  return m_pResidency->snapshot(state);
 }
 
 uint64_t LoadedImageCache::getMaxWeight() const { return m_MaxWeight; }
 
 size_t LoadedImageCache::getWorkerCount() const { return m_WorkerCount; }
 
+uint64_t LoadedImageCache::getBusyMicroseconds() const { return m_BusyMicroseconds; }
+
 void LoadedImageCache::startWorkers() {
   if (!m_WorkerThreads.empty()) throw std::logic_error("You must stop workers thread before calling startWorkers");
   m_Cache.terminate(false);
@@ -105,18 +98,21 @@ void LoadedImageCache::workerFunction() {
     for (;;) {
       m_Cache.pop(mfr);
       CHECK(mfr.pStream);
-      ReadFrameResult result(mfr.pStream->process(mfr.frame));
+      DUKE_TRACE_FRAME(mfr.frame, mfr.pStream);
+      StopWatch watch;
+      ReadFrameResult result(mfr.pStream->process(mfr.frame, getReadRequest(mfr)));
+      m_BusyMicroseconds += watch.elapsedMicroSeconds().count();
 
       switch (result.status) {
         case IOResult::FAILURE: {
           printf("error while reading %s : %s\n", attribute::getOrDie<attribute::File>(result.attributes()),
                  result.error.c_str());
-          m_Cache.push(mfr, 1UL, FrameData());
+          m_Cache.push(mfr, 1UL, CachedFrame{FrameData(), m_pResidency->acquire(mfr, 1UL)});
           break;
         }
         case IOResult::SUCCESS: {
           const size_t weight = result.frame.description.dataSize;
-          m_Cache.push(mfr, weight, std::move(result.frame));
+          m_Cache.push(mfr, weight, CachedFrame{std::move(result.frame), m_pResidency->acquire(mfr, weight)});
           break;
         }
       }
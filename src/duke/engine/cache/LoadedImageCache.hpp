@@ -2,11 +2,13 @@
 
 #include <concurrent/cache/lookahead_cache.hpp>
 #include <duke/base/NonCopyable.hpp>
+#include <duke/engine/cache/CacheResidency.hpp>
 #include <duke/engine/cache/TimelineIterator.hpp>
 #include <duke/engine/Timeline.hpp>
 #include <duke/engine/streams/IMediaStream.hpp>
 #include <duke/image/FrameData.hpp>
 
+#include <atomic>
 #include <thread>
 #include <vector>
 
@@ -18,33 +20,42 @@ struct LoadedImageCache : public noncopyable {
 
   void setWorkerCount(size_t workerCount);
   void load(const Timeline &timeline);
-  void cue(size_t frame, IterationMode mode);
+  void cue(size_t frame, IterationMode mode, uint8_t proxyLevel = 0, Region region = Region());
   void terminate();
 
   bool get(const MediaFrameReference &id, FrameData &data) const;
+  // Cached ranges per stream, returns the cached weight.
   uint64_t dumpState(std::map<const IMediaStream *, std::vector<Range> > &state) const;
   uint64_t getMaxWeight() const;
   size_t getWorkerCount() const;
+  // Time spent by all workers reading frames, for utilisation.
+  uint64_t getBusyMicroseconds() const;
 
  private:
   void startWorkers();
   void stopWorkers();
   void workerFunction();
 
+  // The residency token leaves with the frame when the cache evicts it.
+  struct CachedFrame {
+    FrameData frame;
+    CacheResidency::Token residency;
+  };
+
   typedef MediaFrameReference ID_TYPE;
   typedef uint64_t METRIC_TYPE;
-  typedef FrameData DATA_TYPE;
+  typedef CachedFrame DATA_TYPE;
   typedef TimelineIterator WORK_UNIT_RANGE;
 
   size_t m_MaxWeight;
+  const std::shared_ptr<CacheResidency> m_pResidency;
   concurrent::cache::lookahead_cache<ID_TYPE, METRIC_TYPE, DATA_TYPE, WORK_UNIT_RANGE> m_Cache;
   std::vector<std::thread> m_WorkerThreads;
   Timeline m_Timeline;
-  Ranges m_MediaRanges;
+  TimelineIndex m_TimelineIndex;
   bool m_TimelineHasMovie;
   size_t m_WorkerCount;
-
-  mutable std::vector<MediaFrameReference> m_DumpStateTmp;
+  std::atomic<uint64_t> m_BusyMicroseconds;
 };
 
 } /* namespace duke */
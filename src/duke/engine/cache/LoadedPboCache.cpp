@@ -1,5 +1,6 @@
 #include "LoadedPboCache.hpp"
 #include <duke/engine/cache/LoadedImageCache.hpp>
+#include <duke/time/Trace.hpp>
 
 namespace duke {
 
@@ -13,6 +14,7 @@ bool LoadedPboCache::get(const LoadedImageCache& imageCache, const MediaFrameRef
     const auto dataSize = frame.description.dataSize;
     auto pSharedPbo = m_PboPool.get(dataSize);
     {  // transfer buffer
+      DUKE_TRACE_SCOPE("pbo copy");
       auto pboBound = pSharedPbo->scope_bind_buffer();
       GLubyte* ptr =
           (GLubyte*)glMapBufferRange(pSharedPbo->target, 0, dataSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
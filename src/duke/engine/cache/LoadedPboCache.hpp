@@ -12,6 +12,7 @@ struct LoadedImageCache;
 
 struct LoadedPboCache : public noncopyable {
   bool get(const LoadedImageCache& imageCache, const MediaFrameReference& mfr, PboPackedFrame& pbo);
+  size_t getPoolSize() const { return m_PboPool.size; }  // bytes allocated for PBOs
 
  private:
   void moveFront(const MediaFrameReference& mfr);
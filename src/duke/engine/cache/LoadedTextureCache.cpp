@@ -1,5 +1,7 @@
 #include "LoadedTextureCache.hpp"
 #include <duke/cmdline/CmdLineParameters.hpp>
+#include <duke/time/Clock.hpp>
+#include <duke/time/Trace.hpp>
 #include <algorithm>
 
 namespace duke {
@@ -10,31 +12,70 @@ void map_erase_if(Map& m, F pred) {
 }
 
 LoadedTextureCache::LoadedTextureCache(const CmdLineParameters& parameters)
-    : m_ImageCache(parameters.workerThreadDefault, parameters.imageCacheSizeDefault), m_LastFrame(0) {}
+    : m_ImageCache(parameters.workerThreadDefault, parameters.imageCacheSizeDefault), m_LastFrame(0),
+      m_LastProxyLevel(0),
+      m_TileSize(parameters.textureTileSize),
+      m_MaxRectangleSize(0),
+      m_Max2DSize(0),
+      m_Mipmap(parameters.mipmapDisplay) {
+  m_MipmapTexturePool.target = GL_TEXTURE_2D;
+}
 
 void LoadedTextureCache::load(const Timeline& timeline) {
   m_Timeline = timeline;
-  m_TimelineRanges = getMediaRanges(m_Timeline);
+  m_TimelineIndex = TimelineIndex(m_Timeline);
   m_ImageCache.load(timeline);
 }
 
-void LoadedTextureCache::prepare(size_t frame, IterationMode mode) {
-  if (frame != m_LastFrame) {
-    m_ImageCache.cue(frame, mode);
+bool LoadedTextureCache::fetch(const MediaFrameReference& mfr) {
+  if (m_Map.find(mfr) == m_Map.end()) {
+    DUKE_TRACE_FRAME(mfr.frame, mfr.pStream);
+    StopWatch watch;
+    PboPackedFrame pboPackedFrame;
+    const auto pboReady = m_PboCache.get(m_ImageCache, mfr, pboPackedFrame);
+    if (!pboReady) return false;
+    DUKE_TRACE_SCOPE("upload");
+    const auto& description = pboPackedFrame.description;
+    // integer textures can't be filtered, they stay in a rectangle texture
+    auto& pool = m_Mipmap && isFilterableFormat(description.glFormat) ? m_MipmapTexturePool : m_TexturePool;
+    const size_t maxSize = getTileSize(pool.target);
+    if (description.width > maxSize || description.height > maxSize) {
+      // tiles are rectangle textures
+      auto pTiles = std::make_shared<TiledTexture>(pboPackedFrame, getTileSize(GL_TEXTURE_RECTANGLE));
+      pTiles->stream(m_VisibleRegion, m_TexturePool);
+      m_Map.insert({mfr, TexturePackedFrame(pboPackedFrame, pTiles)});
+    } else {
+      m_Map.insert({mfr, TexturePackedFrame(pboPackedFrame, pool.get(description))});
+    }
+    ++m_Statistics.uploads;
+    m_Statistics.uploadMicroseconds += watch.elapsedMicroSeconds().count();
+  }
+  m_FrameMedia.insert(mfr);
+  return true;
+}
+
+void LoadedTextureCache::prepare(size_t frame, IterationMode mode, uint8_t proxyLevel, Region region) {
+  if (frame != m_LastFrame || proxyLevel != m_LastProxyLevel || region != m_LastRegion) {
+    m_ImageCache.cue(frame, mode, proxyLevel, region);
     m_LastFrame = frame;
+    m_LastProxyLevel = proxyLevel;
+    m_LastRegion = region;
   }
   m_FrameMedia.clear();
-  TimelineIterator itr(&m_Timeline, &m_TimelineRanges, frame, IterationMode::FORWARD);
+  TimelineIterator itr(&m_TimelineIndex, frame, IterationMode::FORWARD, proxyLevel, region);
   itr.setMaxFrameIterations(2);  // loading this frame and prefetching next one
   for (; !itr.empty();) {
     const auto mfr = itr.next();
-    m_FrameMedia.insert(mfr);
-    if (m_Map.find(mfr) != m_Map.end())  // already in cache
-      continue;
-    PboPackedFrame pboPackedFrame;
-    const auto pboReady = m_PboCache.get(m_ImageCache, mfr, pboPackedFrame);
-    if (pboReady)
-      m_Map.insert({mfr, TexturePackedFrame(pboPackedFrame, m_TexturePool.get(pboPackedFrame.description))});
+    if (fetch(mfr)) continue;
+    // falling back to another resolution or to the whole image, finest first
+    const auto fetchFallback = [&]() {
+      for (uint8_t level = 0; level <= MAX_PROXY_LEVEL; ++level) {
+        if (level != proxyLevel && fetch(MediaFrameReference(mfr.pStream, mfr.frame, level, region))) return true;
+        if (!region.isFull() && fetch(MediaFrameReference(mfr.pStream, mfr.frame, level))) return true;
+      }
+      return false;
+    };
+    if (!fetchFallback()) ++m_Statistics.pendingFetches;
   }
   // discarding all textures expect those fetched during this call
   const auto isOutsideCurrentFrame = [&](const Map::value_type& pair) {
@@ -43,13 +84,42 @@ void LoadedTextureCache::prepare(size_t frame, IterationMode mode) {
   map_erase_if(m_Map, isOutsideCurrentFrame);
 }
 
+size_t LoadedTextureCache::getTileSize(GLenum target) {
+  const bool rectangle = target == GL_TEXTURE_RECTANGLE;
+  size_t& maxTextureSize = rectangle ? m_MaxRectangleSize : m_Max2DSize;
+  if (maxTextureSize == 0) {
+    GLint maxSize = 0;
+    glGetIntegerv(rectangle ? GL_MAX_RECTANGLE_TEXTURE_SIZE : GL_MAX_TEXTURE_SIZE, &maxSize);
+    maxTextureSize = maxSize;
+  }
+  return m_TileSize ? std::min(m_TileSize, maxTextureSize) : maxTextureSize;
+}
+
+LoadedTextureCache::Map::const_iterator LoadedTextureCache::findFirstVersion(const MediaFrameReference& mfr) const {
+  // the smallest proxy level and region of this stream and frame
+  return m_Map.lower_bound(MediaFrameReference(mfr.pStream, mfr.frame, 0, Region(0, 0, 0, 0)));
+}
+
+void LoadedTextureCache::streamTiles(const MediaFrameReference& mfr, const Region& visible) {
+  m_VisibleRegion = visible;
+  for (auto itr = findFirstVersion(mfr); itr != m_Map.end() && itr->first.sameFrame(mfr); ++itr)
+    if (itr->second.pTiles) itr->second.pTiles->stream(visible, m_TexturePool);
+}
+
 const Timeline& LoadedTextureCache::getTimeline() const { return m_Timeline; }
 
 const LoadedImageCache& LoadedTextureCache::getImageCache() const { return m_ImageCache; }
 
+const LoadedTextureCache::Statistics& LoadedTextureCache::getStatistics() const { return m_Statistics; }
+
+size_t LoadedTextureCache::getPboPoolSize() const { return m_PboCache.getPoolSize(); }
+
+size_t LoadedTextureCache::getTexturePoolCount() const { return m_TexturePool.count + m_MipmapTexturePool.count; }
+
 const TexturePackedFrame* LoadedTextureCache::getLoadedTexture(const MediaFrameReference& mfr) const {
-  auto pFound = m_Map.find(mfr);
-  if (pFound == m_Map.end()) return nullptr;
+  // prepare keeps a single version of each frame
+  const auto pFound = findFirstVersion(mfr);
+  if (pFound == m_Map.end() || !pFound->first.sameFrame(mfr)) return nullptr;
   return &pFound->second;
 }
 } /* namespace duke */
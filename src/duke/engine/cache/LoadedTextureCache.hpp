@@ -16,23 +16,54 @@ struct CmdLineParameters;
 struct LoadedTextureCache : public noncopyable {
   LoadedTextureCache(const CmdLineParameters& parameters);
 
+  struct Statistics {
+    uint64_t uploads = 0;
+    uint64_t uploadMicroseconds = 0;  // PBO copy and texture upload submission
+    uint64_t pendingFetches = 0;      // frames requested but not decoded yet
+  };
+
   void load(const Timeline& timeline);
-  void prepare(size_t frame, IterationMode mode);
+  // proxyLevel and region describe the part of the image to decode, if it is
+  // not available yet the best already decoded version of the frame is used.
+  void prepare(size_t frame, IterationMode mode, uint8_t proxyLevel = 0, Region region = Region());
 
+  // Returns the texture for this stream and frame whatever its proxy level and region.
   const TexturePackedFrame* getLoadedTexture(const MediaFrameReference& mfr) const;
+  // Streams the tiles of a tiled frame visible in the region, frames fetched
+  // afterwards start with the same tiles.
+  void streamTiles(const MediaFrameReference& mfr, const Region& visible);
   const Timeline& getTimeline() const;
   const LoadedImageCache& getImageCache() const;
+  const Statistics& getStatistics() const;
+  size_t getPboPoolSize() const;
+  size_t getTexturePoolCount() const;
 
  private:
   Timeline m_Timeline;
-  Ranges m_TimelineRanges;
+  TimelineIndex m_TimelineIndex;
   LoadedImageCache m_ImageCache;
   LoadedPboCache m_PboCache;
   TexturePool m_TexturePool;
+  TexturePool m_MipmapTexturePool;
+  bool fetch(const MediaFrameReference& mfr);
+  // Largest image uploaded in a single texture of the pool target.
+  size_t getTileSize(GLenum target);
+
   size_t m_LastFrame;
+  uint8_t m_LastProxyLevel;
+  Region m_LastRegion;
+  Region m_VisibleRegion;
+  size_t m_TileSize;
+  size_t m_MaxRectangleSize;  // 0 until queried
+  size_t m_Max2DSize;
+  bool m_Mipmap;
   std::set<MediaFrameReference> m_FrameMedia;
   typedef std::map<MediaFrameReference, TexturePackedFrame> Map;
+  // The versions of a frame are contiguous in the map, ordered by proxy level
+  // and region. Returns the first one.
+  Map::const_iterator findFirstVersion(const MediaFrameReference& mfr) const;
   Map m_Map;
+  Statistics m_Statistics;
 };
 
 } /* namespace duke */
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <duke/engine/cache/TiledTexture.hpp>
 #include <duke/image/FrameDescriptionAndAttributes.hpp>
 #include <duke/gl/Textures.hpp>
 #include <duke/gl/GLUtils.hpp>
@@ -15,9 +16,15 @@ struct TexturePackedFrame : public FrameDescriptionAndAttributes {
     auto textureBound = pTexture->scope_bind_texture();
     auto pixelFormat = getPixelFormat(description.glFormat);
     auto pixelType = getPixelType(description.glFormat);
-    glTexSubImage2D(pTexture->target, 0, 0, 0, description.width, description.height, pixelFormat, pixelType, nullptr);
+    glTexSubImage2D(pTexture->target, 0, description.dataX, description.dataY, description.getDataWidth(),
+                    description.getDataHeight(), pixelFormat, pixelType, nullptr);
+    if (pTexture->target == GL_TEXTURE_2D) pTexture->generateMipmaps();
   }
-  std::shared_ptr<Texture> pTexture;
+  // Frames larger than the texture size limit are displayed through a tiled texture.
+  TexturePackedFrame(const PboPackedFrame &pbo, const std::shared_ptr<TiledTexture> &pTiles)
+      : FrameDescriptionAndAttributes(pbo), pTiles(pTiles) {}
+  std::shared_ptr<Texture> pTexture;  // nullptr for tiled frames
+  std::shared_ptr<TiledTexture> pTiles;
 };
 
 } /* namespace duke */
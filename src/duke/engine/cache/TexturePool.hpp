@@ -1,6 +1,8 @@
 #pragma once
 
+#include <duke/engine/cache/Pool.hpp>
 #include <duke/gl/GLUtils.hpp>
+#include <duke/gl/Textures.hpp>
 #include <duke/image/FrameDescription.hpp>
 
 namespace duke {
@@ -8,7 +10,7 @@ namespace duke {
 struct TexturePoolPolicy : public pool::PoolBase<FrameDescription, Texture> {
  protected:
   value_type* evictAndCreate(const key_type& key, PoolMap& map) {
-    auto* pValue = new Texture();
+    auto* pValue = new Texture(target);
     {
       auto bound = pValue->scope_bind_texture();
       pValue->initialize(key, nullptr);
@@ -21,6 +23,7 @@ struct TexturePoolPolicy : public pool::PoolBase<FrameDescription, Texture> {
 
  public:
   size_t count = 0;
+  GLenum target = GL_TEXTURE_RECTANGLE;  // a pool only holds one kind of texture
 };
 
 typedef pool::Pool<TexturePoolPolicy> TexturePool;
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace duke {
+
+// A rectangle of pixels, rows are in file order.
+struct TileRect {
+  size_t x, y, width, height;
+
+  // right and bottom are excluded.
+  bool intersects(size_t left, size_t top, size_t right, size_t bottom) const {
+    return x < right && left < x + width && y < bottom && top < y + height;
+  }
+};
+
+// Splits an image in tiles of tileSize pixels, the last row and column may be smaller.
+inline std::vector<TileRect> getTileLayout(size_t width, size_t height, size_t tileSize) {
+  std::vector<TileRect> tiles;
+  if (tileSize == 0) return tiles;
+  for (size_t y = 0; y < height; y += tileSize)
+    for (size_t x = 0; x < width; x += tileSize)
+      tiles.push_back({x, y, std::min(tileSize, width - x), std::min(tileSize, height - y)});
+  return tiles;
+}
+
+} /* namespace duke */
@@ -0,0 +1,60 @@
+#include "TiledTexture.hpp"
+#include <duke/gl/GLUtils.hpp>
+
+#include <algorithm>
+
+namespace duke {
+
+TiledTexture::TiledTexture(const PboPackedFrame& pbo, size_t tileSize) : m_Pbo(pbo) {
+  const auto& description = pbo.description;
+  for (const auto& rect : getTileLayout(description.width, description.height, tileSize)) m_PageTable.emplace_back(rect);
+}
+
+size_t TiledTexture::stream(const Region& visible, TexturePool& pool) {
+  const auto& description = m_Pbo.description;
+  const size_t left = visible.left(description.width);
+  const size_t top = visible.top(description.height);
+  const size_t right = visible.right(description.width);
+  const size_t bottom = visible.bottom(description.height);
+  size_t uploaded = 0;
+  for (auto& tile : m_PageTable) {
+    if (!tile.intersects(left, top, right, bottom)) {
+      tile.pTexture.reset();  // back to the pool
+      continue;
+    }
+    if (tile.pTexture) continue;
+    FrameDescription tileDescription;
+    tileDescription.width = tile.width;
+    tileDescription.height = tile.height;
+    tileDescription.glFormat = description.glFormat;
+    tile.pTexture = pool.get(tileDescription);
+    upload(tile);
+    ++uploaded;
+  }
+  return uploaded;
+}
+
+void TiledTexture::upload(const Tile& tile) const {
+  const auto& description = m_Pbo.description;
+  // the PBO may only hold the decoded region of interest
+  const size_t dataRight = description.dataX + description.getDataWidth();
+  const size_t dataBottom = description.dataY + description.getDataHeight();
+  const size_t left = std::max(tile.x, description.dataX);
+  const size_t top = std::max(tile.y, description.dataY);
+  const size_t right = std::min(tile.x + tile.width, dataRight);
+  const size_t bottom = std::min(tile.y + tile.height, dataBottom);
+  if (left >= right || top >= bottom) return;
+  auto pboBound = m_Pbo.pPbo->scope_bind_buffer();
+  auto textureBound = tile.pTexture->scope_bind_texture();
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, description.getDataWidth());
+  glPixelStorei(GL_UNPACK_SKIP_PIXELS, left - description.dataX);
+  glPixelStorei(GL_UNPACK_SKIP_ROWS, top - description.dataY);
+  glTexSubImage2D(tile.pTexture->target, 0, left - tile.x, top - tile.y, right - left, bottom - top,
+                  getPixelFormat(description.glFormat), getPixelType(description.glFormat), nullptr);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+  glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+  glCheckError();
+}
+
+} /* namespace duke */
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <duke/base/NonCopyable.hpp>
+#include <duke/engine/cache/PboPackedFrame.hpp>
+#include <duke/engine/cache/TileLayout.hpp>
+#include <duke/engine/cache/TexturePool.hpp>
+#include <duke/imageio/Region.hpp>
+#include <duke/gl/Textures.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace duke {
+
+/**
+ * Virtual texture for images larger than the texture size limit.
+ * The page table maps each tile of the image to a texture, only the tiles
+ * visible in the viewport are resident. They are streamed from the frame PBO
+ * which is kept alive for the tiles becoming visible later on.
+ */
+struct TiledTexture : public noncopyable {
+  struct Tile : public TileRect {
+    Tile(const TileRect& rect) : TileRect(rect) {}
+    std::shared_ptr<Texture> pTexture;  // nullptr when the tile is not resident
+  };
+
+  TiledTexture(const PboPackedFrame& pbo, size_t tileSize);
+
+  // Uploads the visible tiles that are not resident yet and releases the
+  // others, returns the number of uploaded tiles.
+  size_t stream(const Region& visible, TexturePool& pool);
+
+  const std::vector<Tile>& getPageTable() const { return m_PageTable; }
+
+ private:
+  void upload(const Tile& tile) const;
+
+  const PboPackedFrame m_Pbo;
+  std::vector<Tile> m_PageTable;
+};
+
+} /* namespace duke */
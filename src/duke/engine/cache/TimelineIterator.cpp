@@ -1,57 +1,58 @@
 #include "TimelineIterator.hpp"
-#include <queue>
 #include <algorithm>
 #include <cassert>
 
 namespace duke {
 
-const static MediaFrameReference EMPTY;
+namespace {
 
-struct RangeComparator : std::binary_function<Range, Range, bool> {
-  bool operator()(const Range& x, const Range& y) const { return x.first > y.first; }
-};
+// Frames planned at once by a TimelineIterator.
+const size_t kFramesPerBatch = 32;
 
-Ranges getMediaRanges(const Timeline& timeline) {
-  using namespace rangeutils;
-  std::priority_queue<Range, Ranges, RangeComparator> mediaRanges;
-  for (const Track& track : timeline)
-    for (const auto& pair : track)
-      if (pair.second.pStream) mediaRanges.push(getRange(pair));
-  if (mediaRanges.empty()) return Ranges();
-  Ranges merged;
-  merged.push_back(mediaRanges.top());
-  mediaRanges.pop();
-  for (; !mediaRanges.empty(); mediaRanges.pop()) {
-    Range& lastMerged = merged.back();
-    const Range& current = mediaRanges.top();
-    if (lastMerged.last + 1 >= current.first) {
-      lastMerged.last = current.last;
-    } else {
-      merged.push_back(current);
+}  // namespace
+
+Ranges getMediaRanges(const Timeline& timeline) { return TimelineIndex(timeline).getMediaRanges(); }
+
+TrackMediaFrameIterator::TrackMediaFrameIterator(const TimelineIndex* pIndex, size_t currentFrame) {
+  reset(pIndex, currentFrame);
+}
+void TrackMediaFrameIterator::reset(const TimelineIndex* pIndex, size_t currentFrame) {
+  reset(pIndex, std::vector<size_t>(1, currentFrame));
+}
+void TrackMediaFrameIterator::reset(const TimelineIndex* pIndex, const std::vector<size_t>& frames) {
+  m_References.clear();
+  m_Next = 0;
+  if (!pIndex || frames.empty()) return;
+  const auto bounds = std::minmax_element(frames.begin(), frames.end());
+  const Range span(*bounds.first, *bounds.second);
+  if (span.count() <= 2 * frames.size()) {
+    m_Entries.clear();
+    pIndex->query(span, m_Entries);
+    for (const size_t frame : frames) append(frame);
+  } else {
+    // frames are scattered, eg. when wrapping around the timeline
+    for (const size_t frame : frames) {
+      m_Entries.clear();
+      pIndex->query(Range(frame, frame), m_Entries);
+      append(frame);
     }
   }
-  return merged;
 }
-
-TrackMediaFrameIterator::TrackMediaFrameIterator(const Timeline* pTimeline, size_t currentFrame) {
-  reset(pTimeline, currentFrame);
+void TrackMediaFrameIterator::append(size_t frame) {
+  // Entries are sorted by track and never overlap within a track.
+  for (const auto& entry : m_Entries)
+    if (frame >= entry.range.first && frame <= entry.range.last)
+      m_References.emplace_back(entry.pStream, frame - entry.range.first);
 }
-void TrackMediaFrameIterator::reset(const Timeline* pTimeline, size_t currentFrame) {
+void TrackMediaFrameIterator::clear() {
   m_References.clear();
-  if (pTimeline)
-    for (const Track& track : *pTimeline) {
-      const MediaFrameReference mfr = track.getMediaFrameReferenceAt(currentFrame);
-      if (mfr != EMPTY) m_References.push_back(mfr);
-    }
+  m_Next = 0;
 }
-void TrackMediaFrameIterator::clear() { m_References.clear(); }
 MediaFrameReference TrackMediaFrameIterator::next() {
   assert(!empty());
-  MediaFrameReference mfr = m_References.front();
-  m_References.erase(m_References.begin());
-  return mfr;
+  return m_References[m_Next++];
 }
-bool TrackMediaFrameIterator::empty() const { return m_References.empty(); }
+bool TrackMediaFrameIterator::empty() const { return m_Next == m_References.size(); }
 
 FrameIterator::FrameIterator(const Ranges* pMediaRanges, size_t initialFrame, IterationMode mode)
     : m_pMediaRanges(pMediaRanges), m_Mode(mode), m_FramesToGo(0), m_bForward(m_Mode == IterationMode::FORWARD) {
@@ -125,11 +126,15 @@ FrameIterator& FrameIterator::setMaxIterations(size_t maxIterations) {
   return *this;
 }
 
-TimelineIterator::TimelineIterator() : TimelineIterator(nullptr, nullptr, 0, IterationMode::FORWARD) {}
+TimelineIterator::TimelineIterator() : TimelineIterator(nullptr, 0, IterationMode::FORWARD) {}
 
-TimelineIterator::TimelineIterator(const Timeline* pTimeline, const Ranges* pMediaRanges, size_t currentFrame,
-                                   IterationMode mode)
-    : m_pTimeline(pTimeline), m_FrameIterator(pMediaRanges, currentFrame, mode), m_TrackIterator() {}
+TimelineIterator::TimelineIterator(const TimelineIndex* pIndex, size_t currentFrame, IterationMode mode,
+                                   uint8_t proxyLevel, Region region)
+    : m_pIndex(pIndex),
+      m_FrameIterator(pIndex ? &pIndex->getMediaRanges() : nullptr, currentFrame, mode),
+      m_TrackIterator(),
+      m_ProxyLevel(proxyLevel),
+      m_Region(region) {}
 
 bool TimelineIterator::empty() { return m_FrameIterator.empty() && m_TrackIterator.empty(); }
 
@@ -140,8 +145,15 @@ void TimelineIterator::clear() {
 
 MediaFrameReference TimelineIterator::next() {
   assert(!empty());
-  if (m_TrackIterator.empty()) m_TrackIterator.reset(m_pTimeline, m_FrameIterator.next());
-  return m_TrackIterator.next();
+  while (m_TrackIterator.empty() && !m_FrameIterator.empty()) {
+    m_Frames.clear();
+    while (!m_FrameIterator.empty() && m_Frames.size() < kFramesPerBatch) m_Frames.push_back(m_FrameIterator.next());
+    m_TrackIterator.reset(m_pIndex, m_Frames);
+  }
+  MediaFrameReference mfr = m_TrackIterator.next();
+  mfr.proxyLevel = m_ProxyLevel;
+  mfr.region = m_Region;
+  return mfr;
 }
 }
 /* namespace duke */
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <duke/engine/Timeline.hpp>
+#include <duke/engine/TimelineIndex.hpp>
 
 namespace duke {
 
@@ -9,19 +10,29 @@ namespace duke {
  */
 Ranges getMediaRanges(const Timeline &timeline);
 
+/**
+ * The media to load for a batch of frames, frame after frame and track after
+ * track within a frame.
+ */
 struct TrackMediaFrameIterator {
   TrackMediaFrameIterator() = default;
   TrackMediaFrameIterator(const TrackMediaFrameIterator &) = default;
-  TrackMediaFrameIterator(const Timeline *pTimeline, size_t currentFrame);
+  TrackMediaFrameIterator(const TimelineIndex *pIndex, size_t currentFrame);
 
-  void reset(const Timeline *pTimeline, size_t currentFrame);
+  void reset(const TimelineIndex *pIndex, size_t currentFrame);
+  // Plans the frames with a single index query when they are close together.
+  void reset(const TimelineIndex *pIndex, const std::vector<size_t> &frames);
 
   void clear();
   MediaFrameReference next();
   bool empty() const;
 
  private:
+  void append(size_t frame);
+
   std::vector<MediaFrameReference> m_References;
+  size_t m_Next = 0;
+  std::vector<TimelineIndex::Entry> m_Entries;
 };
 
 enum class IterationMode : unsigned char {
@@ -51,7 +62,8 @@ struct FrameIterator {
 
 struct TimelineIterator {
   TimelineIterator();
-  TimelineIterator(const Timeline *pTimeline, const Ranges *pMediaRanges, size_t currentFrame, IterationMode mode);
+  TimelineIterator(const TimelineIndex *pIndex, size_t currentFrame, IterationMode mode, uint8_t proxyLevel = 0,
+                   Region region = Region());
 
   inline void setMaxFrameIterations(size_t maxIterations) { m_FrameIterator.setMaxIterations(maxIterations); }
 
@@ -60,9 +72,12 @@ struct TimelineIterator {
   bool empty();
 
  private:
-  const Timeline *m_pTimeline;
+  const TimelineIndex *m_pIndex;
   FrameIterator m_FrameIterator;
   TrackMediaFrameIterator m_TrackIterator;
+  std::vector<size_t> m_Frames;
+  uint8_t m_ProxyLevel;
+  Region m_Region;
 };
 
 } /* namespace duke */
@@ -75,6 +75,16 @@ std::string FunctionCmd::execute() {
   return {};
 }
 
+FunctionWithArgCmd::FunctionWithArgCmd(const std::function<std::string(const std::string &)> &func)
+    : m_Function(func) {}
+
+std::string FunctionWithArgCmd::execute() { return m_Function(m_Argument); }
+
+std::string FunctionWithArgCmd::doParseArguments(std::istream &stream) {
+  stream >> m_Argument;
+  return {};
+}
+
 SuggestParam::SuggestParam(const Parameters &params) : params(params) {}
 
 std::string SuggestParam::execute() {
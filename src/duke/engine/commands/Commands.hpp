@@ -58,6 +58,17 @@ class FunctionCmd : public Command {
   virtual std::string execute();
 };
 
+// The argument is optional, it is empty when omitted.
+class FunctionWithArgCmd : public Command {
+  const std::function<std::string(const std::string &)> m_Function;
+  std::string m_Argument;
+
+ public:
+  FunctionWithArgCmd(const std::function<std::string(const std::string &)> &func);
+  virtual std::string execute();
+  virtual std::string doParseArguments(std::istream &stream);
+};
+
 class SuggestParam : public Command {
   std::string value;
   const Parameters &params;
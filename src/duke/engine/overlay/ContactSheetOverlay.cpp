@@ -0,0 +1,169 @@
+#include "ContactSheetOverlay.hpp"
+#include <duke/engine/Context.hpp>
+#include <duke/engine/Thumbnails.hpp>
+#include <duke/engine/rendering/GlyphRenderer.hpp>
+#include <duke/engine/rendering/ShaderConstants.hpp>
+#include <duke/gl/RenderState.hpp>
+
+namespace duke {
+
+namespace {
+
+const size_t kPageSize = 2048;
+const int kMargin = 16;
+const int kLabelHeight = 16;
+
+// Uniform names, the program caches locations by pointer.
+const char gColor[] = "gColor";
+const char gTextured[] = "gTextured";
+
+// Vertices are in pixels, uvs in the atlas page.
+const char pThumbnailVertexShader[] = R"(
+#version 330
+
+layout (location = 0) in vec3 Position;
+layout (location = 1) in vec2 UV;
+
+uniform ivec2 gViewport;
+
+out vec2 vUV;
+
+void main() {
+    gl_Position = vec4(Position.xy / vec2(gViewport) * 2. - 1., 0., 1.);
+    vUV = UV;
+})";
+
+const char pThumbnailFragmentShader[] = R"(#version 330
+
+out vec4 vFragColor;
+uniform sampler2D gTextureSampler;
+uniform bool gTextured;
+uniform vec4 gColor;
+in vec2 vUV;
+
+void main(void)
+{
+    vFragColor = gTextured ? vec4(texture(gTextureSampler, vUV).rgb, 1.) : gColor;
+})";
+
+std::string fitLabel(const std::string &label, int width) {
+  const size_t maxChars = std::max(1, width / 8);
+  if (label.size() <= maxChars) return label;
+  return ".." + label.substr(label.size() - maxChars + 2);
+}
+
+}  // namespace
+
+ContactSheetOverlay::ContactSheetOverlay(const GlyphRenderer &glyphRenderer, size_t cellSize)
+    : m_GlyphRenderer(glyphRenderer),
+      m_Atlas{kPageSize, cellSize},
+      m_Grid{int(cellSize), kMargin, kLabelHeight},
+      m_Program(makeVertexShader(pThumbnailVertexShader), makeFragmentShader(pThumbnailFragmentShader)),
+      m_Quads(GL_TRIANGLES) {}
+
+void ContactSheetOverlay::reset(size_t count) {
+  m_Cells.assign(count, Cell());
+  m_Scroll = 0;
+}
+
+void ContactSheetOverlay::setThumbnail(size_t index, const Thumbnail &thumbnail, const std::string &label) {
+  if (index >= m_Cells.size()) return;
+  Cell &cell = m_Cells[index];
+  cell.label = label;
+  if (thumbnail.width == 0 || thumbnail.width > m_Atlas.cellSize || thumbnail.height > m_Atlas.cellSize) {
+    cell.error = true;
+    return;
+  }
+  const size_t page = m_Atlas.getPage(index);
+  while (m_Pages.size() <= page) {
+    m_Pages.emplace_back(new gl::GlTexture2D());
+    const auto bound = m_Pages.back()->scope_bind_texture();
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, kPageSize, kPageSize, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  }
+  const glm::ivec2 origin = m_Atlas.getOrigin(index);
+  const auto bound = m_Pages[page]->scope_bind_texture();
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, origin.x, origin.y, thumbnail.width, thumbnail.height, GL_RGB, GL_UNSIGNED_BYTE,
+                  thumbnail.pixels.data());
+  glCheckError();
+  cell.dimensions = glm::ivec2(thumbnail.width, thumbnail.height);
+  cell.error = false;
+}
+
+void ContactSheetOverlay::setError(size_t index, const std::string &label) {
+  if (index >= m_Cells.size()) return;
+  m_Cells[index].label = label;
+  m_Cells[index].error = true;
+}
+
+void ContactSheetOverlay::scroll(const Viewport &viewport, int pixels) {
+  const int height = m_Grid.getHeight(m_Cells.size(), viewport.dimension.x);
+  m_Scroll = std::max(0, std::min(m_Scroll + pixels, height - viewport.dimension.y));
+}
+
+int ContactSheetOverlay::getCellAt(const Viewport &viewport, glm::ivec2 position) const {
+  const int columns = m_Grid.getColumns(viewport.dimension.x);
+  position.y += m_Scroll;
+  const int column = (position.x - m_Grid.margin) / (m_Grid.cellSize + m_Grid.margin);
+  const int row = (position.y - m_Grid.margin) / m_Grid.getRowHeight();
+  if (position.x < m_Grid.margin || position.y < m_Grid.margin || column >= columns) return -1;
+  const size_t index = row * columns + column;
+  if (index >= m_Cells.size()) return -1;
+  const glm::ivec2 origin = m_Grid.getOrigin(index, viewport.dimension.x);
+  const bool inside =
+      position.x < origin.x + m_Grid.cellSize && position.y < origin.y + m_Grid.cellSize + m_Grid.labelHeight;
+  return inside ? int(index) : -1;
+}
+
+void ContactSheetOverlay::render(const Context &context) const {
+  const glm::ivec2 viewport = context.viewport.dimension;
+  const glm::vec2 cell(m_Grid.cellSize);
+  // visible cells are gathered first, then drawn with one call for the
+  // backgrounds, one per atlas page for the thumbnails and one for the text
+  std::vector<VertexPosUv0> backgrounds;
+  std::vector<std::vector<VertexPosUv0> > thumbnails(m_Pages.size());
+  std::vector<VertexPosUv0> glyphs;
+  const int columns = m_Grid.getColumns(viewport.x);
+  const int firstRow = std::max(0, (m_Scroll - m_Grid.margin) / m_Grid.getRowHeight());
+  const int lastRow = (m_Scroll + viewport.y) / m_Grid.getRowHeight();
+  const size_t end = std::min(m_Cells.size(), size_t(lastRow + 1) * columns);
+  for (size_t index = size_t(firstRow) * columns; index < end; ++index) {
+    const Cell &current = m_Cells[index];
+    const glm::ivec2 origin = m_Grid.getOrigin(index, viewport.x);
+    // bottom left of the cell, from the bottom left of the viewport
+    const glm::vec2 bottomLeft(origin.x, viewport.y - (origin.y - m_Scroll) - m_Grid.cellSize);
+    appendRect(backgrounds, bottomLeft, bottomLeft + cell, glm::vec2(0), glm::vec2(0));
+    if (current.dimensions.x != 0) {
+      const glm::vec2 dimensions(current.dimensions);
+      const glm::vec2 position = bottomLeft + glm::vec2((glm::ivec2(cell) - current.dimensions) / 2);
+      // thumbnail rows are top to bottom in the page
+      const glm::vec2 uvTopLeft = glm::vec2(m_Atlas.getOrigin(index)) / float(kPageSize);
+      const glm::vec2 uvSize = dimensions / float(kPageSize);
+      appendRect(thumbnails[m_Atlas.getPage(index)], position, position + dimensions,
+                 glm::vec2(uvTopLeft.x, uvTopLeft.y + uvSize.y), glm::vec2(uvTopLeft.x + uvSize.x, uvTopLeft.y));
+    }
+    const char *pStatus = current.error ? "error" : (current.dimensions.x == 0 ? "loading" : nullptr);
+    if (pStatus) m_GlyphRenderer.appendGlyphs(glyphs, pStatus, bottomLeft.x + 8, bottomLeft.y + cell.y / 2);
+    const std::string label = fitLabel(current.label, m_Grid.cellSize);
+    m_GlyphRenderer.appendGlyphs(glyphs, label.c_str(), bottomLeft.x + 4, bottomLeft.y - m_Grid.labelHeight / 2);
+  }
+
+  m_Program.use();
+  m_Program.glUniform2i(shader::gViewport, viewport.x, viewport.y);
+  m_Program.glUniform1i(shader::gTextureSampler, shader::IMAGE_TEXTURE_UNIT);
+  m_Program.glUniform1i(gTextured, 0);
+  m_Program.glUniform4f(gColor, .1, .1, .1, 1);
+  m_Quads.draw(backgrounds);
+  m_Program.glUniform1i(gTextured, 1);
+  gl::RenderState::current().activeTexture(shader::IMAGE_TEXTURE_UNIT);
+  for (size_t page = 0; page < thumbnails.size(); ++page) {
+    if (thumbnails[page].empty()) continue;
+    const auto bound = m_Pages[page]->scope_bind_texture();
+    m_Quads.draw(thumbnails[page]);
+  }
+  m_GlyphRenderer.drawGlyphs(context.viewport, glyphs);
+}
+
+} /* namespace duke */
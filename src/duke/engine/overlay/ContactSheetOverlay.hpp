@@ -0,0 +1,100 @@
+#pragma once
+
+#include "IOverlay.hpp"
+#include <duke/gl/GlObjects.hpp>
+#include <duke/gl/Mesh.hpp>
+#include <duke/gl/Program.hpp>
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace duke {
+
+struct Context;
+struct GlyphRenderer;
+struct Thumbnail;
+struct Viewport;
+
+// Square cells packed row major in square texture pages.
+struct AtlasLayout {
+  size_t pageSize;
+  size_t cellSize;
+
+  size_t getCellsPerRow() const { return pageSize / cellSize; }
+  size_t getCellsPerPage() const { return getCellsPerRow() * getCellsPerRow(); }
+  size_t getPage(size_t cell) const { return cell / getCellsPerPage(); }
+  // Top left texel of the cell in its page.
+  glm::ivec2 getOrigin(size_t cell) const {
+    const size_t inPage = cell % getCellsPerPage();
+    return glm::ivec2(inPage % getCellsPerRow(), inPage / getCellsPerRow()) * int(cellSize);
+  }
+};
+
+// Rows of cells filling the viewport width, a label below each thumbnail.
+struct ContactSheetGrid {
+  int cellSize;
+  int margin;
+  int labelHeight;
+
+  int getColumns(int viewportWidth) const { return std::max(1, (viewportWidth - margin) / (cellSize + margin)); }
+  int getRowHeight() const { return cellSize + labelHeight + margin; }
+  // Top left pixel of the cell, from the top left of the sheet.
+  glm::ivec2 getOrigin(size_t index, int viewportWidth) const {
+    const int columns = getColumns(viewportWidth);
+    const int column = index % columns;
+    const int row = index / columns;
+    return glm::ivec2(margin + column * (cellSize + margin), margin + row * getRowHeight());
+  }
+  int getHeight(size_t count, int viewportWidth) const {
+    const int columns = getColumns(viewportWidth);
+    return margin + (int(count) + columns - 1) / columns * getRowHeight();
+  }
+};
+
+/**
+ * Draws many thumbnails per frame from a texture atlas.
+ * - Thumbnails are uploaded once and drawn at their native size so the cells
+ *   never bleed into each other.
+ * - The sheet scrolls vertically, independently of the image pan.
+ * - Draw calls don't grow with the number of cells: one for the backgrounds,
+ *   one per atlas page and one for all the text.
+ * Must be used on the thread owning the GL context.
+ */
+class ContactSheetOverlay : public duke::IOverlay {
+ public:
+  ContactSheetOverlay(const GlyphRenderer &, size_t cellSize);
+
+  // Cells are shown as pending until set.
+  void reset(size_t count);
+  void setThumbnail(size_t index, const Thumbnail &thumbnail, const std::string &label);
+  void setError(size_t index, const std::string &label);
+
+  // Positive pixels move the sheet up, clamped to its height.
+  void scroll(const Viewport &viewport, int pixels);
+  // Index of the cell under the position, from the top left of the viewport,
+  // -1 if none.
+  int getCellAt(const Viewport &viewport, glm::ivec2 position) const;
+
+  virtual void render(const Context &) const;
+
+ private:
+  struct Cell {
+    glm::ivec2 dimensions;  // of the thumbnail, 0 until uploaded
+    std::string label;
+    bool error = false;
+  };
+
+  const GlyphRenderer &m_GlyphRenderer;
+  const AtlasLayout m_Atlas;
+  const ContactSheetGrid m_Grid;
+  mutable Program m_Program;
+  StreamMesh m_Quads;
+  std::vector<std::unique_ptr<gl::GlTexture2D> > m_Pages;
+  std::vector<Cell> m_Cells;
+  int m_Scroll = 0;
+};
+
+} /* namespace duke */
@@ -16,6 +16,12 @@ void OnScreenDisplayOverlay::setString(const Time& time, const std::string& msg)
   m_Message = msg;
 }
 
+bool OnScreenDisplayOverlay::isVisible(const Time& liveTime) const {
+  if (m_Message.empty()) return false;
+  const Time time = liveTime - m_ShowTime;
+  return interpolateValue<double>(m_Alpha, 1, 0, time.asMilliseconds()) > 0;
+}
+
 void OnScreenDisplayOverlay::render(const Context& context) const {
   Time time = context.liveTime;
   time -= m_ShowTime;
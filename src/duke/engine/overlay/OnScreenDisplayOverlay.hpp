@@ -19,6 +19,9 @@ class OnScreenDisplayOverlay : public duke::IOverlay {
 
   virtual void render(const Context&) const;
 
+  // True while the message fades out.
+  bool isVisible(const Time& liveTime) const;
+
  private:
   const GlyphRenderer& m_GlyphRenderer;
   Time m_ShowTime;
@@ -2,6 +2,7 @@
 #include <duke/engine/Context.hpp>
 #include <duke/engine/rendering/GlyphRenderer.hpp>
 #include <duke/engine/rendering/GeometryRenderer.hpp>
+#include <algorithm>
 #include <sstream>
 
 #include <duke/attributes/AttributeKeys.hpp>
@@ -9,9 +10,43 @@
 
 namespace duke {
 
+namespace {
+
+const int kSparklineHeight = 24;
+
+// One bar per sample, scaled to the largest recent sample.
+void drawSparkline(const GeometryRenderer& geometryRenderer, const glm::ivec2& viewportDim, const glm::ivec2& origin,
+                   const StatisticsOverlay::Series& series) {
+  const auto& recent = series.recent;
+  const float scale = recent.max() > 0 ? kSparklineHeight / recent.max() : 0;
+  const int width = recent.capacity();
+  geometryRenderer.drawRect(viewportDim, glm::ivec2(width, kSparklineHeight),
+                            origin + glm::ivec2(width / 2, kSparklineHeight / 2), glm::vec4(0, 0, 0, 0.5));
+  for (size_t i = 0; i < recent.size(); ++i) {
+    const int barHeight = std::max(1, int(recent[i] * scale));
+    geometryRenderer.drawRect(viewportDim, glm::ivec2(1, barHeight), origin + glm::ivec2(i, barHeight / 2),
+                              glm::vec4(1, 1, 1, 0.8));
+  }
+}
+
+void printSeries(std::ostream& stream, const char* pName, const StatisticsOverlay::Series& series) {
+  const auto& histogram = series.histogram;
+  stream << '\n' << pName << " p50 " << histogram.percentile(50) / 1000. << " p95 " << histogram.percentile(95) / 1000.
+         << " p99 " << histogram.percentile(99) / 1000. << " ms";
+}
+
+}  // namespace
+
 StatisticsOverlay::StatisticsOverlay(const GlyphRenderer& glyphRenderer, const Timeline& timeline)
     : vBlankMetronom(100), frameMetronom(10), m_GlyphRenderer(glyphRenderer), m_Timeline(timeline) {}
 
+void StatisticsOverlay::resetStatistics() {
+  for (Series* pSeries : {&decodeTimes, &uploadTimes, &renderTimes, &displayLatencies}) *pSeries = Series();
+  droppedFrames = 0;
+  repeatedRefreshes = 0;
+  lateRefreshes = 0;
+}
+
 void StatisticsOverlay::render(const Context& context) const {
     const size_t frameCount = m_Timeline.getRange().last - m_Timeline.getRange().first + 1;
     const float frameLength = context.viewport.dimension.x / (float)frameCount;
@@ -91,7 +126,20 @@ void StatisticsOverlay::render(const Context& context) const {
 #ifndef NDEBUG  // adding vblank in case in debug mode
     oss << '\n' << vBlankMetronom.getFPS() << " VBPS";
 #endif
+    printSeries(oss, "decode ", decodeTimes);
+    printSeries(oss, "upload ", uploadTimes);
+    printSeries(oss, "render ", renderTimes);
+    printSeries(oss, "latency", displayLatencies);
+    oss << '\n' << droppedFrames << " dropped, " << repeatedRefreshes << " repeated, " << lateRefreshes << " late";
     drawText(m_GlyphRenderer, context.viewport, oss.str().c_str(), 5, height + 10, 1.f, 1.f);
+
+    // draw sparklines in the same order, stacked above the timeline on the right
+    const int sparklineX = halfViewportDim.x - int(decodeTimes.recent.capacity()) - 5;
+    int sparklineY = yOffset + height;
+    for (const Series* pSeries : {&displayLatencies, &renderTimes, &uploadTimes, &decodeTimes}) {
+        drawSparkline(geometryRenderer, context.viewport.dimension, glm::ivec2(sparklineX, sparklineY), *pSeries);
+        sparklineY += kSparklineHeight + 4;
+    }
 }
 
 } /* namespace duke */
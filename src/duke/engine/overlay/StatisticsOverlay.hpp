@@ -3,6 +3,7 @@
 #include "IOverlay.hpp"
 #include <duke/engine/Timeline.hpp>
 #include <duke/time/Clock.hpp>
+#include <duke/time/LatencyHistogram.hpp>
 
 namespace duke {
 
@@ -15,9 +16,28 @@ class StatisticsOverlay : public duke::IOverlay {
 
   virtual void render(const Context&) const;
 
+  // Distribution since the last reset and latest samples of one pipeline stage.
+  struct Series {
+    LatencyHistogram histogram;
+    SampleRing<120> recent;  // milliseconds
+    void record(uint64_t microseconds) {
+      histogram.record(microseconds);
+      recent.push(microseconds / 1000.f);
+    }
+  };
+
+  void resetStatistics();
+
   std::map<const IMediaStream*, std::vector<Range> > cacheState;
   Metronom vBlankMetronom;
   Metronom frameMetronom;
+  Series decodeTimes;
+  Series uploadTimes;
+  Series renderTimes;
+  Series displayLatencies;  // from the frame being due to it being displayed
+  size_t droppedFrames = 0;
+  size_t repeatedRefreshes = 0;
+  size_t lateRefreshes = 0;
 
  private:
   const GlyphRenderer& m_GlyphRenderer;
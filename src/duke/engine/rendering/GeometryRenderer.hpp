@@ -8,6 +8,8 @@
 namespace duke {
 
 struct GeometryRenderer : public noncopyable {
+  explicit GeometryRenderer(const std::string &shaderCacheDirectory) : shaderPool(shaderCacheDirectory) {}
+
   void drawRect(const glm::ivec2 &viewport, const glm::ivec2 &dimensions, const glm::ivec2 &pan,
                 const glm::vec4 &color) const;
   void drawLine(const glm::ivec2 &viewport, const glm::ivec2 &dimensions, const glm::ivec2 &pan,
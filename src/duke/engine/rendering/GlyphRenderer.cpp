@@ -6,6 +6,9 @@
 #include <duke/engine/rendering/MeshPool.hpp>
 #include <duke/engine/rendering/ShaderConstants.hpp>
 
+#include <cstdlib>
+#include <utility>
+
 namespace duke {
 
 namespace {
@@ -72,6 +75,22 @@ void main() {
     vVaryingTexCoord = charDim*(UV+charPos);
 })";
 
+// Vertices are in pixels, uvs in texels of the glyphs texture.
+const char pBatchVertexShader[] = R"(
+#version 330
+
+layout (location = 0) in vec3 Position;
+layout (location = 1) in vec2 UV;
+
+uniform ivec2 gViewport;
+
+out vec2 vVaryingTexCoord;
+
+void main() {
+    gl_Position = vec4(Position.xy / vec2(gViewport) * 2. - 1., 0., 1.);
+    vVaryingTexCoord = UV;
+})";
+
 const char pTextFragmentShader[] = R"(#version 330
 
 out vec4 vFragColor;
@@ -90,7 +109,9 @@ void main(void)
 
 GlyphRenderer::GlyphRenderer(const GeometryRenderer &renderer, const char *glyphsFilename)
     : m_GeometryRenderer(renderer),  //
-      m_Program(makeVertexShader(pTextVertexShader), makeFragmentShader(pTextFragmentShader)) {
+      m_Program(makeVertexShader(pTextVertexShader), makeFragmentShader(pTextFragmentShader)),
+      m_BatchProgram(makeVertexShader(pBatchVertexShader), makeFragmentShader(pTextFragmentShader)),
+      m_Batch(GL_TRIANGLES) {
   ReadFrameResult result = load(glyphsFilename, m_GlyphsTexture);
   if (result) {
     m_Attributes = result.frame.attributes;
@@ -121,6 +142,36 @@ void GlyphRenderer::draw(int x, int y, const char glyph) const {
   m_GeometryRenderer.meshPool.getSquare()->draw();
 }
 
+void GlyphRenderer::appendGlyphs(std::vector<VertexPosUv0> &vertices, const char *pText, int x, int y) const {
+  if (pText == nullptr) return;
+  const auto pair = getTextureDimensions(m_GlyphsTexture.description.width, m_GlyphsTexture.description.height,
+                                         attribute::getWithDefault<attribute::DpxImageOrientation>(m_Attributes));
+  const glm::vec2 charDim = glm::vec2(std::abs(pair.first), std::abs(pair.second)) / 16.f;
+  for (; *pText != '\0'; ++pText, x += 8) {
+    const unsigned char c = *pText;
+    const glm::vec2 charPos(c % 16, c / 16);
+    glm::vec2 uvBottomLeft = charPos * charDim;
+    glm::vec2 uvTopRight = (charPos + 1.f) * charDim;
+    // same orientation as the square mesh scaled by a negative gImage in draw()
+    if (pair.first < 0) std::swap(uvBottomLeft.x, uvTopRight.x);
+    if (pair.second < 0) std::swap(uvBottomLeft.y, uvTopRight.y);
+    const glm::vec2 center(x, y);
+    appendRect(vertices, center - charDim / 2.f, center + charDim / 2.f, uvBottomLeft, uvTopRight);
+  }
+}
+
+void GlyphRenderer::drawGlyphs(const Viewport &viewport, const std::vector<VertexPosUv0> &vertices, float alpha) const {
+  if (vertices.empty()) return;
+  m_BatchProgram.use();
+  m_BatchProgram.glUniform2i(shader::gViewport, viewport.dimension.x, viewport.dimension.y);
+  m_BatchProgram.glUniform1i(shader::gTextureSampler, 0);
+  m_BatchProgram.glUniform1f(shader::gAlpha, alpha);
+  const auto bound = m_GlyphsTexture.scope_bind_texture();
+  glTexParameteri(m_GlyphsTexture.target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(m_GlyphsTexture.target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  m_Batch.draw(vertices);
+}
+
 const GeometryRenderer &GlyphRenderer::getGeometryRenderer() const { return m_GeometryRenderer; }
 
 namespace {
@@ -6,6 +6,8 @@
 #include <duke/gl/Mesh.hpp>
 #include <duke/attributes/Attributes.hpp>
 
+#include <vector>
+
 namespace duke {
 
 struct Viewport;
@@ -19,11 +21,18 @@ struct GlyphRenderer : public noncopyable {
   void setZoom(float zoom) const;
   void draw(int x, int y, const char glyph) const;
 
+  // Appends the glyphs of a single line as drawText places them, to draw many
+  // texts with a single drawGlyphs call.
+  void appendGlyphs(std::vector<VertexPosUv0> &vertices, const char *pText, int x, int y) const;
+  void drawGlyphs(const Viewport &viewport, const std::vector<VertexPosUv0> &vertices, float alpha = 1) const;
+
   const GeometryRenderer &getGeometryRenderer() const;
 
  private:
   const GeometryRenderer &m_GeometryRenderer;
   mutable Program m_Program;
+  mutable Program m_BatchProgram;
+  StreamMesh m_Batch;
   attribute::Attributes m_Attributes;
   Texture m_GlyphsTexture;
 
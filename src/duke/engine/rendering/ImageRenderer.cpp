@@ -3,6 +3,7 @@
 #include <duke/attributes/Attributes.hpp>
 #include <duke/attributes/AttributeKeys.hpp>
 #include <duke/engine/Context.hpp>
+#include <duke/engine/cache/TileLayout.hpp>
 #include <duke/engine/rendering/ShaderFactory.hpp>
 #include <duke/engine/rendering/ShaderPool.hpp>
 #include <duke/engine/rendering/ShaderConstants.hpp>
@@ -17,17 +18,15 @@ namespace duke {
 
 namespace {
 
-ColorSpace resolve(const attribute::Attributes &attributes, ColorSpace original) {
-    if (original != ColorSpace::linear) return original;
-    original = resolveFromName(attribute::getWithDefault<attribute::OiioColorspace>(attributes));
-    if (original != ColorSpace::linear) return original;
-    return resolveFromExtension(fileExtension(attribute::getOrDie<attribute::File>(attributes)));
-}
-
 inline float getAspectRatio(glm::vec2 dim) {
     return dim.x / dim.y;
 }
 
+// Ratio between the full resolution image and the decoded one.
+inline float getProxyScale(const attribute::Attributes &attributes) {
+    return 1 << attribute::getWithDefault<attribute::ProxyLevel>(attributes);
+}
+
 }  // namespace
 
 float getPixelRatio(const Context &context) {
@@ -50,7 +49,8 @@ float getZoomValue(const Context &context) {
     const auto viewportDim = glm::vec2(context.viewport.dimension);
     const auto viewportAspect = getAspectRatio(viewportDim);
     const auto &imageDescription = context.pCurrentImage->description;
-    const auto imageDim = glm::vec2(imageDescription.width, imageDescription.height);
+    const auto imageDim = glm::vec2(imageDescription.width, imageDescription.height) *
+                          getProxyScale(context.pCurrentImage->attributes);
     const auto imageAspect = getAspectRatio(imageDim);
     switch (context.fitMode) {
     case FitMode::INNER:
@@ -64,6 +64,32 @@ float getZoomValue(const Context &context) {
     }
 }
 
+Region getVisibleRegion(const Context &context) {
+    if (!context.pCurrentImage) return Region();
+    const auto &image = *context.pCurrentImage;
+    const auto &description = image.description;
+    const auto imageDim = glm::vec2(description.width, description.height) * getProxyScale(image.attributes);
+    // on screen image rectangle, as computed by the vertex shader
+    const auto size = glm::vec2(imageDim.x, imageDim.y / getPixelRatio(context)) * context.zoom;
+    const auto center = glm::vec2(context.viewport.dimension / 2 + context.pan);
+    const auto bottomLeft = center - size / 2.f;
+    const auto viewportDim = glm::vec2(context.viewport.dimension);
+    // visible part in [0,1], from the bottom left corner of the image
+    const auto first = glm::clamp(-bottomLeft / size, 0.f, 1.f);
+    const auto last = glm::clamp((viewportDim - bottomLeft) / size, 0.f, 1.f);
+    const auto orientation = attribute::getWithDefault<attribute::DpxImageOrientation>(image.attributes);
+    const bool firstScanlineOnTop = getTextureDimensions(description.width, description.height, orientation).second < 0;
+    if (firstScanlineOnTop) return Region::fromNormalized(first.x, 1 - last.y, last.x, 1 - first.y);
+    return Region::fromNormalized(first.x, first.y, last.x, last.y);
+}
+
+uint8_t getProxyLevel(float zoom) {
+    uint8_t level = 0;
+    // keeping at least one texel per screen pixel
+    while (level < MAX_PROXY_LEVEL && zoom * (2 << level) <= 1) ++level;
+    return level;
+}
+
 namespace {
 
 bool isGreyscale(size_t glPackFormat) {
@@ -82,44 +108,65 @@ bool isGreyscale(size_t glPackFormat) {
 
 }  // namespace
 
-void renderWithBoundTexture(const ShaderPool &shaderPool, const Mesh *pMesh, const Context &context, std::string OCIOoutput, bool OCIOflag_raw) {
+void renderWithBoundTexture(const ShaderPool &shaderPool, const Mesh *pMesh, const Context &context, std::string OCIOoutput, bool OCIOflag_raw, const TileRect *pTile, bool mipmapped) {
 
     const auto &description = context.pCurrentImage->description;
     bool redBlueSwapped = description.swapRedAndBlue;
     if (isInternalOptimizedFormatRedBlueSwapped(description.glFormat)) redBlueSwapped = !redBlueSwapped;
 
     const auto &currentImageAttributes = context.pCurrentImage->attributes;
-    const auto inputColorSpace = resolve(currentImageAttributes, context.fileColorSpace);
+    const auto inputColorSpace = resolveColorSpace(currentImageAttributes, context.fileColorSpace);
 
     const ShaderDescription shaderDesc = ShaderDescription::createTextureDesc(  //
             isGreyscale(description.glFormat),                                      //
             description.swapEndianness,                                             //
             redBlueSwapped,                                                         //
             description.glFormat == GL_RGB10_A2UI,                                  //
-            inputColorSpace, context.screenColorSpace, OCIOoutput);
+            inputColorSpace, context.screenColorSpace, OCIOoutput, mipmapped);
     const auto pProgram = shaderPool.get(shaderDesc);
-    const auto pair =
-        getTextureDimensions(description.width, description.height,
-                             attribute::getWithDefault<attribute::DpxImageOrientation>(currentImageAttributes));
-    pProgram->use();
-    pProgram->glUniform2i(shader::gImage, pair.first, pair.second);
-    pProgram->glUniform2i(shader::gViewport, context.viewport.dimension.x, context.viewport.dimension.y);
-    pProgram->glUniform1i(shader::gTextureSampler, 0);
-    pProgram->glUniform2i(shader::gPan, context.pan.x, context.pan.y);
-    pProgram->glUniform1f(shader::gExposure, context.exposure);
-    pProgram->glUniform1f(shader::gGamma, context.gamma);
-    pProgram->glUniform4i(shader::gShowChannel, context.channels.x, context.channels.y, context.channels.z,
-                          context.channels.w);
-
-    pProgram->glUniform1f(shader::gZoom, context.zoom);
-    pProgram->glUniform1f("pixelRatio", getPixelRatio(context) ); // Texture unit 1
-
-    // 3d lut
-    if (OCIOflag_raw==false)
-    {
-	pProgram->glUniform1i("lut3d", 2); // Texture unit 1
+    ImageUniforms uniforms;
+    const auto orientation = attribute::getWithDefault<attribute::DpxImageOrientation>(currentImageAttributes);
+    const auto pair = pTile ? getTextureDimensions(pTile->width, pTile->height, orientation)
+                            : getTextureDimensions(description.width, description.height, orientation);
+    glm::vec2 tileOffset(0.f);
+    if (pTile) {
+        tileOffset.x = pTile->x + pTile->width / 2.f - description.width / 2.f;
+        tileOffset.y = pTile->y + pTile->height / 2.f - description.height / 2.f;
+        if (pair.second < 0) tileOffset.y = -tileOffset.y; // first scanline on top
     }
-    
+    setSwizzle(uniforms, shaderDesc.grayscale, shaderDesc.swapRedAndBlue, shaderDesc.swapEndianness);
+    uniforms.viewport[0] = context.viewport.dimension.x;
+    uniforms.viewport[1] = context.viewport.dimension.y;
+    uniforms.image[0] = pair.first;
+    uniforms.image[1] = pair.second;
+    uniforms.pan[0] = context.pan.x;
+    uniforms.pan[1] = context.pan.y;
+    uniforms.tileOffset[0] = tileOffset.x;
+    uniforms.tileOffset[1] = tileOffset.y;
+    uniforms.showChannel[0] = context.channels.x;
+    uniforms.showChannel[1] = context.channels.y;
+    uniforms.showChannel[2] = context.channels.z;
+    uniforms.showChannel[3] = context.channels.w;
+    uniforms.zoom = context.zoom * getProxyScale(currentImageAttributes);
+    uniforms.pixelRatio = getPixelRatio(context);
+    uniforms.exposure = context.exposure;
+    uniforms.gamma = context.gamma;
+    // in texels of the bound texture, a tile starts at its own origin
+    const GLint dataLeft = description.isPartial() ? description.dataX : 0;
+    const GLint dataTop = description.isPartial() ? description.dataY : 0;
+    const GLint originX = pTile ? pTile->x : 0;
+    const GLint originY = pTile ? pTile->y : 0;
+    uniforms.dataWindow[0] = dataLeft - originX;
+    uniforms.dataWindow[1] = dataTop - originY;
+    uniforms.dataWindow[2] = dataLeft + GLint(description.getDataWidth()) - originX;
+    uniforms.dataWindow[3] = dataTop + GLint(description.getDataHeight()) - originY;
+    shaderPool.getImageUniforms().update(uniforms);
+
+    pProgram->use();
+    pProgram->glUniform1i(shader::gTextureSampler, shader::IMAGE_TEXTURE_UNIT);
+    if (!OCIOflag_raw) pProgram->glUniform1i(shader::gLut3d, shader::LUT3D_TEXTURE_UNIT);
+
+
     pMesh->draw();
     glCheckError();
 }
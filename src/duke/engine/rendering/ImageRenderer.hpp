@@ -1,12 +1,20 @@
 #pragma once
 #include <duke/OpenColorIO/OpenColorIOManager.hpp>
+#include <duke/engine/streams/MediaFrameReference.hpp>
 
 namespace duke {
 
 class Mesh;
 struct Context;
 struct ShaderPool;
-void renderWithBoundTexture(const ShaderPool &shaderPool, const Mesh *pMesh,  const Context &context, std::string OCIOoutput, bool OCIOflag_raw);
+struct TileRect;
+// pTile is the part of the current image held by the bound texture, nullptr for the whole image.
+// mipmapped is set when the bound texture is a GL_TEXTURE_2D with a mip chain.
+void renderWithBoundTexture(const ShaderPool &shaderPool, const Mesh *pMesh,  const Context &context, std::string OCIOoutput, bool OCIOflag_raw, const TileRect *pTile = nullptr, bool mipmapped = false);
 float getZoomValue(const Context &context);
+// The coarsest proxy level still displaying at least one texel per screen pixel.
+uint8_t getProxyLevel(float zoom);
+// The part of the current image visible in the viewport.
+Region getVisibleRegion(const Context &context);
 
 } /* namespace duke */
@@ -0,0 +1,51 @@
+#include "ImageUniforms.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace duke {
+
+const char ImageUniformBuffer::BLOCK_NAME[] = "DukeImage";
+const GLuint ImageUniformBuffer::BINDING;
+const size_t ImageUniformBuffer::BLOCK_COUNT;
+
+void setSwizzle(ImageUniforms& uniforms, bool grayscale, bool swapRedAndBlue, bool swapEndianness) {
+  GLint* const pSwizzle = uniforms.swizzle;
+  if (grayscale) {
+    pSwizzle[0] = pSwizzle[1] = pSwizzle[2] = 0;
+    pSwizzle[3] = 3;
+  } else {
+    for (GLint i = 0; i < 4; ++i) pSwizzle[i] = i;
+  }
+  if (swapRedAndBlue) std::swap(pSwizzle[0], pSwizzle[2]);
+  if (swapEndianness) std::reverse(pSwizzle, pSwizzle + 4);
+}
+
+size_t getAlignedStride(size_t blockSize, size_t alignment) {
+  if (alignment == 0) return blockSize;
+  return (blockSize + alignment - 1) / alignment * alignment;
+}
+
+void ImageUniformBuffer::update(const ImageUniforms& uniforms) {
+  if (m_Stride == 0 || memcmp(&m_Uploaded, &uniforms, sizeof(uniforms)) != 0) {
+    const auto bound = m_Buffer.scope_bind_buffer();
+    if (m_Stride == 0) {
+      GLint alignment = 0;
+      glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+      m_Stride = getAlignedStride(sizeof(uniforms), alignment);
+    }
+    // pending draws keep the orphaned storage
+    if (m_Next == 0) glBufferData(GL_UNIFORM_BUFFER, m_Stride * BLOCK_COUNT, nullptr, m_Buffer.usage);
+    m_Offset = m_Next * m_Stride;
+    // no draw reads this block since the storage was orphaned, no need to synchronize
+    void* pBlock = glMapBufferRange(GL_UNIFORM_BUFFER, m_Offset, sizeof(uniforms),
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    memcpy(pBlock, &uniforms, sizeof(uniforms));
+    glUnmapBuffer(GL_UNIFORM_BUFFER);
+    m_Next = (m_Next + 1) % BLOCK_COUNT;
+    m_Uploaded = uniforms;
+  }
+  glBindBufferRange(GL_UNIFORM_BUFFER, BINDING, m_Buffer.id, m_Offset, sizeof(uniforms));
+}
+
+}  // namespace duke
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <duke/base/NonCopyable.hpp>
+#include <duke/gl/GlObjects.hpp>
+
+namespace duke {
+
+/**
+ * The per draw state of the image programs, mirrors the std140 layout of the
+ * 'DukeImage' uniform block declared in ShaderFactory.
+ * The format flags live here as well so images of different formats share
+ * the same program.
+ */
+struct ImageUniforms {
+  GLint swizzle[4];  // source component for each of r, g, b, a
+  GLint viewport[2];
+  GLint image[2];
+  GLint pan[2];
+  GLfloat tileOffset[2];
+  GLint showChannel[4];
+  GLfloat zoom;
+  GLfloat pixelRatio;
+  GLfloat exposure;
+  GLfloat gamma;
+  // Texels holding decoded data as left, top, right, bottom, the draw is black
+  // outside: a region of interest only fills part of a pooled texture.
+  GLint dataWindow[4];
+};
+
+static_assert(sizeof(ImageUniforms) == 96, "ImageUniforms must match the DukeImage std140 layout");
+
+void setSwizzle(ImageUniforms& uniforms, bool grayscale, bool swapRedAndBlue, bool swapEndianness);
+
+// Block size rounded up to GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+size_t getAlignedStride(size_t blockSize, size_t alignment);
+
+/**
+ * The uniform buffer holding the DukeImage block, uploads only when the state
+ * changes.
+ * - Each upload writes the next block of a ring and binds it with
+ *   glBindBufferRange, draws still reading the previous blocks don't stall it.
+ * - The storage is orphaned when the ring wraps around.
+ */
+struct ImageUniformBuffer : public noncopyable {
+  static const char BLOCK_NAME[];
+  static const GLuint BINDING = 0;
+  static const size_t BLOCK_COUNT = 256;
+
+  void update(const ImageUniforms& uniforms);
+
+ private:
+  gl::GlDynamicUbo m_Buffer;
+  ImageUniforms m_Uploaded;
+  size_t m_Stride = 0;    // 0 until allocated
+  size_t m_Next = 0;      // block written by the next upload
+  GLintptr m_Offset = 0;  // of the block last written
+};
+
+} /* namespace duke */
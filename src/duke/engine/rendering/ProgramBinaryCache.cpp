@@ -0,0 +1,136 @@
+#include "ProgramBinaryCache.hpp"
+
+#include <duke/filesystem/FsUtils.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace duke {
+
+namespace {
+
+const char kMagic[4] = {'D', 'K', 'P', 'B'};
+const long kMaxBinarySize = 64 << 20;
+const char kVariantsFile[] = "variants";
+const size_t kMaxVariants = 64;
+
+void fnv1a(uint64_t& hash, const std::string& value) {
+  for (const char c : value) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  hash ^= 0xff;  // separator, so that ("ab", "c") and ("a", "bc") differ
+  hash *= 1099511628211ULL;
+}
+
+std::string getGlString(GLenum name) {
+  const GLubyte* pString = glGetString(name);
+  return pString ? reinterpret_cast<const char*>(pString) : "";
+}
+
+std::string getDriver() {
+  return getGlString(GL_VENDOR) + '\n' + getGlString(GL_RENDERER) + '\n' + getGlString(GL_VERSION);
+}
+
+}  // namespace
+
+uint64_t hashProgramSources(const std::string& driver, const std::string& vertexSource,
+                            const std::string& fragmentSource) {
+  uint64_t hash = 14695981039346656037ULL;
+  fnv1a(hash, driver);
+  fnv1a(hash, vertexSource);
+  fnv1a(hash, fragmentSource);
+  return hash;
+}
+
+bool writeProgramBinary(const std::string& filename, const ProgramBinary& binary) {
+  return writeFileAtomically(filename, [&](FILE* pFile) {
+    const uint32_t format = binary.format;
+    return fwrite(kMagic, sizeof(kMagic), 1, pFile) == 1 && fwrite(&format, sizeof(format), 1, pFile) == 1 &&
+           fwrite(binary.data.data(), 1, binary.data.size(), pFile) == binary.data.size();
+  });
+}
+
+bool readProgramBinary(const std::string& filename, ProgramBinary& binary) {
+  FILE* pFile = fopen(filename.c_str(), "rb");
+  if (!pFile) return false;
+  char magic[sizeof(kMagic)];
+  uint32_t format = 0;
+  bool valid = fread(magic, sizeof(magic), 1, pFile) == 1 && memcmp(magic, kMagic, sizeof(kMagic)) == 0 &&
+               fread(&format, sizeof(format), 1, pFile) == 1;
+  const long headerSize = sizeof(kMagic) + sizeof(format);
+  long size = 0;
+  if (valid && fseek(pFile, 0, SEEK_END) == 0) size = ftell(pFile) - headerSize;
+  valid = valid && size > 0 && size <= kMaxBinarySize && fseek(pFile, headerSize, SEEK_SET) == 0;
+  if (valid) {
+    binary.format = format;
+    binary.data.resize(size);
+    valid = fread(binary.data.data(), 1, size, pFile) == size_t(size);
+  }
+  fclose(pFile);
+  return valid;
+}
+
+ProgramBinaryCache::ProgramBinaryCache(const std::string& directory) {
+  if (createDirectories(directory)) m_Directory = directory;
+}
+
+std::string ProgramBinaryCache::getDefaultDirectory() {
+  const std::string userCache = getUserCacheDirectory();
+  return userCache.empty() ? userCache : userCache + "/duke/programs";
+}
+
+std::string ProgramBinaryCache::getFilename(const std::string& vertexSource,
+                                            const std::string& fragmentSource) const {
+  char name[32];
+  snprintf(name, sizeof(name), "/%016llx.bin",
+           static_cast<unsigned long long>(hashProgramSources(getDriver(), vertexSource, fragmentSource)));
+  return m_Directory + name;
+}
+
+SharedProgram ProgramBinaryCache::load(const std::string& vertexSource, const std::string& fragmentSource) const {
+  if (!isEnabled() || !Program::isBinarySupported()) return nullptr;
+  const std::string filename = getFilename(vertexSource, fragmentSource);
+  ProgramBinary binary;
+  if (!readProgramBinary(filename, binary)) return nullptr;
+  try {
+    return std::make_shared<Program>(binary);
+  } catch (const std::runtime_error&) {
+    unlink(filename.c_str());  // stale binary, eg. the driver was updated
+    return nullptr;
+  }
+}
+
+void ProgramBinaryCache::store(const std::string& vertexSource, const std::string& fragmentSource,
+                               const Program& program) const {
+  if (!isEnabled()) return;
+  ProgramBinary binary;
+  if (program.getBinary(binary)) writeProgramBinary(getFilename(vertexSource, fragmentSource), binary);
+}
+
+std::vector<ShaderDescription> ProgramBinaryCache::loadVariants() const {
+  std::vector<ShaderDescription> variants;
+  if (!isEnabled()) return variants;
+  std::ifstream stream(m_Directory + '/' + kVariantsFile, std::ios::binary);
+  ShaderDescription description;
+  while (variants.size() < kMaxVariants && read(stream, description)) variants.push_back(description);
+  return variants;
+}
+
+void ProgramBinaryCache::storeVariants(const std::vector<ShaderDescription>& variants) const {
+  if (!isEnabled()) return;
+  std::string content;
+  {
+    std::ostringstream stream;
+    for (size_t i = 0; i < variants.size() && i < kMaxVariants; ++i) write(stream, variants[i]);
+    content = stream.str();
+  }
+  writeFileAtomically(m_Directory + '/' + kVariantsFile,
+                      [&](FILE* pFile) { return fwrite(content.data(), 1, content.size(), pFile) == content.size(); });
+}
+
+} /* namespace duke */
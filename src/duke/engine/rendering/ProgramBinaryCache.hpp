@@ -0,0 +1,48 @@
+#pragma once
+
+#include <duke/engine/rendering/ShaderFactory.hpp>
+
+#include <string>
+#include <vector>
+
+namespace duke {
+
+/**
+ * Linked programs saved on disk with glGetProgramBinary.
+ *
+ * A program is keyed by a hash of its sources and of the GL vendor, renderer
+ * and version strings so a driver update invalidates the cache. Binaries
+ * rejected by the driver are deleted and rebuilt from source.
+ *
+ * The cache also remembers the shader variants of the last sessions so they
+ * can be built ahead of time.
+ */
+struct ProgramBinaryCache {
+  // The cache is disabled if the directory is empty or can't be created.
+  explicit ProgramBinaryCache(const std::string& directory);
+
+  static std::string getDefaultDirectory();
+
+  bool isEnabled() const { return !m_Directory.empty(); }
+
+  // The context the program will be used with must be current.
+  SharedProgram load(const std::string& vertexSource, const std::string& fragmentSource) const;
+  void store(const std::string& vertexSource, const std::string& fragmentSource, const Program& program) const;
+
+  std::vector<ShaderDescription> loadVariants() const;
+  void storeVariants(const std::vector<ShaderDescription>& variants) const;
+
+ private:
+  std::string getFilename(const std::string& vertexSource, const std::string& fragmentSource) const;
+
+  std::string m_Directory;
+};
+
+uint64_t hashProgramSources(const std::string& driver, const std::string& vertexSource,
+                            const std::string& fragmentSource);
+
+// Binary files start with a magic number and the binary format.
+bool writeProgramBinary(const std::string& filename, const ProgramBinary& binary);
+bool readProgramBinary(const std::string& filename, ProgramBinary& binary);
+
+} /* namespace duke */
@@ -7,6 +7,7 @@ const char gTextureSampler[] = "gTextureSampler";
 const char gViewport[] = "gViewport";
 const char gImage[] = "gImage";
 const char gPan[] = "gPan";
+const char gTileOffset[] = "gTileOffset";
 const char gPanAndChar[] = "gPanAndChar";
 const char gZoom[] = "gZoom";
 const char gAlpha[] = "gAlpha";
@@ -14,6 +15,7 @@ const char gExposure[] = "gExposure";
 const char gGamma[] = "gGamma";
 const char gShowChannel[] = "gShowChannel";
 const char gSolidColor[] = "gSolidColor";
+const char gLut3d[] = "lut3d";
 
 } /* namespace shader */
 } /* namespace duke */
@@ -7,6 +7,7 @@ extern const char gTextureSampler[];
 extern const char gViewport[];
 extern const char gImage[];
 extern const char gPan[];
+extern const char gTileOffset[];
 extern const char gPanAndChar[];
 extern const char gZoom[];
 extern const char gAlpha[];
@@ -14,6 +15,10 @@ extern const char gExposure[];
 extern const char gGamma[];
 extern const char gShowChannel[];
 extern const char gSolidColor[];
+extern const char gLut3d[];
+
+// Texture units are fixed so the samplers never need to be set again.
+enum TextureUnit { IMAGE_TEXTURE_UNIT = 0, LUT3D_TEXTURE_UNIT = 2 };
 
 } /* namespace shader */
 } /* namespace duke */
@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include <tuple>
 #include <duke/engine/commands/Commands.hpp>
+#include <duke/engine/rendering/ImageUniforms.hpp>
 
 using namespace std;
 
@@ -15,9 +16,9 @@ namespace duke {
 
 namespace {
 
-  std::tuple<bool, bool, bool, bool, bool, bool, ColorSpace, ColorSpace, string> asTuple(const ShaderDescription &sd) {
+  std::tuple<bool, bool, bool, bool, bool, bool, bool, ColorSpace, ColorSpace, string> asTuple(const ShaderDescription &sd) {
     return std::make_tuple(sd.grayscale, sd.sampleTexture, sd.displayUv, sd.swapEndianness, sd.swapRedAndBlue,
-                           sd.tenBitUnpack, sd.fileColorspace, sd.screenColorspace, sd.OCIOoutput);
+                           sd.tenBitUnpack, sd.mipmapped, sd.fileColorspace, sd.screenColorspace, sd.OCIOoutput);
 }
 
 }  // namespace
@@ -26,6 +27,30 @@ bool ShaderDescription::operator<(const ShaderDescription &other) const {
     return asTuple(*this) < asTuple(other);
 }
 
+void write(std::ostream &stream, const ShaderDescription &sd) {
+    stream << sd.sampleTexture << ' ' << sd.displayUv << ' ' << sd.grayscale << ' ' << sd.swapEndianness << ' '
+           << sd.swapRedAndBlue << ' ' << sd.tenBitUnpack << ' ' << sd.mipmapped << ' '
+           << int(sd.fileColorspace) << ' ' << int(sd.screenColorspace) << ' ' << sd.OCIOoutput.size() << '\n'
+           << sd.OCIOoutput << '\n';
+}
+
+bool read(std::istream &stream, ShaderDescription &sd) {
+    int fileColorspace = 0, screenColorspace = 0;
+    size_t OCIOsize = 0;
+    stream >> sd.sampleTexture >> sd.displayUv >> sd.grayscale >> sd.swapEndianness >> sd.swapRedAndBlue >>
+        sd.tenBitUnpack >> sd.mipmapped >> fileColorspace >> screenColorspace >> OCIOsize;
+    if (!stream || stream.get() != '\n' || OCIOsize > (1 << 20)) return false;
+    const int lastColorspace = int(ColorSpace::Gamma22);
+    if (fileColorspace < 0 || fileColorspace > lastColorspace || screenColorspace < 0 ||
+        screenColorspace > lastColorspace)
+        return false;
+    sd.fileColorspace = ColorSpace(fileColorspace);
+    sd.screenColorspace = ColorSpace(screenColorspace);
+    sd.OCIOoutput.resize(OCIOsize);
+    if (OCIOsize > 0) stream.read(&sd.OCIOoutput[0], OCIOsize);
+    return stream && stream.get() == '\n';
+}
+
 ShaderDescription ShaderDescription::createUvDesc() {
     ShaderDescription description;
     description.sampleTexture = false;
@@ -41,13 +66,15 @@ ShaderDescription ShaderDescription::createSolidDesc() {
 
 ShaderDescription ShaderDescription::createTextureDesc(bool grayscale, bool swapEndianness, bool swapRedAndBlue,
         bool tenBitUnpack, ColorSpace fileColorspace,
-						       ColorSpace screenColorspace,  std::string OCIOoutput) {
+						       ColorSpace screenColorspace,  std::string OCIOoutput,
+        bool mipmapped) {
     ShaderDescription description;
     description.grayscale = grayscale;
     description.sampleTexture = true;
     description.swapEndianness = swapEndianness;
     description.swapRedAndBlue = swapRedAndBlue;
     description.tenBitUnpack = tenBitUnpack;
+    description.mipmapped = mipmapped;
     description.fileColorspace = fileColorspace;
     description.screenColorspace = screenColorspace;
     description.OCIOoutput = OCIOoutput;
@@ -56,6 +83,32 @@ ShaderDescription ShaderDescription::createTextureDesc(bool grayscale, bool swap
 
 namespace {
 
+// Must match ImageUniforms.
+const char pImageBlock[] = R"(
+layout(std140) uniform DukeImage {
+ivec4 gSwizzle;
+ivec2 gViewport;
+ivec2 gImage;
+ivec2 gPan;
+vec2 gTileOffset; // tile center relative to the image center, in texels
+bvec4 gShowChannel;
+float gZoom;
+float pixelRatio;
+float gExposure;
+float gGamma;
+ivec4 gDataWindow; // texels holding decoded data, right and bottom excluded
+};
+)";
+
+const char pGeometryUniforms[] = R"(
+uniform ivec2 gViewport;
+uniform ivec2 gImage;
+uniform ivec2 gPan;
+uniform vec2 gTileOffset;
+uniform float gZoom;
+uniform float pixelRatio;
+)";
+
 const char pSampleTenbitsUnpack[] = R"(
 smooth in vec2 vVaryingTexCoord;
 uniform usampler2DRect gTextureSampler;
@@ -107,12 +160,19 @@ return swizzle(texture(sampler, offset));
 
 )";
 
+const char pSampleMipmapped[] = R"(
+smooth in vec2 vVaryingTexCoord;
+uniform sampler2D gTextureSampler;
+
+// filtering is done by the hardware across the mip chain, sampler2D expects normalized coordinates
+vec4 trilinear(sampler2D sampler, vec2 offset) {
+return swizzle(texture(sampler, offset / vec2(textureSize(sampler, 0))));
+}
+
+)";
+
 const char pTexturedMain[] = R"(
 out vec4 vFragColor;
-uniform bvec4 gShowChannel;
-uniform float gExposure;
-uniform float gGamma;
-uniform float gZoom;
 
 vec2 random(vec2 seed) {
 /* use the fragment position for a different seed per-pixel */
@@ -213,23 +273,24 @@ vFragColor = vec4(vVaryingTexCoord,0,1);
 
 void appendSampler(ostream&stream, const ShaderDescription &description) {
 const bool filtering = false; // Testing
-const string filter(filtering ? "bilinear" : "nearest");
+const string filter(description.mipmapped ? "trilinear" : (filtering ? "bilinear" : "nearest"));
+if (description.mipmapped)
+stream << pSampleMipmapped;
+else
 stream << (description.tenBitUnpack ? pSampleTenbitsUnpack : pSampleRegular);
  stream << "uniform sampler3D lut3d; \n";
 stream << "vec4 sample(vec2 offset) {"
       // "  return " << "apply3dTransform(" << filter << "(gTextureSampler, vVaryingTexCoord+offset)); }\n";
   //" return texture(gTextureSampler,vVaryingTexCoord); }\n";
-  	"return " << "OCIODisplay(" << filter << "(gTextureSampler,vVaryingTexCoord+offset), lut3d); }\n";
+  	"vec2 texel = vVaryingTexCoord+offset;"
+  	"if (any(lessThan(texel, vec2(gDataWindow.xy))) || any(greaterThanEqual(texel, vec2(gDataWindow.zw)))) return vec4(0,0,0,1);"
+  	"return " << "OCIODisplay(" << filter << "(gTextureSampler,texel), lut3d); }\n";
 }
 
 void appendSwizzle(ostream&stream, const ShaderDescription &description) {
 const char* type = description.tenBitUnpack ? "uvec4" : "vec4";
-string swizzling = description.grayscale ? "rrra" : "rgba";
-if (description.swapRedAndBlue)
-std::swap(swizzling[0], swizzling[2]);
-if (description.swapEndianness)
-std::reverse(swizzling.begin(), swizzling.end());
-stream << type << " swizzle(" << type << " sample){return sample." << swizzling << ";}";
+stream << type << " swizzle(" << type << " sample){return " << type
+       << "(sample[gSwizzle.r], sample[gSwizzle.g], sample[gSwizzle.b], sample[gSwizzle.a]);}";
 }
 
 }  // namespace
@@ -240,6 +301,7 @@ ostringstream oss;
 
 oss << "#version 330" << endl;
 if (description.sampleTexture) {
+oss << pImageBlock;
 oss << description.OCIOoutput << endl;
 appendSwizzle(oss, description);
 appendSampler(oss, description);
@@ -255,18 +317,12 @@ return oss.str();
 }
 
 std::string buildVertexShaderSource(const ShaderDescription &description) {
-return R"(
+return string(R"(
 #version 330
 
 layout (location = 0) in vec3 Position;
 layout (location = 1) in vec2 UV;
-
-uniform ivec2 gViewport;
-uniform ivec2 gImage;
-uniform ivec2 gPan;
-uniform float gZoom;
-uniform float pixelRatio;
-
+)") + (description.sampleTexture ? pImageBlock : pGeometryUniforms) + R"(
 out vec2 vVaryingTexCoord; 
 
 mat4 ortho(int left, int right, int bottom, int top) {
@@ -306,6 +362,7 @@ scaling *= gImage; // to pixel dimension
 scaling *= gZoom; // zoom
 mat4 world = mat4(1);
 world = translate(world, vec3(translating, 0)); // move to center
+world = translate(world, vec3(gTileOffset * gZoom * vec2(1., 1./pixelRatio), 0)); // move to tile
 world = scale(world, vec3(scaling, 1));
 mat4 proj = ortho(0, gViewport.x, 0, gViewport.y);
 mat4 worldViewProj = proj * world;
@@ -314,10 +371,27 @@ vVaryingTexCoord = UV * abs(gImage);
 })";
 }
 
+ShaderDescription getProgramKey(const ShaderDescription &description) {
+    ShaderDescription key = description;
+    // swizzling is a uniform and colorspaces are handled by the OCIO shader text
+    key.grayscale = false;
+    key.swapEndianness = false;
+    key.swapRedAndBlue = false;
+    key.fileColorspace = ColorSpace::linear;
+    key.screenColorspace = ColorSpace::linear;
+    return key;
+}
+
+void bindUniformBlocks(const ShaderDescription &description, const Program &program) {
+    if (description.sampleTexture) program.bindUniformBlock(ImageUniformBuffer::BLOCK_NAME, ImageUniformBuffer::BINDING);
+}
+
 SharedProgram buildProgram(const ShaderDescription &description) {
     const string vsSource = buildVertexShaderSource(description);
     const string fsSource = buildFragmentShaderSource(description);
-    return make_shared<Program>(makeVertexShader(vsSource.c_str()), makeFragmentShader(fsSource.c_str()));
+    auto pProgram = make_shared<Program>(makeVertexShader(vsSource.c_str()), makeFragmentShader(fsSource.c_str()));
+    bindUniformBlocks(description, *pProgram);
+    return pProgram;
 }
 
 } /* namespace duke */
@@ -4,6 +4,8 @@
 #include <duke/engine/ColorSpace.hpp>
 #include <duke/OpenColorIO/OpenColorIOManager.hpp>
 
+#include <iosfwd>
+
 namespace duke {
 
 struct ShaderDescription {
@@ -16,6 +18,7 @@ struct ShaderDescription {
   bool swapEndianness = false;
   bool swapRedAndBlue = false;
   bool tenBitUnpack = false;
+  bool mipmapped = false;  // GL_TEXTURE_2D sampled with trilinear filtering
   ColorSpace fileColorspace = ColorSpace::linear;    // aka input colorspace
   ColorSpace screenColorspace = ColorSpace::linear;  // aka output colorspace
  
@@ -25,13 +28,22 @@ struct ShaderDescription {
   bool operator<(const ShaderDescription &other) const;
 
   static ShaderDescription createTextureDesc(bool grayscale, bool swapEndianness, bool swapRedAndBlue,
-                                             bool tenBitUnpack, ColorSpace fileColorspace, ColorSpace screenColorspace, std::string OCIOoutput);
+                                             bool tenBitUnpack, ColorSpace fileColorspace, ColorSpace screenColorspace, std::string OCIOoutput,
+                                             bool mipmapped = false);
   static ShaderDescription createSolidDesc();
   static ShaderDescription createUvDesc();
 };
 
+// Text serialization, used to remember the variants between sessions.
+void write(std::ostream &stream, const ShaderDescription &description);
+bool read(std::istream &stream, ShaderDescription &description);
+
 std::string buildFragmentShaderSource(const ShaderDescription &description);
 std::string buildVertexShaderSource(const ShaderDescription &description);
+// The description of the program actually built for description, flags
+// passed as uniforms are cleared so that formats share programs.
+ShaderDescription getProgramKey(const ShaderDescription &description);
+void bindUniformBlocks(const ShaderDescription &description, const Program &program);
 SharedProgram buildProgram(const ShaderDescription &description);
 
 } /* namespace duke */
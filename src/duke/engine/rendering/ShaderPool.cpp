@@ -0,0 +1,110 @@
+#include "ShaderPool.hpp"
+
+#include <duke/gl/GL.hpp>
+
+#include <cstdio>
+
+namespace duke {
+
+ShaderPool::ShaderPool(const std::string& cacheDirectory) : m_BinaryCache(cacheDirectory), m_StopPrewarm(false) {}
+
+ShaderPool::~ShaderPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_StopPrewarm = true;
+  }
+  m_PrewarmCondition.notify_all();
+  if (m_PrewarmThread.joinable()) m_PrewarmThread.join();
+  if (m_pPrewarmWindow) glfwDestroyWindow(m_pPrewarmWindow);
+
+  // This session's variants first, then the ones of the previous sessions.
+  std::vector<ShaderDescription> variants;
+  for (const auto& pair : m_Map) variants.push_back(pair.first);
+  for (const auto& previous : m_BinaryCache.loadVariants())
+    if (m_Map.find(previous) == m_Map.end()) variants.push_back(previous);
+  m_BinaryCache.storeVariants(variants);
+}
+
+SharedProgram ShaderPool::get(const ShaderDescription& description) const {
+  const ShaderDescription key = getProgramKey(description);
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const auto pFound = m_Map.find(key);
+    if (pFound != m_Map.end()) return pFound->second;
+  }
+  auto pProgram = build(key);
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Map.insert(std::make_pair(key, std::move(pProgram))).first->second;
+}
+
+SharedProgram ShaderPool::build(const ShaderDescription& key) const {
+  const std::string vsSource = buildVertexShaderSource(key);
+  const std::string fsSource = buildFragmentShaderSource(key);
+  auto pProgram = m_BinaryCache.load(vsSource, fsSource);
+  if (!pProgram) {
+    pProgram = std::make_shared<Program>(makeVertexShader(vsSource.c_str()), makeFragmentShader(fsSource.c_str()));
+    m_BinaryCache.store(vsSource, fsSource, *pProgram);
+  }
+  bindUniformBlocks(key, *pProgram);  // not part of the binary
+  return pProgram;
+}
+
+ImageUniformBuffer& ShaderPool::getImageUniforms() const {
+  if (!m_pImageUniforms) m_pImageUniforms.reset(new ImageUniformBuffer());
+  return *m_pImageUniforms;
+}
+
+void ShaderPool::prewarm(GLFWwindow* pWindow) {
+  if (m_pPrewarmWindow) return;
+  auto variants = m_BinaryCache.loadVariants();
+  // the hidden window inherits the other hints, eg. the context version
+  glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+  m_pPrewarmWindow = glfwCreateWindow(1, 1, "", nullptr, pWindow);
+  glfwWindowHint(GLFW_VISIBLE, glfwGetWindowAttrib(pWindow, GLFW_VISIBLE));
+  if (!m_pPrewarmWindow) return;
+  m_PrewarmThread = std::thread(&ShaderPool::prewarmFunction, this, std::move(variants));
+}
+
+bool ShaderPool::prepare(const ShaderDescription& description) const {
+  const ShaderDescription key = getProgramKey(description);
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!m_PrewarmThread.joinable() || m_Map.count(key) || m_Failed.count(key)) return true;
+    if (!m_Pending.insert(key).second) return false;
+  }
+  m_PrewarmCondition.notify_one();
+  return false;
+}
+
+void ShaderPool::prewarmFunction(std::vector<ShaderDescription> variants) {
+  glfwMakeContextCurrent(m_pPrewarmWindow);
+  for (;;) {
+    for (const auto& variant : variants) {
+      if (m_StopPrewarm) break;
+      const ShaderDescription key = getProgramKey(variant);
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_Map.find(key) != m_Map.end()) continue;
+      }
+      try {
+        auto pProgram = build(key);
+        glFinish();  // the program must be complete before the other context uses it
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Map.insert(std::make_pair(key, std::move(pProgram)));
+      } catch (const std::exception& e) {
+        fprintf(stderr, "unable to prewarm shader variant : %s\n", e.what());
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Failed.insert(key);
+      }
+    }
+    // then serving prepare()
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_PrewarmCondition.wait(lock, [this] { return m_StopPrewarm || !m_Pending.empty(); });
+    if (m_StopPrewarm) break;
+    variants.assign(m_Pending.begin(), m_Pending.end());
+    m_Pending.clear();
+  }
+  glfwMakeContextCurrent(nullptr);
+}
+
+}  // namespace duke
@@ -1,19 +1,62 @@
 #pragma once
 
+#include <duke/base/NonCopyable.hpp>
+#include <duke/engine/rendering/ImageUniforms.hpp>
+#include <duke/engine/rendering/ProgramBinaryCache.hpp>
 #include <duke/engine/rendering/ShaderFactory.hpp>
+
+#include <atomic>
+#include <condition_variable>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+struct GLFWwindow;
 
 namespace duke {
 
-struct ShaderPool {
-  SharedProgram get(const ShaderDescription& key) const {
-    auto pFound = m_Map.find(key);
-    if (pFound == m_Map.end()) pFound = m_Map.insert(std::make_pair(key, buildProgram(key))).first;
-    return pFound->second;
-  }
+/**
+ * Programs by description, built on first use.
+ * Descriptions differing only by flags passed as uniforms share a program,
+ * see getProgramKey. Linked programs are persisted in a ProgramBinaryCache so
+ * they are only compiled once per driver.
+ */
+struct ShaderPool : public noncopyable {
+  // Programs and variants are persisted in cacheDirectory, see
+  // ProgramBinaryCache::getDefaultDirectory.
+  explicit ShaderPool(const std::string& cacheDirectory);
+  ~ShaderPool();
+
+  SharedProgram get(const ShaderDescription& description) const;
+
+  // The buffer backing the DukeImage block of the image programs.
+  ImageUniformBuffer& getImageUniforms() const;
+
+  // Builds the variants used by the previous sessions in the background, on a
+  // hidden context sharing its objects with pWindow's context.
+  void prewarm(GLFWwindow* pWindow);
+
+  // True if get() will not have to build the program. Otherwise queues it on
+  // the prewarm context. Without prewarm context, or if building failed,
+  // returns true and get() builds or throws as usual.
+  bool prepare(const ShaderDescription& description) const;
 
  private:
+  SharedProgram build(const ShaderDescription& key) const;
+  void prewarmFunction(std::vector<ShaderDescription> variants);
+
+  ProgramBinaryCache m_BinaryCache;
+  mutable std::mutex m_Mutex;
   mutable std::map<ShaderDescription, SharedProgram> m_Map;
+  mutable std::unique_ptr<ImageUniformBuffer> m_pImageUniforms;
+  GLFWwindow* m_pPrewarmWindow = nullptr;
+  std::thread m_PrewarmThread;
+  std::atomic<bool> m_StopPrewarm;
+  mutable std::condition_variable m_PrewarmCondition;
+  mutable std::set<ShaderDescription> m_Pending;
+  std::set<ShaderDescription> m_Failed;
 };
 
 }  // namespace duke
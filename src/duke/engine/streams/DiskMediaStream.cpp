@@ -13,11 +13,15 @@ namespace duke {
 
 DiskMediaStream::DiskMediaStream(const attribute::Attributes& options, const sequence::Item& item) {
   switch (item.getType()) {
-    case sequence::Item::SINGLE:
-      m_pDelegate.reset(new SingleFileStream(options, item));
+    case sequence::Item::SINGLE: {
+      auto pStream = new SingleFileStream(options, item);
+      m_pDelegate.reset(pStream);
+      if (pStream->isStill()) m_FrameCount = 1;
       break;
+    }
     case sequence::Item::PACKED:
       m_pDelegate.reset(new FileSequenceStream(options, item));
+      m_FrameCount = item.end - item.start + 1;
       break;
     default:
       CHECK(!"Invalid state");
@@ -26,12 +30,17 @@ DiskMediaStream::DiskMediaStream(const attribute::Attributes& options, const seq
   CHECK(m_pDelegate);
 }
 
-ReadFrameResult DiskMediaStream::process(const size_t frame) const {
-  return CHECK_NOTNULL(m_pDelegate)->process(frame);
+ReadFrameResult DiskMediaStream::process(const size_t frame, const attribute::Attributes& request) const {
+  return CHECK_NOTNULL(m_pDelegate)->process(frame, request);
 }
 
 bool DiskMediaStream::isForwardOnly() const { return CHECK_NOTNULL(m_pDelegate)->isForwardOnly(); }
 
 const attribute::Attributes& DiskMediaStream::getState() const { return CHECK_NOTNULL(m_pDelegate)->getState(); }
 
+size_t DiskMediaStream::getFrameCount() const {
+  if (m_FrameCount) return m_FrameCount;
+  return attribute::getWithDefault<attribute::MediaFrameCount>(getState());
+}
+
 } /* namespace duke */
@@ -12,14 +12,18 @@ class DiskMediaStream final : public duke::IMediaStream {
  public:
   DiskMediaStream(const attribute::Attributes& readerOptions, const sequence::Item& item);
 
-  ReadFrameResult process(const size_t frame) const override;
+  ReadFrameResult process(const size_t frame, const attribute::Attributes& request) const override;
 
   bool isForwardOnly() const override;
 
   const attribute::Attributes& getState() const override;
 
+  // Known without I/O for sequences and stills, movies open their reader.
+  size_t getFrameCount() const;
+
  private:
   std::unique_ptr<IMediaStream> m_pDelegate;
+  size_t m_FrameCount = 0;  // 0 until the reader tells
 };
 
 } /* namespace duke */
@@ -5,6 +5,7 @@
 #include <duke/attributes/Attributes.hpp>
 #include <duke/imageio/DukeIO.hpp>
 
+#include <mutex>
 #include <vector>
 #include <string>
 
@@ -14,18 +15,20 @@ struct Item;
 
 namespace duke {
 
+// The frame count is known from the item, construction does no I/O. The
+// metadata of the first frame is read on the first call to getState().
 class FileSequenceStream final : public duke::IMediaStream {
  public:
   FileSequenceStream(const attribute::Attributes& options, const sequence::Item& item);
   ~FileSequenceStream() override {}
 
   // This function can be called from different threads.
-  ReadFrameResult process(const size_t frame) const override;
+  ReadFrameResult process(const size_t frame, const attribute::Attributes& request) const override;
 
   // File sequences are random access streams
   bool isForwardOnly() const override { return false; }
 
-  const attribute::Attributes& getState() const override { return m_State; }
+  const attribute::Attributes& getState() const override;
 
  private:
   const size_t m_FrameStart;
@@ -34,7 +37,9 @@ class FileSequenceStream final : public duke::IMediaStream {
   const attribute::Attributes m_Options;
   std::string m_Prefix;
   std::string m_Suffix;
-  attribute::Attributes m_State;
+  std::string m_FirstFilename;
+  mutable std::once_flag m_StateResolved;
+  mutable attribute::Attributes m_State;
 };
 
 }  // namespace duke
@@ -41,6 +41,15 @@ std::unique_ptr<IImageReader> getFirstValidReader(const attribute::Attributes& o
   return pCurrent;
 }
 
+template <typename APPENDER>
+void appendFilename(const std::string& prefix, size_t frame, size_t padding, const std::string& suffix,
+                    APPENDER& buffer) {
+  buffer.append(prefix);
+  appendPaddedFrameNumber(frame, padding > 0 ? padding : digits(frame), buffer);
+  buffer.append(suffix);
+  CHECK(!buffer.full()) << "filename too long";
+}
+
 BigAlignedBlock gBigAlignedMallocator;
 
 void CopyFromVolatileDataPointer(FrameData& frame, const void* pVolatileData) {
@@ -63,50 +72,66 @@ FileSequenceStream::FileSequenceStream(const attribute::Attributes& options, con
   m_Prefix = std::string(begin, begin + firstSharpIndex);
   auto lastSharpIndex = filename.rfind('#');
   m_Suffix = std::string(begin + lastSharpIndex + 1, filename.end());
+  BufferStringAppender<2048> buffer;
+  appendFilename(m_Prefix, m_FrameStart, m_Padding, m_Suffix, buffer);
+  m_FirstFilename = buffer.c_str();
   using namespace attribute;
   set<MediaFrameCount>(m_State, item.end - item.start + 1);
-  // reading first frame to get metadata
-  merge(process(0).readerAttributes, m_State);
+  set<File>(m_State, m_FirstFilename.c_str());
 }
 
 // Several threads will access this function at the same time.
-ReadFrameResult FileSequenceStream::process(const size_t atFrame) const {
+ReadFrameResult FileSequenceStream::process(const size_t atFrame, const attribute::Attributes& request) const {
+  // the loading threads resolve the state ahead of display
+  getState();
   ReadFrameResult result;
+  result.attributes() = request;
   BufferStringAppender<2048> buffer;
-  const size_t frame = atFrame + m_FrameStart;
-  const size_t paddingSize = m_Padding > 0 ? m_Padding : digits(frame);
-  buffer.append(m_Prefix);
-  appendPaddedFrameNumber(frame, paddingSize, buffer);
-  buffer.append(m_Suffix);
-  CHECK(!buffer.full()) << "filename too long";
+  appendFilename(m_Prefix, atFrame + m_FrameStart, m_Padding, m_Suffix, buffer);
   attribute::set<attribute::File>(result.attributes(), buffer.c_str());
   return duke::load(m_Options, &CopyFromVolatileDataPointer, std::move(result));
 }
 
+const attribute::Attributes& FileSequenceStream::getState() const {
+  // the header of the first frame is representative of the sequence
+  std::call_once(m_StateResolved, [this]() {
+    const ReadFrameResult header = loadHeader(m_Options, m_FirstFilename.c_str());
+    if (header)
+      merge(header.readerAttributes, m_State);
+    else
+      attribute::set<attribute::Error>(m_State, header.error.c_str());
+  });
+  return m_State;
+}
+
 SingleFileStream::SingleFileStream(const attribute::Attributes& options, const sequence::Item& item)
-    : m_Filename(item.filename),
-      m_Descriptors(findIODescriptors(item)),
-      m_pImageReader(getFirstValidReader(options, m_Descriptors, m_Filename.c_str())) {
-  using namespace attribute;
-  if (!m_pImageReader) {
-    std::string error = "No reader for '";
-    error += m_Filename;
-    error += "'";
-    set<Error>(m_State, error.c_str());
-    return;
-  }
-  set<File>(m_State, m_Filename.c_str());
-  merge(m_pImageReader->getAttributes(), m_State);
-  if (m_pImageReader->hasError()) {
-    set<Error>(m_State, m_pImageReader->getError().c_str());
-    m_pImageReader.reset();
-    return;
-  }
+    : m_Options(options), m_Filename(item.filename), m_Descriptors(findIODescriptors(item)) {}
+
+void SingleFileStream::open() const {
+  std::call_once(m_Opened, [this]() {
+    using namespace attribute;
+    m_pImageReader = getFirstValidReader(m_Options, m_Descriptors, m_Filename.c_str());
+    if (!m_pImageReader) {
+      std::string error = "No reader for '";
+      error += m_Filename;
+      error += "'";
+      set<Error>(m_State, error.c_str());
+      return;
+    }
+    set<File>(m_State, m_Filename.c_str());
+    merge(m_pImageReader->getAttributes(), m_State);
+    if (m_pImageReader->hasError()) {
+      set<Error>(m_State, m_pImageReader->getError().c_str());
+      m_pImageReader.reset();
+    }
+  });
 }
 
-ReadFrameResult SingleFileStream::process(const size_t frame) const {
+ReadFrameResult SingleFileStream::process(const size_t frame, const attribute::Attributes& request) const {
   using namespace attribute;
+  open();
   ReadFrameResult result;
+  result.attributes() = request;
   if (!m_pImageReader) {
     result.error = getWithDefault<Error>(m_State, "Invalid reader state");
     return result;
@@ -120,7 +145,16 @@ ReadFrameResult SingleFileStream::process(const size_t frame) const {
 
 bool SingleFileStream::isForwardOnly() const {
   using namespace attribute;
-  return getWithDefault<MediaFrameCount>(m_State) > 1;
+  return !isStill() && getWithDefault<MediaFrameCount>(getState()) > 1;
+}
+
+const attribute::Attributes& SingleFileStream::getState() const {
+  open();
+  return m_State;
+}
+
+bool SingleFileStream::isStill() const {
+  return !m_Descriptors.empty() && std::all_of(begin(m_Descriptors), end(m_Descriptors), &isFileSequenceReader);
 }
 
 }  // namespace duke
@@ -11,7 +11,9 @@ class IMediaStream : public noncopyable {
   virtual ~IMediaStream() {}
 
   // This function can be called from different threads.
-  virtual ReadFrameResult process(const size_t frame) const = 0;
+  // 'request' holds per frame read parameters (e.g. attribute::ProxyLevel),
+  // they are forwarded to the reader along with the frame attributes.
+  virtual ReadFrameResult process(const size_t frame, const attribute::Attributes& request) const = 0;
 
   // True if this stream is only a forward stream
   virtual bool isForwardOnly() const = 0;
@@ -1,7 +1,11 @@
 #pragma once
 
-#include <utility>
+#include <duke/imageio/ProxyLevel.hpp>
+#include <duke/imageio/Region.hpp>
+
+#include <tuple>
 #include <cstddef>
+#include <cstdint>
 
 namespace duke {
 
@@ -10,15 +14,23 @@ class IMediaStream;
 struct MediaFrameReference {
   const IMediaStream* pStream;
   size_t frame;
+  uint8_t proxyLevel;
+  Region region;
+
+  MediaFrameReference(const IMediaStream* pStream, size_t frame, uint8_t proxyLevel = 0, Region region = Region())
+      : pStream(pStream), frame(frame), proxyLevel(proxyLevel), region(region) {}
+  MediaFrameReference() : pStream(nullptr), frame(0), proxyLevel(0) {}
+  bool operator==(const MediaFrameReference& other) const { return asTuple() == other.asTuple(); }
+  bool operator!=(const MediaFrameReference& other) const { return asTuple() != other.asTuple(); }
+  bool operator<(const MediaFrameReference& other) const { return asTuple() < other.asTuple(); }
 
-  MediaFrameReference(const IMediaStream* pStream, size_t frame) : pStream(pStream), frame(frame) {}
-  MediaFrameReference() : pStream(nullptr), frame(0) {}
-  bool operator==(const MediaFrameReference& other) const { return asPair() == other.asPair(); }
-  bool operator!=(const MediaFrameReference& other) const { return asPair() != other.asPair(); }
-  bool operator<(const MediaFrameReference& other) const { return asPair() < other.asPair(); }
+  // Same stream and frame, regardless of the decoded resolution and region.
+  bool sameFrame(const MediaFrameReference& other) const { return pStream == other.pStream && frame == other.frame; }
 
  private:
-  inline std::pair<const IMediaStream*, size_t> asPair() const { return std::make_pair(pStream, frame); }
+  inline std::tuple<const IMediaStream*, size_t, uint8_t, Region> asTuple() const {
+    return std::make_tuple(pStream, frame, proxyLevel, region);
+  }
 };
 
 }  // namespace duke
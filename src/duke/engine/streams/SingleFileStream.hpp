@@ -15,25 +15,34 @@ struct Item;
 
 namespace duke {
 
+// The reader is opened on first use, stills are known to hold a single frame
+// without opening them.
 class SingleFileStream final : public duke::IMediaStream {
  public:
   SingleFileStream(const attribute::Attributes& options, const sequence::Item& item);
   ~SingleFileStream() override {}
 
   // This function can be called from different threads.
-  ReadFrameResult process(const size_t frame) const override;
+  ReadFrameResult process(const size_t frame, const attribute::Attributes& request) const override;
 
   // True if this stream is a movie
   bool isForwardOnly() const override;
 
-  const attribute::Attributes& getState() const override { return m_State; }
+  const attribute::Attributes& getState() const override;
+
+  // True if all the readers for this file only read single images.
+  bool isStill() const;
 
  private:
+  void open() const;
+
+  const attribute::Attributes m_Options;
   const std::string m_Filename;
   const std::vector<IIODescriptor*> m_Descriptors;
   mutable std::mutex m_Mutex;
-  std::unique_ptr<IImageReader> m_pImageReader;
-  attribute::Attributes m_State;
+  mutable std::once_flag m_Opened;
+  mutable std::unique_ptr<IImageReader> m_pImageReader;
+  mutable attribute::Attributes m_State;
 };
 
 }  // namespace duke
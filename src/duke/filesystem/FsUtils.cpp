@@ -1,11 +1,13 @@
 #include "FsUtils.hpp"
 
 #include <dirent.h>
+#include <errno.h>
 #include <sys/stat.h>
 #include <cstring>
 #include <limits.h>
 #include <unistd.h>
 #include <stdlib.h>
+#include <stdexcept>
 
 namespace duke {
 
@@ -38,4 +40,57 @@ std::string getExePath() {
 
 std::string getDirname(const std::string& file) { return file.substr(0, file.rfind('/')); }
 
+std::string createTemporaryDirectory(const char* pPrefix) {
+  const char* pTmp = getenv("TMPDIR");
+  std::string pattern = std::string(pTmp ? pTmp : "/tmp") + '/' + pPrefix + "XXXXXX";
+  if (!mkdtemp(&pattern[0])) throw std::runtime_error("unable to create a temporary directory " + pattern);
+  return pattern;
+}
+
+void removeDirectory(const std::string& directory) {
+  if (DIR* pDir = opendir(directory.c_str())) {
+    while (const dirent* pEntry = readdir(pDir)) {
+      if (strcmp(pEntry->d_name, ".") == 0 || strcmp(pEntry->d_name, "..") == 0) continue;
+      unlink((directory + '/' + pEntry->d_name).c_str());
+    }
+    closedir(pDir);
+  }
+  rmdir(directory.c_str());
+}
+
+bool createDirectories(const std::string& directory) {
+  if (directory.empty()) return false;
+  for (size_t slash = directory.find('/', 1);; slash = directory.find('/', slash + 1)) {
+    const std::string parent = directory.substr(0, slash);
+    if (mkdir(parent.c_str(), 0755) != 0 && errno != EEXIST) return false;
+    if (slash == std::string::npos) break;
+  }
+  return getFileStatus(directory.c_str()) == FileStatus::DIRECTORY;
+}
+
+std::string getUserCacheDirectory() {
+  const char* pCache = getenv("XDG_CACHE_HOME");
+  if (pCache && *pCache) return pCache;
+  const char* pHome = getenv("HOME");
+  if (pHome && *pHome) return std::string(pHome) + "/.cache";
+  return {};
+}
+
+bool writeFileAtomically(const std::string& filename, const std::function<bool(FILE*)>& writer) {
+  std::string temporary = filename + ".XXXXXX";
+  const int fd = mkstemp(&temporary[0]);
+  if (fd < 0) return false;
+  FILE* pFile = fdopen(fd, "wb");
+  if (!pFile) {
+    close(fd);
+    unlink(temporary.c_str());
+    return false;
+  }
+  const bool written = writer(pFile);
+  const bool closed = fclose(pFile) == 0;
+  if (written && closed && rename(temporary.c_str(), filename.c_str()) == 0) return true;
+  unlink(temporary.c_str());
+  return false;
+}
+
 } /* namespace duke */
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdio>
+#include <functional>
 #include <string>
 
 namespace duke {
@@ -20,4 +22,20 @@ std::string getExePath();
 
 std::string getDirname(const std::string& file);
 
+// Creates a unique directory in TMPDIR or /tmp, throws on failure.
+std::string createTemporaryDirectory(const char* pPrefix);
+
+// Removes the files in the directory then the directory itself, not recursive.
+void removeDirectory(const std::string& directory);
+
+// Creates the directory and its missing parents, returns false on failure.
+bool createDirectories(const std::string& directory);
+
+// XDG_CACHE_HOME or HOME/.cache, empty if none is defined.
+std::string getUserCacheDirectory();
+
+// Writes in a temporary file then renames it, readers never see a partial file.
+// Returns false if writer returns false or on I/O error.
+bool writeFileAtomically(const std::string& filename, const std::function<bool(FILE*)>& writer);
+
 } /* namespace duke */
@@ -384,6 +384,18 @@ bool isInternalOptimizedFormatRedBlueSwapped(int internalFormat) {
   }
 }
 
+bool isFilterableFormat(GLint internalFormat) {
+  switch (getPixelFormat(internalFormat)) {
+    case GL_RED_INTEGER:
+    case GL_RG_INTEGER:
+    case GL_RGB_INTEGER:
+    case GL_RGBA_INTEGER:
+      return false;
+    default:
+      return true;
+  }
+}
+
 GLint getAdaptedInternalFormat(GLint internalFormat) {
   return internalFormat == GL_RGB10_A2UI ? GL_RGBA8UI : internalFormat;
 }
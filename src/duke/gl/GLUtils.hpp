@@ -9,6 +9,8 @@ int getAdaptedInternalFormat(int internalFormat);
 unsigned int getPixelFormat(int internalFormat);
 unsigned int getPixelType(int internalFormat);
 bool isInternalOptimizedFormatRedBlueSwapped(int internalFormat);
+// False for integer formats, they can't be sampled with linear filtering.
+bool isFilterableFormat(int internalFormat);
 
 const char* getInternalFormatString(int internalFormat);
 const char* getPixelFormatString(unsigned int pixelFormat);
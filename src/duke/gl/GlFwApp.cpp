@@ -75,6 +75,13 @@ DukeGLFWApplication::DukeGLFWApplication() {
 
 DukeGLFWApplication::~DukeGLFWApplication() { glfwTerminate(); }
 
+void DukeGLFWApplication::setHeadless() {
+  glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+#ifdef GLFW_EGL_CONTEXT_API
+  glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+#endif
+}
+
 GLFWwindow *DukeGLFWApplication::createRawWindow(int width, int height, const char *title, GLFWmonitor *monitor,
                                                  GLFWwindow *share) {
   GLFWwindow *pWindow = glfwCreateWindow(width, height, title, monitor, share);
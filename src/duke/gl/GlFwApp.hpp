@@ -37,6 +37,10 @@ struct DukeGLFWApplication : public noncopyable {
 
   GLFWwindow* createRawWindow(int width, int height, const char* title, GLFWmonitor* monitor, GLFWwindow* share);
 
+  // Windows created afterwards are hidden and use EGL when available. GLFW
+  // still connects to the display server.
+  void setHeadless();
+
   template <typename WINDOW>
   WINDOW* createWindow(int width, int height, const char* title, GLFWmonitor* monitor, GLFWwindow* share) {
     return new WINDOW(createRawWindow(width, height, title, monitor, share));
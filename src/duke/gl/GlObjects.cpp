@@ -1,6 +1,7 @@
 #include "GlObjects.hpp"
 #include <duke/gl/GL.hpp>
 #include <duke/gl/GLUtils.hpp>
+#include <duke/gl/RenderState.hpp>
 
 namespace duke {
 namespace gl {
@@ -33,9 +34,12 @@ GLuint allocateTextureObject() {
 }  // namespace
 
 GlTextureObject::GlTextureObject(GLenum target) : GlObject(allocateTextureObject()), target(target) {}
-GlTextureObject::~GlTextureObject() { glDeleteTextures(1, &id); }
-void GlTextureObject::bind() const { glBindTexture(target, id); }
-void GlTextureObject::unbind() const { glBindTexture(target, 0); }
+GlTextureObject::~GlTextureObject() {
+  glDeleteTextures(1, &id);
+  RenderState::current().textureDeleted(id);
+}
+void GlTextureObject::bind() const { RenderState::current().bindTexture(target, id); }
+void GlTextureObject::unbind() const { RenderState::current().bindTexture(target, 0); }
 
 
 
@@ -62,11 +66,43 @@ void GlBufferObject::unbind() const { glBindBuffer(target, 0); }
 
 GlStaticVbo::GlStaticVbo() : GlBufferObject(GL_ARRAY_BUFFER, GL_STATIC_DRAW) {}
 
+GlStreamVbo::GlStreamVbo() : GlBufferObject(GL_ARRAY_BUFFER, GL_STREAM_DRAW) {}
+
 GlStaticIndexedVbo::GlStaticIndexedVbo() : GlBufferObject(GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW) {}
 
 GlStreamUploadPbo::GlStreamUploadPbo() : GlBufferObject(GL_PIXEL_UNPACK_BUFFER, GL_STREAM_DRAW) {}
 
 GlStaticUploadPbo::GlStaticUploadPbo() : GlBufferObject(GL_PIXEL_UNPACK_BUFFER, GL_STATIC_DRAW) {}
 
+GlStreamReadPbo::GlStreamReadPbo() : GlBufferObject(GL_PIXEL_PACK_BUFFER, GL_STREAM_READ) {}
+
+GlDynamicUbo::GlDynamicUbo() : GlBufferObject(GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW) {}
+
+namespace {
+
+GLuint allocateRenderbufferObject() {
+  GLuint id;
+  glGenRenderbuffers(1, &id);
+  return id;
+}
+
+GLuint allocateFramebufferObject() {
+  GLuint id;
+  glGenFramebuffers(1, &id);
+  return id;
+}
+
+}  // namespace
+
+GlRenderbufferObject::GlRenderbufferObject() : GlObject(allocateRenderbufferObject()) {}
+GlRenderbufferObject::~GlRenderbufferObject() { glDeleteRenderbuffers(1, &id); }
+void GlRenderbufferObject::bind() const { glBindRenderbuffer(GL_RENDERBUFFER, id); }
+void GlRenderbufferObject::unbind() const { glBindRenderbuffer(GL_RENDERBUFFER, 0); }
+
+GlFramebufferObject::GlFramebufferObject() : GlObject(allocateFramebufferObject()) {}
+GlFramebufferObject::~GlFramebufferObject() { glDeleteFramebuffers(1, &id); }
+void GlFramebufferObject::bind() const { glBindFramebuffer(GL_FRAMEBUFFER, id); }
+void GlFramebufferObject::unbind() const { glBindFramebuffer(GL_FRAMEBUFFER, 0); }
+
 } /* namespace gl */
 } /* namespace duke */
@@ -91,6 +91,10 @@ struct GlStaticVbo : public GlBufferObject {
   GlStaticVbo();
 };
 
+struct GlStreamVbo : public GlBufferObject {
+  GlStreamVbo();
+};
+
 struct GlStaticIndexedVbo : public GlBufferObject {
   GlStaticIndexedVbo();
 };
@@ -103,5 +107,33 @@ struct GlStaticUploadPbo : public GlBufferObject {
   GlStaticUploadPbo();
 };
 
+struct GlStreamReadPbo : public GlBufferObject {
+  GlStreamReadPbo();
+};
+
+struct GlDynamicUbo : public GlBufferObject {
+  GlDynamicUbo();
+};
+
+class GlRenderbufferObject : public GlObject {
+ public:
+  GlRenderbufferObject();
+  virtual ~GlRenderbufferObject();
+  virtual void bind() const;
+  virtual void unbind() const;
+};
+
+class GlFramebufferObject : public GlObject {
+ public:
+  GlFramebufferObject();
+  virtual ~GlFramebufferObject();
+  virtual void bind() const;
+  virtual void unbind() const;
+
+  Binder<GlFramebufferObject> scope_bind_framebuffer() const {
+    return {this};
+  }
+};
+
 } /* namespace gl */
 } /* namespace duke */
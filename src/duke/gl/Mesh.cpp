@@ -6,6 +6,14 @@ namespace duke {
 
 namespace {
 
+void setVertexLayout() {
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(VertexPosUv0), 0);
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(VertexPosUv0), (const GLvoid *)(sizeof(glm::vec3)));
+  glEnableVertexAttribArray(1);
+  glCheckError();
+}
+
 GLuint checkType(GLuint primitiveType) {
   switch (primitiveType) {
     case GL_POINTS:
@@ -34,11 +42,7 @@ Mesh::Mesh(GLuint primitiveType, const VertexPosUv0 *pVBegin, const size_t verte
   auto vboBound = vbo.scope_bind_buffer();
   glBufferData(vbo.target, vertexCount * sizeof(VertexPosUv0), pVBegin, vbo.usage);
   glCheckError();
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(VertexPosUv0), 0);
-  glEnableVertexAttribArray(0);
-  glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(VertexPosUv0), (const GLvoid *)(sizeof(glm::vec3)));
-  glEnableVertexAttribArray(1);
-  glCheckError();
+  setVertexLayout();
 }
 
 Mesh::~Mesh() {}
@@ -80,6 +84,36 @@ void IndexedMesh::unbind() const {
   Mesh::unbind();
 }
 
+StreamMesh::StreamMesh(GLuint primitiveType) : primitiveType(checkType(primitiveType)), vao(), vbo() {
+  auto vaoBound = vao.scope_bind();
+  auto vboBound = vbo.scope_bind_buffer();
+  setVertexLayout();
+}
+
+void StreamMesh::bind() const { vao.bind(); }
+
+void StreamMesh::unbind() const { vao.unbind(); }
+
+void StreamMesh::draw(const std::vector<VertexPosUv0> &vertices) const {
+  if (vertices.empty()) return;
+  auto bound = scope_bind();
+  auto vboBound = vbo.scope_bind_buffer();
+  const size_t size = vertices.size() * sizeof(VertexPosUv0);
+  glBufferData(vbo.target, size, nullptr, vbo.usage);
+  glBufferSubData(vbo.target, 0, size, vertices.data());
+  glDrawArrays(primitiveType, 0, vertices.size());
+  glCheckError();
+}
+
+void appendRect(std::vector<VertexPosUv0> &vertices, glm::vec2 bottomLeft, glm::vec2 topRight, glm::vec2 uvBottomLeft,
+                glm::vec2 uvTopRight) {
+  const VertexPosUv0 bl(glm::vec3(bottomLeft, 0.f), uvBottomLeft);
+  const VertexPosUv0 tl(glm::vec3(bottomLeft.x, topRight.y, 0), glm::vec2(uvBottomLeft.x, uvTopRight.y));
+  const VertexPosUv0 tr(glm::vec3(topRight, 0.f), uvTopRight);
+  const VertexPosUv0 br(glm::vec3(topRight.x, bottomLeft.y, 0), glm::vec2(uvTopRight.x, uvBottomLeft.y));
+  vertices.insert(vertices.end(), {bl, tl, tr, bl, tr, br});
+}
+
 SharedMesh createSquare() {
   using namespace std;
   const float z = 1;
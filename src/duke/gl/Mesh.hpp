@@ -57,6 +57,31 @@ class IndexedMesh : public Mesh {
   const duke::gl::GlStaticIndexedVbo ivbo;
 };
 
+// Vertices uploaded again for each draw, eg. quads batched by an overlay.
+class StreamMesh : public gl::IBindable {
+ public:
+  StreamMesh(GLuint primitiveType);
+
+  gl::Binder<StreamMesh> scope_bind() const {
+    return {this};
+  }
+
+  virtual void bind() const;
+  virtual void unbind() const;
+
+  // The previous storage is orphaned, draws still reading it don't stall the upload.
+  void draw(const std::vector<VertexPosUv0> &vertices) const;
+
+ private:
+  const GLuint primitiveType;
+  const duke::gl::GlVertexArrayObject vao;
+  const duke::gl::GlStreamVbo vbo;
+};
+
+// Appends the two triangles of a rectangle for a GL_TRIANGLES mesh.
+void appendRect(std::vector<VertexPosUv0> &vertices, glm::vec2 bottomLeft, glm::vec2 topRight, glm::vec2 uvBottomLeft,
+                glm::vec2 uvTopRight);
+
 typedef std::shared_ptr<Mesh> SharedMesh;
 typedef std::shared_ptr<IndexedMesh> SharedIndexedMesh;
 
@@ -0,0 +1,67 @@
+#include "PixelReadback.hpp"
+
+#include <duke/gl/GL.hpp>
+#include <duke/gl/GLUtils.hpp>
+
+#include <stdexcept>
+
+namespace duke {
+
+PixelReadback::PixelReadback(size_t width, size_t height, size_t depth, Callback callback)
+    : m_Width(width), m_Height(height), m_Callback(callback) {
+  if (depth == 0) throw std::logic_error("readback needs at least one buffer");
+  for (size_t i = 0; i < depth; ++i) {
+    m_Slots.emplace_back(new Slot());
+    const auto& pbo = m_Slots.back()->pbo;
+    auto bound = pbo.scope_bind_buffer();
+    glBufferData(pbo.target, getDataSize(), nullptr, pbo.usage);
+  }
+  glCheckError();
+}
+
+PixelReadback::~PixelReadback() {
+  for (const auto& pSlot : m_Slots)
+    if (pSlot->fence) glDeleteSync(pSlot->fence);
+}
+
+void PixelReadback::read(size_t tag) {
+  if (m_InFlight == m_Slots.size()) {
+    complete(*m_Slots[m_Next], true);
+    --m_InFlight;
+  }
+  Slot& slot = *m_Slots[m_Next];
+  {
+    auto bound = slot.pbo.scope_bind_buffer();
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, m_Width, m_Height, GL_BGRA, GL_UNSIGNED_BYTE, nullptr);
+  }
+  slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  slot.tag = tag;
+  m_Next = (m_Next + 1) % m_Slots.size();
+  ++m_InFlight;
+}
+
+void PixelReadback::poll(bool wait) {
+  while (m_InFlight > 0) {
+    const size_t oldest = (m_Next + m_Slots.size() - m_InFlight) % m_Slots.size();
+    if (!complete(*m_Slots[oldest], wait)) return;
+    --m_InFlight;
+  }
+}
+
+bool PixelReadback::complete(Slot& slot, bool wait) {
+  const GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? GL_TIMEOUT_IGNORED : 0);
+  if (status == GL_TIMEOUT_EXPIRED) return false;
+  if (status == GL_WAIT_FAILED) throw std::runtime_error("waiting for a pixel readback failed");
+  glDeleteSync(slot.fence);
+  slot.fence = nullptr;
+  auto bound = slot.pbo.scope_bind_buffer();
+  const size_t dataSize = getDataSize();
+  const auto pData = static_cast<const char*>(glMapBufferRange(slot.pbo.target, 0, dataSize, GL_MAP_READ_BIT));
+  if (!pData) throw std::runtime_error("unable to map the readback buffer");
+  m_Callback(slot.tag, pData, dataSize);
+  glUnmapBuffer(slot.pbo.target);
+  return true;
+}
+
+} /* namespace duke */
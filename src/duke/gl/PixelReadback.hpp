@@ -0,0 +1,51 @@
+#pragma once
+
+#include <duke/base/NonCopyable.hpp>
+#include <duke/gl/GlObjects.hpp>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace duke {
+
+/**
+ * Reads rendered images back to memory without stalling the GL pipeline.
+ * - each read is an asynchronous glReadPixels into the next PBO of a ring,
+ *   the PBO is mapped once its fence is signaled so the GPU keeps rendering
+ *   the following frames in the meantime.
+ * - images are delivered in read order as BGRA 8 bits rows, bottom to top.
+ */
+class PixelReadback : public noncopyable {
+ public:
+  // Called with the tag given to read() and a pointer valid during the call.
+  typedef std::function<void(size_t tag, const char* pData, size_t dataSize)> Callback;
+
+  PixelReadback(size_t width, size_t height, size_t depth, Callback callback);
+  ~PixelReadback();
+
+  // Reads the current read framebuffer, completing the oldest read first
+  // when all the PBOs are in flight.
+  void read(size_t tag);
+  // Delivers the completed reads, all of them if wait is set.
+  void poll(bool wait = false);
+
+  size_t getDataSize() const { return m_Width * m_Height * 4; }
+
+ private:
+  struct Slot {
+    gl::GlStreamReadPbo pbo;
+    GLsync fence = nullptr;
+    size_t tag = 0;
+  };
+  bool complete(Slot& slot, bool wait);
+
+  const size_t m_Width;
+  const size_t m_Height;
+  const Callback m_Callback;
+  std::vector<std::unique_ptr<Slot> > m_Slots;
+  size_t m_Next = 0;
+  size_t m_InFlight = 0;
+};
+
+} /* namespace duke */
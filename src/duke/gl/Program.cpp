@@ -1,4 +1,5 @@
 #include "Program.hpp"
+#include <duke/gl/RenderState.hpp>
 #include <stdexcept>
 
 namespace duke {
@@ -7,22 +8,55 @@ Program::Program(const SharedVertexShader& vertexShader, const SharedFragmentSha
     : programId(glCreateProgram()), pVertexShader(vertexShader), pFragmentShader(fragmentShader) {
   glAttachShader(programId, pVertexShader->getId());
   glAttachShader(programId, pFragmentShader->getId());
+  if (isBinarySupported()) glProgramParameteri(programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
   glLinkProgram(programId);
   checkProgramError(programId);
 }
 
+Program::Program(const ProgramBinary& binary) : programId(glCreateProgram()) {
+  glProgramBinary(programId, binary.format, binary.data.data(), binary.data.size());
+  try {
+    checkProgramError(programId);
+  } catch (...) {
+    glDeleteProgram(programId);
+    throw;
+  }
+}
+
 Program::~Program() {
-  glDetachShader(programId, pVertexShader->getId());
-  glDetachShader(programId, pFragmentShader->getId());
+  if (pVertexShader) glDetachShader(programId, pVertexShader->getId());
+  if (pFragmentShader) glDetachShader(programId, pFragmentShader->getId());
   glDeleteProgram(programId);
+  gl::RenderState::current().programDeleted(programId);
+}
+
+bool Program::isBinarySupported() {
+  static const bool supported = [] {
+    if (!glfwExtensionSupported("GL_ARB_get_program_binary")) return false;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+  }();
+  return supported;
+}
+
+bool Program::getBinary(ProgramBinary& binary) const {
+  if (!isBinarySupported()) return false;
+  GLint length = 0;
+  glGetProgramiv(programId, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) return false;
+  binary.data.resize(length);
+  GLsizei written = 0;
+  glGetProgramBinary(programId, length, &written, &binary.format, binary.data.data());
+  binary.data.resize(written);
+  return written > 0;
 }
 
 void Program::use() const {
+  if (!gl::RenderState::current().useProgram(programId)) return;
 #ifndef NDEBUG
   glValidateProgram(programId);
-  glCheckError();
 #endif
-  glUseProgram(programId);
   glCheckError();
 }
 
@@ -34,6 +68,16 @@ GLint Program::getUniformLocation(const char* pUniformName) const {
   throw std::runtime_error(error);
 }
 
+void Program::bindUniformBlock(const char* pBlockName, GLuint binding) const {
+  const GLuint blockIndex = glGetUniformBlockIndex(programId, pBlockName);
+  if (blockIndex == GL_INVALID_INDEX) {
+    char error[1024];
+    snprintf(error, sizeof(error), "OpenGL : no uniform block named '%s'", pBlockName);
+    throw std::runtime_error(error);
+  }
+  glUniformBlockBinding(programId, blockIndex, binding);
+}
+
 Program::CacheEntry& Program::getOrCreate(const char* pUniformName) {
   auto pFound = m_Cache.find(pUniformName);
   if (pFound == m_Cache.end())
@@ -2,16 +2,35 @@
 
 #include <duke/gl/Shader.hpp>
 #include <map>
+#include <vector>
 
 namespace duke {
 
+// A linked program as returned by glGetProgramBinary, only valid for the
+// driver which produced it.
+struct ProgramBinary {
+  GLenum format = 0;
+  std::vector<char> data;
+};
+
 struct Program : public noncopyable {
   Program(const SharedVertexShader& vertexShader, const SharedFragmentShader& fragmentShader);
+  // Throws if the driver rejects the binary, eg. after an update.
+  Program(const ProgramBinary& binary);
   ~Program();
 
+  // True if the current context can save and restore program binaries.
+  static bool isBinarySupported();
+  bool getBinary(ProgramBinary& binary) const;
+
+  // Skipped if the program is already in use.
   void use() const;
   GLint getUniformLocation(const char* pUniformName) const;
+  // Throws if the program has no such block.
+  void bindUniformBlock(const char* pBlockName, GLuint binding) const;
 
+  // Locations and values are cached, uploading an unchanged value is a no-op.
+  // The cache is keyed by pointer, pass the constants from ShaderConstants.
   void glUniform1f(const char* pUniformName, GLfloat v0);
   void glUniform2f(const char* pUniformName, GLfloat v0, GLfloat v1);
   void glUniform3f(const char* pUniformName, GLfloat v0, GLfloat v1, GLfloat v2);
@@ -0,0 +1,81 @@
+#include "RenderState.hpp"
+
+#include <algorithm>
+
+namespace duke {
+namespace gl {
+
+const GLuint RenderState::UNKNOWN;
+
+RenderState& RenderState::current() { return forContext(glfwGetCurrentContext()); }
+
+RenderState& RenderState::forContext(const GLFWwindow* pContext) {
+  thread_local RenderState state;
+  // bindings belong to the context, not to the thread
+  if (pContext != state.m_pContext) {
+    state.invalidate();
+    state.m_pContext = pContext;
+  }
+  return state;
+}
+
+bool RenderState::useProgram(GLuint program) {
+  if (program == m_Program) return false;
+  glUseProgram(program);
+  m_Program = program;
+  return true;
+}
+
+bool RenderState::activeTexture(GLuint unit) {
+  if (unit == m_ActiveUnit) return false;
+  glActiveTexture(GL_TEXTURE0 + unit);
+  m_ActiveUnit = unit;
+  return true;
+}
+
+GLuint RenderState::getActiveTexture() {
+  if (m_ActiveUnit == UNKNOWN) {
+    GLint active = GL_TEXTURE0;
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &active);
+    m_ActiveUnit = active - GL_TEXTURE0;
+  }
+  return m_ActiveUnit;
+}
+
+bool RenderState::bindTexture(GLenum target, GLuint texture) {
+  return bindTexture(getActiveTexture(), target, texture);
+}
+
+bool RenderState::bindTexture(GLuint unit, GLenum target, GLuint texture) {
+  auto pFound = std::find_if(m_Textures.begin(), m_Textures.end(), [=](const TextureBinding& binding) {
+    return binding.unit == unit && binding.target == target;
+  });
+  if (pFound != m_Textures.end() && pFound->texture == texture) return false;
+  activeTexture(unit);
+  glBindTexture(target, texture);
+  if (pFound == m_Textures.end())
+    m_Textures.push_back(TextureBinding{unit, target, texture});
+  else
+    pFound->texture = texture;
+  return true;
+}
+
+void RenderState::programDeleted(GLuint program) {
+  // a program in use is only flagged for deletion, its name must not be trusted anymore
+  if (program == m_Program) m_Program = UNKNOWN;
+}
+
+void RenderState::textureDeleted(GLuint texture) {
+  // deleting a texture reverts its bindings in the current context to zero
+  for (auto& binding : m_Textures)
+    if (binding.texture == texture) binding.texture = 0;
+}
+
+void RenderState::invalidate() {
+  m_Program = UNKNOWN;
+  m_ActiveUnit = UNKNOWN;
+  m_Textures.clear();
+}
+
+} /* namespace gl */
+} /* namespace duke */
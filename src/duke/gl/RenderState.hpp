@@ -0,0 +1,54 @@
+#pragma once
+
+#include <duke/base/NonCopyable.hpp>
+#include <duke/gl/GL.hpp>
+
+#include <vector>
+
+namespace duke {
+namespace gl {
+
+/**
+ * Shadows the bound program and the textures bound to each texture unit so
+ * that redundant glUseProgram, glActiveTexture and glBindTexture calls are
+ * skipped.
+ * - There is one instance per thread, it shadows the context current on it
+ *   and forgets everything when another context is made current.
+ * - Program and the texture objects go through it, code changing this state
+ *   behind its back must call invalidate(). So must a thread making a context
+ *   current again after another thread used it.
+ * - Methods return true if a GL call was issued.
+ */
+struct RenderState : public noncopyable {
+  static RenderState& current();
+  // current() for the given context, exposed for tests.
+  static RenderState& forContext(const GLFWwindow* pContext);
+
+  bool useProgram(GLuint program);
+  bool activeTexture(GLuint unit);
+  GLuint getActiveTexture();
+  // On the active texture unit.
+  bool bindTexture(GLenum target, GLuint texture);
+  bool bindTexture(GLuint unit, GLenum target, GLuint texture);
+
+  // Deleted names can be reused by the driver.
+  void programDeleted(GLuint program);
+  void textureDeleted(GLuint texture);
+
+  void invalidate();
+
+ private:
+  static const GLuint UNKNOWN = ~0u;
+  struct TextureBinding {
+    GLuint unit;
+    GLenum target;
+    GLuint texture;
+  };
+  const GLFWwindow* m_pContext = nullptr;
+  GLuint m_Program = UNKNOWN;
+  GLuint m_ActiveUnit = UNKNOWN;
+  std::vector<TextureBinding> m_Textures;  // unknown bindings are absent
+};
+
+} /* namespace gl */
+} /* namespace duke */
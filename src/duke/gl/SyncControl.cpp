@@ -0,0 +1,80 @@
+#include "SyncControl.hpp"
+
+#include <duke/gl/GL.hpp>
+
+#if defined(__linux__)
+#define DUKE_GLX_SYNC_CONTROL
+#define GLFW_EXPOSE_NATIVE_X11
+#define GLFW_EXPOSE_NATIVE_GLX
+#include <GLFW/glfw3native.h>
+#include <GL/glx.h>
+#include <cstring>
+#endif
+
+namespace duke {
+
+#ifdef DUKE_GLX_SYNC_CONTROL
+
+namespace {
+
+typedef Bool (*GetSyncValuesOML)(Display*, GLXDrawable, int64_t*, int64_t*, int64_t*);
+typedef Bool (*GetMscRateOML)(Display*, GLXDrawable, int32_t*, int32_t*);
+
+bool hasExtension(Display* pDisplay, const char* pName) {
+  const char* pExtensions = glXQueryExtensionsString(pDisplay, DefaultScreen(pDisplay));
+  if (!pExtensions) return false;
+  const size_t length = strlen(pName);
+  for (const char* pFound = strstr(pExtensions, pName); pFound; pFound = strstr(pFound + length, pName))
+    if ((pFound == pExtensions || pFound[-1] == ' ') && (pFound[length] == ' ' || pFound[length] == '\0'))
+      return true;
+  return false;
+}
+
+// glfwGetGLXWindow is only valid for contexts created through GLX, not EGL.
+bool isGlxContext(GLFWwindow* pWindow) {
+#ifdef GLFW_CONTEXT_CREATION_API
+  return glfwGetWindowAttrib(pWindow, GLFW_CONTEXT_CREATION_API) == GLFW_NATIVE_CONTEXT_API;
+#else
+  (void)pWindow;
+  return true;  // GLFW before 3.2 always creates X11 contexts through GLX
+#endif
+}
+
+}  // namespace
+
+SyncControl::SyncControl(GLFWwindow* pWindow) {
+  Display* pDisplay = glfwGetX11Display();
+  const GLXWindow drawable = pDisplay && isGlxContext(pWindow) ? glfwGetGLXWindow(pWindow) : 0;
+  if (!drawable || !hasExtension(pDisplay, "GLX_OML_sync_control")) return;
+  m_pDisplay = pDisplay;
+  m_Drawable = drawable;
+  m_pGetMscRate = reinterpret_cast<void*>(glXGetProcAddressARB((const GLubyte*)"glXGetMscRateOML"));
+  m_pGetSyncValues = reinterpret_cast<void*>(glXGetProcAddressARB((const GLubyte*)"glXGetSyncValuesOML"));
+}
+
+bool SyncControl::getRefreshRate(int32_t& numerator, int32_t& denominator) const {
+  if (!m_pGetMscRate) return false;
+  const auto getMscRate = reinterpret_cast<GetMscRateOML>(m_pGetMscRate);
+  return getMscRate(static_cast<Display*>(m_pDisplay), m_Drawable, &numerator, &denominator) && numerator > 0 &&
+         denominator > 0;
+}
+
+bool SyncControl::getCounter(int64_t& counter) const {
+  if (!m_pGetSyncValues) return false;
+  const auto getSyncValues = reinterpret_cast<GetSyncValuesOML>(m_pGetSyncValues);
+  int64_t ust = 0;
+  int64_t sbc = 0;
+  return getSyncValues(static_cast<Display*>(m_pDisplay), m_Drawable, &ust, &counter, &sbc);
+}
+
+#else
+
+SyncControl::SyncControl(GLFWwindow*) {}
+
+bool SyncControl::getRefreshRate(int32_t&, int32_t&) const { return false; }
+
+bool SyncControl::getCounter(int64_t&) const { return false; }
+
+#endif
+
+} /* namespace duke */
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+struct GLFWwindow;
+
+namespace duke {
+
+/**
+ * Vertical blank counter of the window's screen through GLX_OML_sync_control.
+ * Unavailable on other platforms, with EGL or when the driver lacks it.
+ */
+class SyncControl {
+ public:
+  SyncControl(GLFWwindow* pWindow);
+
+  bool isAvailable() const { return m_pGetSyncValues != nullptr; }
+
+  // Refresh rate in Hz as numerator / denominator.
+  bool getRefreshRate(int32_t& numerator, int32_t& denominator) const;
+  // Media stream counter, incremented at each vertical blank.
+  bool getCounter(int64_t& counter) const;
+
+ private:
+  void* m_pDisplay = nullptr;
+  unsigned long m_Drawable = 0;
+  void* m_pGetSyncValues = nullptr;
+  void* m_pGetMscRate = nullptr;
+};
+
+} /* namespace duke */
@@ -0,0 +1,162 @@
+#include "TextureFormats.hpp"
+#include <duke/filesystem/FsUtils.hpp>
+#include <duke/gl/GLUtils.hpp>
+#include <duke/gl/GlObjects.hpp>
+#include <duke/time/Clock.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+
+namespace duke {
+
+std::vector<GLint> TextureFormatTable::getCandidates(GLint glFormat) {
+  switch (glFormat) {
+    case GL_RGB8:
+      return {GL_RGB8, GL_RGBA8};
+    case GL_RGB16:
+      return {GL_RGB16, GL_RGBA16};
+    case GL_RGB16F:
+      return {GL_RGB16F, GL_RGBA16F};
+    case GL_RGB32F:
+      return {GL_RGB32F, GL_RGBA32F};
+    default:
+      return {getAdaptedInternalFormat(glFormat)};
+  }
+}
+
+GLint TextureFormatTable::get(GLint glFormat) const {
+  const auto pFound = m_Formats.find(glFormat);
+  if (pFound == m_Formats.end()) return getAdaptedInternalFormat(glFormat);
+  return pFound->second;
+}
+
+void TextureFormatTable::set(GLint glFormat, GLint internalFormat) { m_Formats[glFormat] = internalFormat; }
+
+void TextureFormatTable::read(std::istream& stream, const std::string& driver) {
+  std::string line;
+  while (std::getline(stream, line)) {
+    const auto tab = line.find('\t');
+    if (tab == std::string::npos || line.compare(0, tab, driver) != 0 || tab != driver.size()) continue;
+    std::istringstream values(line.substr(tab + 1));
+    GLint glFormat, internalFormat;
+    if (!(values >> glFormat >> internalFormat)) continue;
+    const auto candidates = getCandidates(glFormat);
+    // ignoring entries written by a version with other candidates
+    if (std::find(candidates.begin(), candidates.end(), internalFormat) == candidates.end()) continue;
+    set(glFormat, internalFormat);
+  }
+}
+
+void TextureFormatTable::write(std::istream& previous, std::ostream& stream, const std::string& driver) const {
+  const std::string prefix = driver + '\t';
+  std::string line;
+  while (std::getline(previous, line))
+    if (line.compare(0, prefix.size(), prefix) != 0) stream << line << '\n';
+  for (const auto& pair : m_Formats) stream << prefix << pair.first << '\t' << pair.second << '\n';
+}
+
+std::string getDriverName() {
+  const auto toString = [](GLenum name) {
+    const auto pString = reinterpret_cast<const char*>(glGetString(name));
+    return std::string(pString ? pString : "unknown");
+  };
+  return toString(GL_VENDOR) + " / " + toString(GL_RENDERER) + " / " + toString(GL_VERSION);
+}
+
+namespace {
+
+// The source layouts produced by the readers.
+const GLint kSourceFormats[] = {GL_R8, GL_R32F, GL_RGB8, GL_RGB16, GL_RGB16F, GL_RGB32F, GL_RGBA8, GL_RGBA16,
+                                GL_RGBA16F, GL_RGBA32F, GL_RGB10_A2UI};
+
+TextureFormatTable gNegotiated;
+
+const char kCacheSubdirectory[] = "/duke";
+
+std::string getCacheFilename() {
+  const std::string cache = getUserCacheDirectory();
+  return cache.empty() ? cache : cache + kCacheSubdirectory + "/texture-formats";
+}
+
+// True if the driver takes pixels of the source layout as is for this internal format.
+bool isNativeUpload(GLint glFormat, GLint internalFormat) {
+  GLint format = 0, type = 0;
+  glGetInternalformativ(GL_TEXTURE_RECTANGLE, internalFormat, GL_TEXTURE_IMAGE_FORMAT, 1, &format);
+  glGetInternalformativ(GL_TEXTURE_RECTANGLE, internalFormat, GL_TEXTURE_IMAGE_TYPE, 1, &type);
+  return GLenum(format) == getPixelFormat(glFormat) && GLenum(type) == getPixelType(glFormat);
+}
+
+// Microseconds to upload a few frames of the source layout into the internal format.
+int64_t timeUpload(GLint glFormat, GLint internalFormat) {
+  const GLsizei size = 512;
+  const size_t iterations = 8;
+  const GLenum format = getPixelFormat(glFormat);
+  const GLenum type = getPixelType(glFormat);
+  const std::vector<char> data(size * size * 16);  // large enough for four 32 bits channels
+  gl::GlTextureRectangle texture;
+  auto bound = texture.scope_bind_texture();
+  glTexImage2D(texture.target, 0, internalFormat, size, size, 0, format, type, nullptr);
+  glTexSubImage2D(texture.target, 0, 0, 0, size, size, format, type, data.data());  // warming up
+  glFinish();
+  StopWatch watch;
+  for (size_t i = 0; i < iterations; ++i)
+    glTexSubImage2D(texture.target, 0, 0, 0, size, size, format, type, data.data());
+  glFinish();
+  return watch.elapsedMicroSeconds().count();
+}
+
+GLint negotiate(GLint glFormat, bool timedUploads) {
+  const auto candidates = TextureFormatTable::getCandidates(glFormat);
+  if (candidates.size() == 1) return candidates.front();
+  if (timedUploads) {
+    GLint fastest = candidates.front();
+    int64_t fastestTime = timeUpload(glFormat, fastest);
+    for (auto itr = candidates.begin() + 1; itr != candidates.end(); ++itr) {
+      const auto time = timeUpload(glFormat, *itr);
+      if (time < fastestTime) std::tie(fastest, fastestTime) = std::make_tuple(*itr, time);
+    }
+    return fastest;
+  }
+  if (glfwExtensionSupported("GL_ARB_internalformat_query2"))
+    for (const GLint candidate : candidates)
+      if (isNativeUpload(glFormat, candidate)) return candidate;
+  return candidates.front();
+}
+
+}  // namespace
+
+void negotiateTextureFormats(bool timedUploads) {
+  const std::string driver = getDriverName();
+  const std::string filename = getCacheFilename();
+  TextureFormatTable table;
+  if (!timedUploads && !filename.empty()) {
+    std::ifstream stream(filename);
+    table.read(stream, driver);
+  }
+  if (!table.empty()) {
+    gNegotiated = table;
+    return;
+  }
+  for (const GLint glFormat : kSourceFormats) table.set(glFormat, negotiate(glFormat, timedUploads));
+  glCheckError();
+  gNegotiated = table;
+  if (filename.empty() || !createDirectories(getUserCacheDirectory() + kCacheSubdirectory)) return;
+  std::stringstream previous;
+  {
+    std::ifstream stream(filename);
+    previous << stream.rdbuf();
+  }
+  std::ostringstream content;
+  table.write(previous, content, driver);
+  const std::string bytes = content.str();
+  // other instances may read the file while it is replaced
+  writeFileAtomically(filename,
+                      [&](FILE* pFile) { return fwrite(bytes.data(), 1, bytes.size(), pFile) == bytes.size(); });
+}
+
+GLint getNegotiatedInternalFormat(GLint glFormat) { return gNegotiated.get(glFormat); }
+
+} /* namespace duke */
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <duke/gl/GL.hpp>
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace duke {
+
+/**
+ * Internal format picked for each source layout, a source layout being the
+ * glFormat of a FrameDescription. Uploading into a format the driver does not
+ * store natively triggers a slow swizzle or repack, so the table holds the
+ * format negotiated with the current driver.
+ */
+class TextureFormatTable {
+ public:
+  // Internal formats able to hold the source layout, the first one is the default.
+  static std::vector<GLint> getCandidates(GLint glFormat);
+
+  // Falls back to getAdaptedInternalFormat for unknown layouts.
+  GLint get(GLint glFormat) const;
+  void set(GLint glFormat, GLint internalFormat);
+  bool empty() const { return m_Formats.empty(); }
+
+  // The cache file holds one "driver<TAB>glFormat<TAB>internalFormat" line per
+  // entry, lines from other drivers are kept untouched when saving.
+  void read(std::istream& stream, const std::string& driver);
+  void write(std::istream& previous, std::ostream& stream, const std::string& driver) const;
+
+ private:
+  std::map<GLint, GLint> m_Formats;
+};
+
+// Vendor, renderer and version of the current context.
+std::string getDriverName();
+
+// Fills the process wide table used by Texture::initialize, reusing the
+// choices stored for this driver if any. The current driver is asked for its
+// preferred upload format with glGetInternalformativ when supported, timed
+// uploads of each candidate can be requested instead.
+void negotiateTextureFormats(bool timedUploads);
+
+// Internal format to use for the source layout.
+GLint getNegotiatedInternalFormat(GLint glFormat);
+
+} /* namespace duke */
@@ -1,12 +1,13 @@
 #include "Textures.hpp"
 #include <duke/gl/GLUtils.hpp>
+#include <duke/gl/TextureFormats.hpp>
 #include <duke/engine/ImageLoadUtils.hpp>
 
 namespace duke {
 
 void Texture::initialize(const FrameDescription &description, const GLvoid *pData) {
   const auto packFormat = description.glFormat;
-  initialize(description, getAdaptedInternalFormat(packFormat), getPixelFormat(packFormat), getPixelType(packFormat),
+  initialize(description, getNegotiatedInternalFormat(packFormat), getPixelFormat(packFormat), getPixelType(packFormat),
              pData);
 }
 
@@ -30,4 +31,10 @@ void Texture::update(GLint xoffset, GLint yoffset, GLsizei width, GLsizei height
   glCheckError();
 }
 
+void Texture::generateMipmaps() {
+  glCheckBound(target, id);
+  glGenerateMipmap(target);
+  glCheckError();
+}
+
 }  // namespace duke
@@ -5,12 +5,16 @@
 
 namespace duke {
 
-struct Texture : public gl::GlTextureRectangle {
+// GL_TEXTURE_RECTANGLE by default, GL_TEXTURE_2D textures can hold a mip chain.
+struct Texture : public gl::GlTextureObject {
+  Texture(GLenum target = GL_TEXTURE_RECTANGLE) : gl::GlTextureObject(target) {}
   void initialize(const FrameDescription &description, const GLvoid *pData = nullptr);
   void initialize(const FrameDescription &description, GLint internalFormat, GLenum format, GLenum type,
                   const GLvoid *pData);
   void update(GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type,
               const GLvoid *pData);
+  // Builds the mip chain from level 0, only for GL_TEXTURE_2D.
+  void generateMipmaps();
 
   FrameDescription description;
 };
@@ -9,13 +9,29 @@ struct FrameDescription {
   size_t dataSize;
   bool swapEndianness;
   bool swapRedAndBlue;
+  // Part of the image held in the data when the reader decoded a region of
+  // interest. A zero dataWidth means the data covers the whole image.
+  size_t dataX, dataY, dataWidth, dataHeight;
 
-  FrameDescription() : width(0), height(0), glFormat(0), dataSize(0), swapEndianness(false), swapRedAndBlue(false) {}
+  FrameDescription()
+      : width(0),
+        height(0),
+        glFormat(0),
+        dataSize(0),
+        swapEndianness(false),
+        swapRedAndBlue(false),
+        dataX(0),
+        dataY(0),
+        dataWidth(0),
+        dataHeight(0) {}
 
+  inline bool isPartial() const { return dataWidth != 0; }
+  inline size_t getDataWidth() const { return isPartial() ? dataWidth : width; }
+  inline size_t getDataHeight() const { return isPartial() ? dataHeight : height; }
+
+  // Only the image shape is compared, a texture can hold any data window.
   bool operator<(const FrameDescription &other) const { return asTuple() < other.asTuple(); }
 
  private:
-  inline const std::tuple<size_t, size_t, size_t, size_t> asTuple() const {
-    return std::make_tuple(width, height, glFormat, dataSize);
-  }
+  inline const std::tuple<size_t, size_t, size_t> asTuple() const { return std::make_tuple(width, height, glFormat); }
 };
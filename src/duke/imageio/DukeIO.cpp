@@ -25,6 +25,12 @@ const deque<IIODescriptor*>& IODescriptors::findDescriptor(const char* extension
   return EmptyVector;
 }
 
+const IIODescriptor* IODescriptors::findWriterDescriptor(const char* extension) const {
+  for (const IIODescriptor* pDescriptor : findDescriptor(extension))
+    if (pDescriptor->supports(IIODescriptor::Capability::WRITER_TO_FILE)) return pDescriptor;
+  return nullptr;
+}
+
 bool IODescriptors::isSupported(const char* extension) const {
   return m_ExtensionToDescriptors.find(extension) != m_ExtensionToDescriptors.end();
 }
@@ -30,6 +30,11 @@
  *
  * If plugin is persistent, pairs of setup/read or setup/write functions are
  * allowed. The plugin must configure it's state accordingly.
+ *
+ * Writers get the frame description and attributes in 'setup' and the pixels
+ * in 'writeImageData', laid out as a reader would produce them: rows top to
+ * bottom unless DpxImageOrientation is 4, red first unless swapRedAndBlue is
+ * set. Writer instances are used for a single file and may run concurrently.
  */
 
 #pragma once
@@ -73,14 +78,26 @@ class IImageReader : public noncopyable {
 };
 
 class IImageWriter : public noncopyable {
+ protected:
+  virtual bool doSetup(const FrameDescription& description, const attribute::Attributes& attributes) = 0;
+  const IIODescriptor* const m_pDescriptor;
   attribute::Attributes m_WriterAttributes;
   std::string m_Error;
 
  public:
+  IImageWriter(const attribute::Attributes& options, const IIODescriptor* pDescriptor)
+      : m_pDescriptor(pDescriptor), m_WriterAttributes(options) {}
   virtual ~IImageWriter() {}
-  inline const std::string& getError() const { return m_Error; }
-  inline attribute::Attributes& getAttributes() { return m_WriterAttributes; }
-  virtual bool setup(const attribute::Attributes& input) { return false; }
+  inline bool hasError() const { return !m_Error.empty(); }
+  inline std::string getError() {
+    std::string copy;
+    copy.swap(m_Error);  // reading error clears it.
+    return copy;
+  }
+  inline const attribute::Attributes& getAttributes() const { return m_WriterAttributes; }
+  inline const IIODescriptor* getDescriptor() const { return m_pDescriptor; }
+  inline bool setup(const FrameDescriptionAndAttributes& frame) { return doSetup(frame.description, frame.attributes); }
+  virtual void writeImageData(const void* pData) { m_Error = "Unsupported writeImageData"; }
 };
 
 }  // namespace duke
@@ -96,6 +113,7 @@ class IIODescriptor : public noncopyable {
     READER_GENERAL_PURPOSE,   // Plugin can read several formats
     READER_FILE_SEQUENCE,     // Plugin will be instantiated for each frame
                               // read will be parallel and out of order
+    WRITER_TO_FILE,           // Plugin implements getWriterToFile
   };
   virtual ~IIODescriptor() {}
   virtual const std::vector<std::string>& getSupportedExtensions() const = 0;
@@ -130,6 +148,9 @@ class IODescriptors : public noncopyable {
 
   const std::deque<IIODescriptor*>& findDescriptor(const char* extension) const;
 
+  // First descriptor able to write this extension, nullptr if none.
+  const IIODescriptor* findWriterDescriptor(const char* extension) const;
+
   bool isSupported(const char* extension) const;
 
   inline const std::vector<std::unique_ptr<IIODescriptor> >& getDescriptors() const { return m_Descriptors; }
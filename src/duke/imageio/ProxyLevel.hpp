@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+
+namespace duke {
+
+// Proxy levels range from 0 (full resolution) to MAX_PROXY_LEVEL (1/8th).
+const uint8_t MAX_PROXY_LEVEL = 3;
+
+}  // namespace duke
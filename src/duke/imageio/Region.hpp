@@ -0,0 +1,74 @@
+#pragma once
+
+#include <duke/attributes/AttributeKeys.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+
+namespace duke {
+
+/**
+ * A part of an image expressed in cells of 1/GRID_SIZE of the image dimension.
+ * Coarse cells keep cache keys stable while the user pans.
+ * - x0, y0 are included, x1, y1 are excluded.
+ * - rows are in file order, y = 0 is the first scanline.
+ */
+struct Region {
+  static const uint8_t GRID_SIZE = 16;
+
+  uint8_t x0, y0, x1, y1;
+
+  Region() : x0(0), y0(0), x1(GRID_SIZE), y1(GRID_SIZE) {}
+  Region(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) : x0(x0), y0(y0), x1(x1), y1(y1) {}
+
+  // Smallest region covering the normalized rectangle, never empty.
+  static Region fromNormalized(float left, float top, float right, float bottom) {
+    const float grid = GRID_SIZE;
+    const auto lower = [=](float value) {
+      return uint8_t(std::min(std::floor(std::max(value, 0.f) * grid), grid - 1));
+    };
+    const auto upper = [=](float value) {
+      return uint8_t(std::min(std::ceil(std::max(value, 0.f) * grid), grid));
+    };
+    const uint8_t x0 = lower(left);
+    const uint8_t y0 = lower(top);
+    return Region(x0, y0, std::max<uint8_t>(upper(right), x0 + 1), std::max<uint8_t>(upper(bottom), y0 + 1));
+  }
+
+  bool isFull() const { return *this == Region(); }
+
+  bool contains(const Region& other) const {
+    return x0 <= other.x0 && y0 <= other.y0 && x1 >= other.x1 && y1 >= other.y1;
+  }
+
+  // Pixel bounds for an image of the given dimensions.
+  size_t left(size_t width) const { return width * x0 / GRID_SIZE; }
+  size_t right(size_t width) const { return width * x1 / GRID_SIZE; }
+  size_t top(size_t height) const { return height * y0 / GRID_SIZE; }
+  size_t bottom(size_t height) const { return height * y1 / GRID_SIZE; }
+
+  bool operator==(const Region& other) const { return asTuple() == other.asTuple(); }
+  bool operator!=(const Region& other) const { return asTuple() != other.asTuple(); }
+  bool operator<(const Region& other) const { return asTuple() < other.asTuple(); }
+
+ private:
+  inline std::tuple<uint8_t, uint8_t, uint8_t, uint8_t> asTuple() const { return std::make_tuple(x0, y0, x1, y1); }
+};
+
+inline Region getRegionOfInterest(const attribute::Attributes& attributes) {
+  if (!attribute::contains<attribute::RegionOfInterest>(attributes)) return Region();
+  const auto cells = attribute::getOrDie<attribute::RegionOfInterest>(attributes);
+  if (cells.size() != 4) return Region();
+  const uint8_t* pCells = cells.begin();
+  return Region(pCells[0], pCells[1], pCells[2], pCells[3]);
+}
+
+inline void setRegionOfInterest(attribute::Attributes& attributes, const Region& region) {
+  const uint8_t cells[] = {region.x0, region.y0, region.x1, region.y1};
+  attribute::set<attribute::RegionOfInterest>(attributes, Slice<const uint8_t>(cells));
+}
+
+}  // namespace duke
@@ -6,9 +6,14 @@
 #include <duke/gl/GL.hpp>
 #include <duke/image/FrameDescription.hpp>
 #include <duke/imageio/DukeIO.hpp>  // for IIODescriptor::Capability, etc
+#include <duke/imageio/ProxyLevel.hpp>
+#include <duke/imageio/Region.hpp>
 
 #include <stddef.h>  // for size_t
 #include <stdint.h>  // for int32_t
+#include <stdio.h>   // for FILE
+#include <string.h>  // for memcpy
+#include <algorithm>  // for min
 #include <string>    // for string
 #include <vector>    // for vector
 
@@ -76,6 +81,9 @@ namespace duke {
 
 class FastDpxImageReader : public IImageReader {
   const void* m_pData;
+  const uint32_t* m_pImageData;
+  size_t m_FullWidth, m_Width, m_FirstLine, m_LineCount;
+  uint8_t m_ProxyLevel;
   const FileInformation* pInformation;
   const char* pArithmeticPointer;
   const Image_Information* pImageInformation;
@@ -92,6 +100,12 @@ class FastDpxImageReader : public IImageReader {
                      const size_t dataSize)
       : IImageReader(options, pDesc),
         m_pData(nullptr),
+        m_pImageData(nullptr),
+        m_FullWidth(0),
+        m_Width(0),
+        m_FirstLine(0),
+        m_LineCount(0),
+        m_ProxyLevel(0),
         pInformation(reinterpret_cast<const FileInformation*>(pData)),
         pArithmeticPointer(reinterpret_cast<const char*>(pData)),
         pImageInformation(reinterpret_cast<const Image_Information*>(pArithmeticPointer + sizeof(FileInformation))),
@@ -112,22 +126,172 @@ class FastDpxImageReader : public IImageReader {
 
   virtual bool doSetup(FrameDescription& description, attribute::Attributes& attributes) override {
     m_pData = nullptr;
-    description.height = swap(pImageInformation->lines_per_image_ele);
-    description.width = swap(pImageInformation->pixels_per_line);
-    m_pData = pArithmeticPointer + swap(pInformation->offset);
+    m_ProxyLevel = std::min(attribute::getWithDefault<attribute::ProxyLevel>(attributes), MAX_PROXY_LEVEL);
+    const size_t rounding = (1 << m_ProxyLevel) - 1;
+    const size_t fullHeight = swap(pImageInformation->lines_per_image_ele);
+    m_FullWidth = swap(pImageInformation->pixels_per_line);
+    description.height = (fullHeight + rounding) >> m_ProxyLevel;
+    description.width = m_Width = (m_FullWidth + rounding) >> m_ProxyLevel;
+    // scanlines are contiguous, a band of full width lines is still zero copy
+    const Region region = getRegionOfInterest(attributes);
+    m_FirstLine = region.top(description.height);
+    m_LineCount = region.bottom(description.height) - m_FirstLine;
+    if (!region.isFull()) {
+      description.dataY = m_FirstLine;
+      description.dataWidth = description.width;
+      description.dataHeight = m_LineCount;
+    }
+    m_pImageData = reinterpret_cast<const uint32_t*>(pArithmeticPointer + swap(pInformation->offset));
+    // full resolution is zero copy, proxies are subsampled in readImageDataTo
+    if (m_ProxyLevel == 0) m_pData = m_pImageData + m_FirstLine * m_FullWidth;
     description.swapEndianness = bigEndian;
     description.glFormat = GL_RGB10_A2UI;
-    description.dataSize = description.height * description.width * sizeof(int32_t);
+    description.dataSize = m_LineCount * description.width * sizeof(int32_t);
     attribute::set<attribute::DpxImageOrientation>(attributes, pImageInformation->orientation);
+    attribute::set<attribute::ProxyLevel>(attributes, m_ProxyLevel);
     return true;
   }
 
   virtual const void* getMappedImageData() const override { return m_pData; }
+
+  // Nearest neighbor subsampling, a packed 10 bits pixel is a single 32 bits word.
+  virtual void readImageDataTo(void* pData) override {
+    uint32_t* pDst = reinterpret_cast<uint32_t*>(pData);
+    for (size_t y = m_FirstLine; y < m_FirstLine + m_LineCount; ++y) {
+      const uint32_t* pSrcLine = m_pImageData + (y << m_ProxyLevel) * m_FullWidth;
+      for (size_t x = 0; x < m_Width; ++x) *pDst++ = pSrcLine[x << m_ProxyLevel];
+    }
+  }
+};
+
+// Writes 10 bits RGB, filled to 32 bits words (method A), big endian, top to bottom.
+class FastDpxImageWriter : public IImageWriter {
+  static const size_t kHeaderSize = 2048;  // generic and industry headers
+
+  FILE* m_pFile;
+  FrameDescription m_Description;
+  size_t m_Channels = 0;
+  size_t m_ChannelSize = 0;  // 0 for packed 10 bits words
+  bool m_BottomUp = false;
+
+  static uint32_t reverse(uint32_t value) {
+    return (value >> 24) | ((value >> 8) & 0xFF00) | ((value << 8) & 0xFF0000) | (value << 24);
+  }
+
+  static void writeBigEndian32(std::vector<char>& buffer, size_t offset, uint32_t value) {
+    for (size_t i = 0; i < 4; ++i) buffer[offset + i] = char(value >> (24 - 8 * i));
+  }
+
+  static void writeBigEndian16(std::vector<char>& buffer, size_t offset, uint16_t value) {
+    buffer[offset] = char(value >> 8);
+    buffer[offset + 1] = char(value);
+  }
+
+  // 10 bits code value of a channel of the pixel starting at pPixel.
+  uint32_t getCodeValue(const char* pPixel, size_t channel) const {
+    if (m_ChannelSize == 1) return uint32_t(uint8_t(pPixel[channel])) * 1023 / 255;
+    uint16_t value;
+    memcpy(&value, pPixel + channel * 2, 2);
+    if (m_Description.swapEndianness) value = uint16_t(value >> 8 | value << 8);
+    return value >> 6;
+  }
+
+ public:
+  FastDpxImageWriter(const attribute::Attributes& options, const IIODescriptor* pDesc, const char* filename)
+      : IImageWriter(options, pDesc), m_pFile(fopen(filename, "wb")) {
+    if (!m_pFile) m_Error = "Unable to open";
+  }
+
+  ~FastDpxImageWriter() {
+    if (m_pFile) fclose(m_pFile);
+  }
+
+  virtual bool doSetup(const FrameDescription& description, const attribute::Attributes& attributes) override {
+    if (hasError()) return false;
+    switch (description.glFormat) {
+      case GL_RGB10_A2UI:
+        m_Channels = 3;
+        m_ChannelSize = 0;
+        break;
+      case GL_RGB8:
+      case GL_RGBA8:
+        m_Channels = description.glFormat == GL_RGB8 ? 3 : 4;
+        m_ChannelSize = 1;
+        break;
+      case GL_RGB16:
+      case GL_RGBA16:
+        m_Channels = description.glFormat == GL_RGB16 ? 3 : 4;
+        m_ChannelSize = 2;
+        break;
+      default:
+        m_Error = "Unsupported format";
+        return false;
+    }
+    if (description.isPartial()) {
+      m_Error = "Can't write a partial image";
+      return false;
+    }
+    m_Description = description;
+    m_BottomUp = attribute::getWithDefault<attribute::DpxImageOrientation>(attributes) == 4;
+    const uint32_t fileSize = kHeaderSize + description.width * description.height * sizeof(uint32_t);
+    std::vector<char> header(kHeaderSize);
+    writeBigEndian32(header, 0, DPX_MAGIC);
+    writeBigEndian32(header, 4, kHeaderSize);
+    memcpy(&header[8], "V2.0", 4);
+    writeBigEndian32(header, 16, fileSize);
+    writeBigEndian32(header, 20, 1);            // ditto key, new frame
+    writeBigEndian32(header, 24, 1664);         // generic header size
+    writeBigEndian32(header, 28, 384);          // industry header size
+    writeBigEndian32(header, 660, 0xFFFFFFFF);  // unencrypted
+    writeBigEndian16(header, 768, 0);           // orientation, left to right, top to bottom
+    writeBigEndian16(header, 770, 1);           // element count
+    writeBigEndian32(header, 772, description.width);
+    writeBigEndian32(header, 776, description.height);
+    writeBigEndian32(header, 792, 1023);  // reference high data
+    header[800] = 50;                     // RGB descriptor
+    header[803] = 10;                     // bit size
+    writeBigEndian16(header, 804, 1);     // filled to 32 bits words
+    writeBigEndian32(header, 808, kHeaderSize);
+    if (fwrite(header.data(), header.size(), 1, m_pFile) != 1) {
+      m_Error = "Unable to write header";
+      return false;
+    }
+    return true;
+  }
+
+  virtual void writeImageData(const void* pData) override {
+    if (hasError() || !pData) return;
+    const size_t width = m_Description.width;
+    const size_t height = m_Description.height;
+    const size_t pixelSize = m_ChannelSize ? m_Channels * m_ChannelSize : sizeof(uint32_t);
+    const size_t red = m_Description.swapRedAndBlue ? 2 : 0;
+    std::vector<char> line(width * sizeof(uint32_t));
+    for (size_t row = 0; row < height; ++row) {
+      const size_t y = m_BottomUp ? height - 1 - row : row;
+      const char* pLine = reinterpret_cast<const char*>(pData) + y * width * pixelSize;
+      for (size_t x = 0; x < width; ++x) {
+        const char* pPixel = pLine + x * pixelSize;
+        uint32_t word;
+        if (m_ChannelSize == 0) {
+          memcpy(&word, pPixel, sizeof(word));
+          if (m_Description.swapEndianness) word = reverse(word);
+        } else {
+          word = getCodeValue(pPixel, red) << 22 | getCodeValue(pPixel, 1) << 12 | getCodeValue(pPixel, 2 - red) << 2;
+        }
+        writeBigEndian32(line, x * sizeof(uint32_t), word);
+      }
+      if (fwrite(line.data(), line.size(), 1, m_pFile) != 1) {
+        m_Error = "Unable to write to file";
+        return;
+      }
+    }
+  }
 };
 
 class FastDpxDescriptor : public IIODescriptor {
   virtual bool supports(Capability capability) const override {
-    return capability == Capability::READER_READ_FROM_MEMORY || capability == Capability::READER_FILE_SEQUENCE;
+    return capability == Capability::READER_READ_FROM_MEMORY || capability == Capability::READER_FILE_SEQUENCE ||
+           capability == Capability::WRITER_TO_FILE;
   }
   virtual const std::vector<std::string>& getSupportedExtensions() const override {
     static std::vector<std::string> extensions = {"dpx"};
@@ -138,6 +302,9 @@ class FastDpxDescriptor : public IIODescriptor {
                                             const size_t dataSize) const override {
     return new FastDpxImageReader(options, this, pData, dataSize);
   }
+  virtual IImageWriter* getWriterToFile(const attribute::Attributes& options, const char* filename) const override {
+    return new FastDpxImageWriter(options, this, filename);
+  }
 };
 
 namespace {
@@ -3,8 +3,10 @@
 #include <duke/base/NonCopyable.hpp>
 #include <duke/imageio/DukeIO.hpp>
 #include <duke/attributes/AttributeKeys.hpp>
+#include <duke/imageio/ProxyLevel.hpp>
 #include <duke/gl/GL.hpp>
 
+#include <algorithm>
 #include <mutex>
 #include <memory>
 #include <vector>
@@ -329,13 +331,31 @@ struct StreamFrameDecoder {
 };
 
 struct PictureDecoder {
-  PictureDecoder(AVCodecContext* pCodecCtx) : width(pCodecCtx->width), height(pCodecCtx->height), m_pSwsCtx(nullptr) {
+  PictureDecoder(AVCodecContext* pCodecCtx)
+      : width(0),
+        height(0),
+        m_SrcWidth(pCodecCtx->width),
+        m_SrcHeight(pCodecCtx->height),
+        m_SrcFormat(pCodecCtx->pix_fmt),
+        m_pSwsCtx(nullptr) {
+    setProxyLevel(0);
+  }
+
+  // The codec decodes at full resolution, the picture is downscaled during
+  // color conversion. This saves conversion, memory and upload bandwidth.
+  void setProxyLevel(uint8_t level) {
+    const int rounding = (1 << level) - 1;
+    const int dstWidth = (m_SrcWidth + rounding) >> level;
+    const int dstHeight = (m_SrcHeight + rounding) >> level;
+    if (m_pSwsCtx && dstWidth == width && dstHeight == height) return;
+    width = dstWidth;
+    height = dstHeight;
     // fetching scaling context
     const int scalingFlags = SWS_POINT;
     SwsFilter* const pSrcFilter = nullptr;
     SwsFilter* const pDstFilter = nullptr;
     const double* const pParams = nullptr;
-    m_pSwsCtx = sws_getCachedContext(m_pSwsCtx, width, height, pCodecCtx->pix_fmt, width, height, PIX_FMT_RGB24,
+    m_pSwsCtx = sws_getCachedContext(m_pSwsCtx, m_SrcWidth, m_SrcHeight, m_SrcFormat, width, height, PIX_FMT_RGB24,
                                      scalingFlags, pSrcFilter, pDstFilter, pParams);
     if (!m_pSwsCtx) {
       throw std::runtime_error("cannot get valid context for image decoding");
@@ -355,7 +375,7 @@ struct PictureDecoder {
 
   const uint8_t* decodeFrame(const AVFrame* pFrame) const {
     uint8_t* pSrc = m_StridedBuffer.data();
-    if (sws_scale(m_pSwsCtx, pFrame->data, pFrame->linesize, 0, height, &pSrc, lineSizes) != pFrame->height) {
+    if (sws_scale(m_pSwsCtx, pFrame->data, pFrame->linesize, 0, m_SrcHeight, &pSrc, lineSizes) != height) {
       throw std::runtime_error("cannot decode image");
     }
     if (m_Buffer.size() == m_StridedBuffer.size()) {
@@ -378,9 +398,11 @@ struct PictureDecoder {
   }
 
  public:
-  const int width, height;
+  int width, height;
 
  private:
+  const int m_SrcWidth, m_SrcHeight;
+  const AVPixelFormat m_SrcFormat;
   int lineSize, roundedUpLineSize;
   struct SwsContext* m_pSwsCtx;
   mutable std::vector<uint8_t> m_StridedBuffer, m_Buffer;
@@ -429,7 +451,11 @@ class LibAVIOReader : public IImageReader {
   virtual bool doSetup(FrameDescription& description, attribute::Attributes& frameAttributes) override {
     try {
       const auto requestedFrame = attribute::getOrDie<attribute::MediaFrame>(frameAttributes);
+      const auto proxyLevel =
+          std::min(attribute::getWithDefault<attribute::ProxyLevel>(frameAttributes), MAX_PROXY_LEVEL);
       m_Decoder.decodeFrame(requestedFrame + m_Stream.getFirstFrame());
+      m_PictureDecoder.setProxyLevel(proxyLevel);
+      attribute::set<attribute::ProxyLevel>(frameAttributes, proxyLevel);
       description.width = m_PictureDecoder.width;
       description.height = m_PictureDecoder.height;
       description.dataSize = m_PictureDecoder.width * m_PictureDecoder.height * 3;
@@ -2,6 +2,8 @@
 
 #include <duke/attributes/Attribute.hpp>
 #include <duke/attributes/AttributeKeys.hpp> // attribute::PixelAspectRatio
+#include <duke/imageio/ProxyLevel.hpp>
+#include <duke/imageio/Region.hpp>
 #include <duke/imageio/DukeIO.hpp>
 #include <duke/gl/GL.hpp>
 
@@ -77,6 +79,10 @@ GLuint getGlType(const TypeDesc& typedesc, const vector<string>& channels) {
   return 0;
 }
 
+inline int alignDown(int value, int alignment) { return value - value % alignment; }
+
+inline int alignUp(int value, int alignment) { return alignDown(value + alignment - 1, alignment); }
+
 size_t getTypeSize(const TypeDesc& typedesc) {
   switch (typedesc.basetype) {
     case TypeDesc::UCHAR:
@@ -97,6 +103,51 @@ size_t getTypeSize(const TypeDesc& typedesc) {
   }
 }
 
+// Inverse of getGlType for the formats written, false if the format is not supported.
+bool getTypeDesc(size_t glFormat, TypeDesc& typedesc, int& channels) {
+  switch (glFormat) {
+    case GL_R8:
+    case GL_RGB8:
+    case GL_RGBA8:
+      typedesc = TypeDesc::UINT8;
+      break;
+    case GL_R16:
+    case GL_RGB16:
+    case GL_RGBA16:
+      typedesc = TypeDesc::UINT16;
+      break;
+    case GL_R16F:
+    case GL_RGB16F:
+    case GL_RGBA16F:
+      typedesc = TypeDesc::HALF;
+      break;
+    case GL_R32F:
+    case GL_RGB32F:
+    case GL_RGBA32F:
+      typedesc = TypeDesc::FLOAT;
+      break;
+    default:
+      return false;
+  }
+  switch (glFormat) {
+    case GL_R8:
+    case GL_R16:
+    case GL_R16F:
+    case GL_R32F:
+      channels = 1;
+      break;
+    case GL_RGB8:
+    case GL_RGB16:
+    case GL_RGB16F:
+    case GL_RGB32F:
+      channels = 3;
+      break;
+    default:
+      channels = 4;
+  }
+  return true;
+}
+
 template <typename T>
 void insert(attribute::Attributes& attributes, const char* const key, const void* const ptr, int aggregate) {
   CHECK(aggregate > 0);
@@ -112,6 +163,20 @@ void insert(attribute::Attributes& attributes, const char* const key, const void
 class OpenImageIOReader : public IImageReader {
   unique_ptr<ImageInput> m_pImageInput;
   ImageSpec m_Spec;
+  ImageSpec m_MipSpec;  // spec of the mip level being read
+  int m_MipLevel = 0;
+  // pixels to read in the mip level, the whole image unless a region of interest is requested
+  int m_Left = 0, m_Top = 0, m_Right = 0, m_Bottom = 0;
+  bool m_Partial = false;
+
+  // Moves to the coarsest available mip level not coarser than requested.
+  int seekMipLevel(int requested) {
+    if (requested == 0 && m_MipLevel == 0) return 0;
+    for (int level = requested; level > 0; --level)
+      if (m_pImageInput->seek_subimage(0, level, m_MipSpec)) return level;
+    m_pImageInput->seek_subimage(0, 0, m_MipSpec);
+    return 0;
+  }
 
  public:
   OpenImageIOReader(const attribute::Attributes& options, const IIODescriptor* pDesc, const char* filename)
@@ -189,22 +254,122 @@ class OpenImageIOReader : public IImageReader {
   }
 
   virtual bool doSetup(FrameDescription& description, attribute::Attributes& attributes) override {
-    description.width = m_Spec.width;
-    description.height = m_Spec.height;
-    description.glFormat = getGlType(m_Spec.format, m_Spec.channelnames);
-    description.dataSize = m_Spec.width * m_Spec.height * m_Spec.nchannels * getTypeSize(m_Spec.format);
+    // proxies are only available for mip mapped files (e.g. tiled exr)
+    const int requested = std::min(attribute::getWithDefault<attribute::ProxyLevel>(attributes), MAX_PROXY_LEVEL);
+    m_MipLevel = seekMipLevel(requested);
+    if (m_MipLevel == 0) m_MipSpec = m_Spec;
+    description.width = m_MipSpec.width;
+    description.height = m_MipSpec.height;
+    description.glFormat = getGlType(m_MipSpec.format, m_MipSpec.channelnames);
+    // scanline files can skip rows, tiled files whole tiles
+    const Region region = getRegionOfInterest(attributes);
+    m_Partial = !region.isFull();
+    m_Left = 0;
+    m_Right = m_MipSpec.width;
+    m_Top = region.top(m_MipSpec.height);
+    m_Bottom = region.bottom(m_MipSpec.height);
+    if (m_Partial && m_MipSpec.tile_width > 0) {
+      m_Left = alignDown(region.left(m_MipSpec.width), m_MipSpec.tile_width);
+      m_Right = std::min(alignUp(region.right(m_MipSpec.width), m_MipSpec.tile_width), m_MipSpec.width);
+      m_Top = alignDown(m_Top, m_MipSpec.tile_height);
+      m_Bottom = std::min(alignUp(m_Bottom, m_MipSpec.tile_height), m_MipSpec.height);
+    }
+    if (m_Partial) {
+      description.dataX = m_Left;
+      description.dataY = m_Top;
+      description.dataWidth = m_Right - m_Left;
+      description.dataHeight = m_Bottom - m_Top;
+    }
+    const size_t pixelSize = m_MipSpec.nchannels * getTypeSize(m_MipSpec.format);
+    description.dataSize = (m_Right - m_Left) * (m_Bottom - m_Top) * pixelSize;
+    attribute::set<attribute::ProxyLevel>(attributes, uint8_t(m_MipLevel));
     return true;
   }
 
   virtual void readImageDataTo(void* pData) {
     if (!m_pImageInput) return;
-    if (!m_pImageInput->read_image(m_Spec.format, pData)) {
+    const auto& spec = m_MipSpec;
+    bool success;
+    if (!m_Partial)
+      success = m_pImageInput->read_image(spec.format, pData);
+    else if (spec.tile_width > 0)
+      success = m_pImageInput->read_tiles(spec.x + m_Left, spec.x + m_Right, spec.y + m_Top, spec.y + m_Bottom, spec.z,
+                                          spec.z + 1, spec.format, pData);
+    else
+      success = m_pImageInput->read_scanlines(spec.y + m_Top, spec.y + m_Bottom, spec.z, spec.format, pData);
+    if (!success) {
       m_Error = OpenImageIO::geterror();
       return;
     }
   }
 };
 
+class OpenImageIOWriter : public IImageWriter {
+  unique_ptr<ImageOutput> m_pImageOutput;
+  const string m_Filename;
+  FrameDescription m_Description;
+  ImageSpec m_Spec;
+  bool m_BottomUp = false;
+
+ public:
+  OpenImageIOWriter(const attribute::Attributes& options, const IIODescriptor* pDesc, const char* filename)
+      : IImageWriter(options, pDesc), m_pImageOutput(ImageOutput::create(filename)), m_Filename(filename) {
+    if (!m_pImageOutput) m_Error = OpenImageIO::geterror();
+  }
+
+  ~OpenImageIOWriter() {
+    if (m_pImageOutput) m_pImageOutput->close();
+  }
+
+  virtual bool doSetup(const FrameDescription& description, const attribute::Attributes& attributes) override {
+    if (hasError()) return false;
+    TypeDesc typedesc;
+    int channels = 0;
+    if (!getTypeDesc(description.glFormat, typedesc, channels)) {
+      m_Error = "Unsupported format";
+      return false;
+    }
+    if (description.isPartial()) {
+      m_Error = "Can't write a partial image";
+      return false;
+    }
+    m_Description = description;
+    m_BottomUp = attribute::getWithDefault<attribute::DpxImageOrientation>(attributes) == 4;
+    m_Spec = ImageSpec(description.width, description.height, channels, typedesc);
+    if (!m_pImageOutput->open(m_Filename, m_Spec)) {
+      m_Error = m_pImageOutput->geterror();
+      return false;
+    }
+    return true;
+  }
+
+  virtual void writeImageData(const void* pData) override {
+    if (hasError() || !pData) return;
+    const size_t channelSize = getTypeSize(m_Spec.format);
+    const size_t pixelSize = m_Spec.nchannels * channelSize;
+    const stride_t lineSize = m_Description.width * pixelSize;
+    const char* pBegin = reinterpret_cast<const char*>(pData);
+    // OIIO has no BGR nor foreign endianness layout, those are converted first
+    vector<char> converted;
+    const bool swapRedAndBlue = m_Description.swapRedAndBlue && m_Spec.nchannels >= 3;
+    if (swapRedAndBlue || (m_Description.swapEndianness && channelSize > 1)) {
+      converted.assign(pBegin, pBegin + lineSize * m_Description.height);
+      for (size_t offset = 0; offset < converted.size(); offset += pixelSize) {
+        char* pPixel = &converted[offset];
+        if (m_Description.swapEndianness)
+          for (size_t c = 0; c < size_t(m_Spec.nchannels); ++c)
+            std::reverse(pPixel + c * channelSize, pPixel + (c + 1) * channelSize);
+        if (swapRedAndBlue) std::swap_ranges(pPixel, pPixel + channelSize, pPixel + 2 * channelSize);
+      }
+      pBegin = converted.data();
+    }
+    // bottom to top rows are written with a negative stride from the last one
+    const char* pFirstLine = m_BottomUp ? pBegin + lineSize * (m_Description.height - 1) : pBegin;
+    const bool success = m_pImageOutput->write_image(m_Spec.format, pFirstLine, AutoStride, m_BottomUp ? -lineSize : lineSize);
+    if (!success || !m_pImageOutput->close()) m_Error = m_pImageOutput->geterror();
+  }
+};
+
 class OpenImageIODescriptor : public IIODescriptor {
   vector<string> m_Extensions;
 
@@ -226,13 +391,17 @@ class OpenImageIODescriptor : public IIODescriptor {
     m_Extensions.push_back(current);
   }
   virtual bool supports(Capability capability) const override {
-    return capability == Capability::READER_GENERAL_PURPOSE || capability == Capability::READER_FILE_SEQUENCE;
+    return capability == Capability::READER_GENERAL_PURPOSE || capability == Capability::READER_FILE_SEQUENCE ||
+           capability == Capability::WRITER_TO_FILE;
   }
   virtual const vector<string>& getSupportedExtensions() const override { return m_Extensions; }
   virtual const char* getName() const override { return "OpenImageIO"; }
   virtual IImageReader* getReaderFromFile(const attribute::Attributes& options, const char* filename) const override {
     return new OpenImageIOReader(options, this, filename);
   }
+  virtual IImageWriter* getWriterToFile(const attribute::Attributes& options, const char* filename) const override {
+    return new OpenImageIOWriter(options, this, filename);
+  }
 };
 
 namespace {
@@ -7,26 +7,14 @@
 #include <duke/base/ByteSwap.hpp>
 
 #include <cstdio>
+#include <cstring>
+#include <vector>
 
 using namespace attribute;
 
 // Define targa header. This is only used locally.
 #pragma pack(1)
 typedef struct {
-<<<<<<< HEAD
-	GLbyte identsize;              // Size of ID field that follows header (0)
-	GLbyte colorMapType;           // 0 = None, 1 = paletted
-	GLbyte imageType;              // 0 = none, 1 = indexed, 2 = rgb, 3 = grey, +8=rle
-	unsigned short colorMapStart;  // First colour map entry
-	unsigned short colorMapLength; // Number of colors
-    unsigned char  colorMapBits;    // bits per palette entry
-	unsigned short xstart;         // image x origin
-	unsigned short ystart;         // image y origin
-	unsigned short width;          // width in pixels
-	unsigned short height;         // height in pixels
-	GLbyte bits;                   // bits per pixel (8 16, 24, 32)
-	GLbyte descriptor;             // image descriptor
-=======
   GLbyte identsize;               // Size of ID field that follows header (0)
   GLbyte colorMapType;            // 0 = None, 1 = paletted
   GLbyte imageType;               // 0 = none, 1 = indexed, 2 = rgb, 3 = grey, +8=rle
@@ -39,7 +27,6 @@ typedef struct {
   unsigned short height;          // height in pixels
   GLbyte bits;                    // bits per pixel (8 16, 24, 32)
   GLbyte descriptor;              // image descriptor
->>>>>>> 5b112c82b5a673599f5589fa12c0f21e09d8c324
 } TGAHEADER;
 #pragma pack(8)
 
@@ -96,17 +83,96 @@ class TGAImageReader : public IImageReader {
   }
 };
 
+class TGAImageWriter : public IImageWriter {
+  FILE* m_pFile;
+  FrameDescription m_Description;
+  size_t m_Channels = 0;
+  bool m_BottomUp = false;
+
+ public:
+  TGAImageWriter(const Attributes& options, const IIODescriptor* pDesc, const char* filename)
+      : IImageWriter(options, pDesc), m_pFile(fopen(filename, "wb")) {
+    if (!m_pFile) m_Error = "Unable to open";
+  }
+
+  ~TGAImageWriter() {
+    if (m_pFile) fclose(m_pFile);
+  }
+
+  virtual bool doSetup(const FrameDescription& description, const Attributes& attributes) override {
+    if (hasError()) return false;
+    switch (description.glFormat) {
+      case GL_RGB8:
+        m_Channels = 3;
+        break;
+      case GL_RGBA8:
+        m_Channels = 4;
+        break;
+      case GL_R8:
+        m_Channels = 1;
+        break;
+      default:
+        m_Error = "Unsupported format";
+        return false;
+    }
+    if (description.isPartial()) {
+      m_Error = "Can't write a partial image";
+      return false;
+    }
+    m_Description = description;
+    m_BottomUp = getWithDefault<attribute::DpxImageOrientation>(attributes) == 4;
+    TGAHEADER header;
+    memset(&header, 0, sizeof(header));
+    header.imageType = m_Channels == 1 ? 3 : 2;
+    header.width = description.width;
+    header.height = description.height;
+    header.bits = m_Channels * 8;
+    header.descriptor = m_Channels == 4 ? 8 : 0;  // alpha bits, origin at the bottom left
+    if (fwrite(&header, sizeof(TGAHEADER), 1, m_pFile) != 1) {
+      m_Error = "Unable to write header";
+      return false;
+    }
+    return true;
+  }
+
+  // Scanlines are stored bottom to top, pixels as BGR(A).
+  virtual void writeImageData(const void* pData) override {
+    if (hasError() || !pData) return;
+    const size_t lineSize = m_Description.width * m_Channels;
+    const bool swap = m_Channels >= 3 && !m_Description.swapRedAndBlue;
+    std::vector<char> line(lineSize);
+    for (size_t row = 0; row < m_Description.height; ++row) {
+      const size_t y = m_BottomUp ? row : m_Description.height - 1 - row;
+      const char* pLine = reinterpret_cast<const char*>(pData) + y * lineSize;
+      if (swap) {
+        memcpy(line.data(), pLine, lineSize);
+        for (size_t i = 0; i < lineSize; i += m_Channels) std::swap(line[i], line[i + 2]);
+        pLine = line.data();
+      }
+      if (fwrite(pLine, lineSize, 1, m_pFile) != 1) {
+        m_Error = "Unable to write to file";
+        return;
+      }
+    }
+  }
+};
+
 class TGADescriptor : public IIODescriptor {
   virtual ~TGADescriptor() {}
   virtual const std::vector<std::string>& getSupportedExtensions() const override {
     static std::vector<std::string> extensions = {"tga"};
     return extensions;
   }
-  virtual bool supports(Capability capability) const override { return capability == Capability::READER_FILE_SEQUENCE; }
+  virtual bool supports(Capability capability) const override {
+    return capability == Capability::READER_FILE_SEQUENCE || capability == Capability::WRITER_TO_FILE;
+  }
   virtual const char* getName() const override { return "Targa"; }
   virtual IImageReader* getReaderFromFile(const Attributes& options, const char* filename) const override {
     return new TGAImageReader(options, this, filename);
   }
+  virtual IImageWriter* getWriterToFile(const Attributes& options, const char* filename) const override {
+    return new TGAImageWriter(options, this, filename);
+  }
 };
 
 namespace {
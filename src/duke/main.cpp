@@ -1,7 +1,9 @@
 #include <duke/cmdline/CmdLineParameters.hpp>
+#include <duke/engine/BatchRender.hpp>
 #include <duke/engine/DukeApplication.hpp>
 #include <duke/imageio/DukeIO.hpp>
 #include <duke/benchmark/Benchmark.hpp>
+#include <duke/benchmark/PlaybackBenchmark.hpp>
 #include "config.h"  // autogenerated from config.h.in
 
 int main(int argc, char **argv) {
@@ -30,7 +32,13 @@ int main(int argc, char **argv) {
         parameters.printHelpMessage();
         break;
       case ApplicationMode::BENCHMARK:
-        benchmark();
+        benchmark(parameters);
+        break;
+      case ApplicationMode::PLAYBACK_BENCHMARK:
+        playbackBenchmark(parameters);
+        break;
+      case ApplicationMode::RENDER:
+        batchRender(parameters);
         break;
       case ApplicationMode::DUKE:
         DukeApplication duke(parameters);
@@ -0,0 +1,104 @@
+#include "Metrics.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+
+namespace duke {
+
+namespace {
+
+const char* getTypeString(MetricType type) {
+  switch (type) {
+    case MetricType::COUNTER:
+      return "counter";
+    case MetricType::GAUGE:
+      return "gauge";
+    case MetricType::SUMMARY:
+      return "summary";
+    default:
+      return "untyped";
+  }
+}
+
+void writeEscaped(std::ostream& stream, const std::string& value) {
+  for (const char c : value) {
+    switch (c) {
+      case '\\':
+        stream << "\\\\";
+        break;
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      default:
+        stream << c;
+    }
+  }
+}
+
+void writeValue(std::ostream& stream, double value) {
+  if (std::isnan(value)) {
+    stream << "NaN";
+    return;
+  }
+  if (std::isinf(value)) {
+    stream << (value > 0 ? "+Inf" : "-Inf");
+    return;
+  }
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.15g", value);
+  stream << buffer;
+}
+
+}  // namespace
+
+void MetricsSnapshot::add(const std::string& name, const std::string& help, MetricType type, double value,
+                          const MetricLabels& labels) {
+  metrics.push_back(Metric{name, help, type, labels, value});
+}
+
+void MetricsSnapshot::addSummary(const std::string& name, const std::string& help, const MetricLabels& labels,
+                                 const std::vector<std::pair<double, double> >& quantiles, double sum,
+                                 double count) {
+  for (const auto& quantile : quantiles) {
+    MetricLabels quantileLabels(labels);
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%g", quantile.first);
+    quantileLabels.emplace_back("quantile", buffer);
+    add(name, help, MetricType::SUMMARY, quantile.second, quantileLabels);
+  }
+  add(name + "_sum", "", MetricType::SUMMARY, sum, labels);
+  add(name + "_count", "", MetricType::SUMMARY, count, labels);
+}
+
+void writePrometheus(std::ostream& stream, const MetricsSnapshot& snapshot) {
+  const std::string* pLastName = nullptr;
+  for (const Metric& metric : snapshot.metrics) {
+    if (!metric.help.empty() && (!pLastName || *pLastName != metric.name)) {
+      stream << "# HELP " << metric.name << ' ' << metric.help << '\n';
+      stream << "# TYPE " << metric.name << ' ' << getTypeString(metric.type) << '\n';
+      pLastName = &metric.name;
+    }
+    stream << metric.name;
+    if (!metric.labels.empty()) {
+      stream << '{';
+      bool first = true;
+      for (const auto& label : metric.labels) {
+        if (!first) stream << ',';
+        first = false;
+        stream << label.first << "=\"";
+        writeEscaped(stream, label.second);
+        stream << '"';
+      }
+      stream << '}';
+    }
+    stream << ' ';
+    writeValue(stream, metric.value);
+    stream << '\n';
+  }
+}
+
+} /* namespace duke */
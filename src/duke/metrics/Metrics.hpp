@@ -0,0 +1,39 @@
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace duke {
+
+enum class MetricType { COUNTER, GAUGE, SUMMARY, UNTYPED };
+
+typedef std::vector<std::pair<std::string, std::string> > MetricLabels;
+
+struct Metric {
+  std::string name;
+  std::string help;  // empty for the _sum and _count samples of a summary
+  MetricType type;
+  MetricLabels labels;
+  double value;
+};
+
+/**
+ * Values gathered by the render loop and exported in Prometheus text format.
+ * Samples sharing a name must be added consecutively.
+ */
+struct MetricsSnapshot {
+  void add(const std::string& name, const std::string& help, MetricType type, double value,
+           const MetricLabels& labels = MetricLabels());
+  // Adds quantile samples followed by name_sum and name_count.
+  void addSummary(const std::string& name, const std::string& help, const MetricLabels& labels,
+                  const std::vector<std::pair<double, double> >& quantiles, double sum, double count);
+
+  std::vector<Metric> metrics;
+};
+
+// https://prometheus.io/docs/instrumenting/exposition_formats/
+void writePrometheus(std::ostream& stream, const MetricsSnapshot& snapshot);
+
+} /* namespace duke */
@@ -0,0 +1,101 @@
+#include "MetricsServer.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <stdexcept>
+
+#ifndef MSG_NOSIGNAL  // macOS
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace duke {
+
+namespace {
+
+const int kPollMilliseconds = 100;  // delay to notice the server is stopping
+
+void sendAll(int client, const std::string& data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    const ssize_t count = send(client, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (count <= 0) return;
+    sent += count;
+  }
+}
+
+}  // namespace
+
+MetricsServer::MetricsServer(uint16_t port) : m_Socket(socket(AF_INET, SOCK_STREAM, 0)), m_Port(port), m_Stop(false) {
+  if (m_Socket < 0) throw std::runtime_error("unable to create the metrics socket");
+  const int reuse = 1;
+  setsockopt(m_Socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);  // metrics are not exposed to the network
+  address.sin_port = htons(port);
+  socklen_t length = sizeof(address);
+  if (bind(m_Socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(m_Socket, 4) != 0 ||
+      getsockname(m_Socket, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+    close(m_Socket);
+    throw std::runtime_error("unable to listen for metrics on port " + std::to_string(port));
+  }
+  m_Port = ntohs(address.sin_port);
+  m_Thread = std::thread(&MetricsServer::run, this);
+}
+
+MetricsServer::~MetricsServer() {
+  m_Stop = true;
+  m_Thread.join();
+  close(m_Socket);
+}
+
+bool MetricsServer::publish(std::string&& text) {
+  std::unique_lock<std::mutex> lock(m_Mutex, std::try_to_lock);
+  if (!lock) return false;
+  m_Text.swap(text);
+  return true;
+}
+
+void MetricsServer::run() {
+  pollfd listening = {m_Socket, POLLIN, 0};
+  while (!m_Stop) {
+    listening.revents = 0;
+    if (poll(&listening, 1, kPollMilliseconds) <= 0) continue;
+    const int client = accept(m_Socket, nullptr, nullptr);
+    if (client < 0) continue;
+    serve(client);
+    close(client);
+  }
+}
+
+void MetricsServer::serve(int client) {
+  // a slow client must not keep the server busy
+  timeval timeout = {1, 0};
+  setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+  char request[1024];
+  const ssize_t received = recv(client, request, sizeof(request) - 1, 0);
+  if (received <= 0) return;
+  request[received] = '\0';
+  const bool found = strncmp(request, "GET /metrics ", 13) == 0 || strncmp(request, "GET / ", 6) == 0;
+  if (!found) {
+    sendAll(client, "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\n\r\n");
+    return;
+  }
+  std::string body;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    body = m_Text;
+  }
+  sendAll(client, "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+                      std::to_string(body.size()) + "\r\n\r\n" + body);
+}
+
+} /* namespace duke */
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <duke/base/NonCopyable.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace duke {
+
+/**
+ * Serves the last published metrics over HTTP on localhost, from its own
+ * thread. Publishing never waits for a client being served.
+ */
+class MetricsServer : public noncopyable {
+ public:
+  // Port 0 lets the system choose, see getPort().
+  MetricsServer(uint16_t port);
+  ~MetricsServer();
+
+  uint16_t getPort() const { return m_Port; }
+
+  // Returns false and drops the update if the text is being sent.
+  bool publish(std::string&& text);
+
+ private:
+  void run();
+  void serve(int client);
+
+  int m_Socket;
+  uint16_t m_Port;
+  std::atomic<bool> m_Stop;
+  std::mutex m_Mutex;
+  std::string m_Text;
+  std::thread m_Thread;
+};
+
+} /* namespace duke */
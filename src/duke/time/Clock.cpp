@@ -3,27 +3,32 @@
 #include <numeric>
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 
-Metronom::Metronom(size_t values) : m_Size(values), m_Min(0), m_Max(0), m_Mean(0), m_StdDev(0) {}
+Metronom::Metronom(size_t values)
+    : m_Durations(std::max<size_t>(values, 1)), m_Next(0), m_Count(0), m_Min(0), m_Max(0), m_Mean(0), m_StdDev(0) {}
 
 std::chrono::microseconds Metronom::tick() {
-  if (m_Durations.size() >= m_Size) m_Durations.pop_front();
   const auto elapsedMicroSeconds = m_StopWatch.elapsedMicroSeconds();
-  const double elapsedMilliSeconds = elapsedMicroSeconds.count() / 1000.;
-  m_Durations.push_back(elapsedMilliSeconds);
+  m_Durations[m_Next] = elapsedMicroSeconds.count() / 1000.;
+  m_Next = (m_Next + 1) % m_Durations.size();
+  m_Count = std::min(m_Count + 1, m_Durations.size());
   return elapsedMicroSeconds;
 }
 
 void Metronom::compute() {
-  if (m_Durations.empty()) return;
-  const auto min_max = std::minmax_element(m_Durations.begin(), m_Durations.end());
+  if (m_Count == 0) return;
+  // until the ring is full the samples are at its beginning
+  const auto begin = m_Durations.begin();
+  const auto end = begin + m_Count;
+  const auto min_max = std::minmax_element(begin, end);
   m_Min = *min_max.first;
   m_Max = *min_max.second;
-  const auto sum = std::accumulate(m_Durations.begin(), m_Durations.end(), 0.);
-  m_Mean = sum / m_Durations.size();
+  const auto sum = std::accumulate(begin, end, 0.);
+  m_Mean = sum / m_Count;
   double stddev = 0;
-  for (const auto duration : m_Durations) stddev += (duration - m_Mean) * (duration - m_Mean);
-  m_StdDev = sqrt(stddev / m_Durations.size());
+  for (auto itr = begin; itr != end; ++itr) stddev += (*itr - m_Mean) * (*itr - m_Mean);
+  m_StdDev = sqrt(stddev / m_Count);
 }
 
 void Metronom::dump() {
@@ -1,8 +1,8 @@
 #pragma once
 
 #include <chrono>
-#include <deque>
 #include <cstdint>
+#include <vector>
 
 typedef std::chrono::steady_clock duke_clock;
 
@@ -23,11 +23,14 @@ struct StopWatch {
 };
 
 /**
- * Gathers statistic about tick events
+ * Gathers statistic about the last tick events, the durations are kept in a
+ * ring allocated once.
  */
 struct Metronom {
   Metronom(std::size_t bufferSize);
   std::chrono::microseconds tick();
+  // The next tick measures from now, eg. after an idle period.
+  void restart() { m_StopWatch.elapsedMicroSeconds(); }
 
   void compute();
 
@@ -39,8 +42,9 @@ struct Metronom {
   void dump();
 
  private:
-  const std::size_t m_Size;
-  std::deque<double> m_Durations;
+  std::vector<double> m_Durations;
+  std::size_t m_Next;
+  std::size_t m_Count;
   StopWatch m_StopWatch;
   double m_Min, m_Max, m_Mean, m_StdDev;
 };
@@ -0,0 +1,57 @@
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace duke {
+
+const size_t LatencyHistogram::kSubBucketBits;
+const size_t LatencyHistogram::kSubBuckets;
+const size_t LatencyHistogram::kBuckets;
+
+size_t LatencyHistogram::getBucketIndex(uint64_t microseconds) {
+  if (microseconds < kSubBuckets) return microseconds;
+  const uint64_t value = std::min<uint64_t>(microseconds, std::numeric_limits<uint32_t>::max());
+  size_t msb = 0;
+  while (value >> (msb + 1)) ++msb;
+  const size_t shift = msb - kSubBucketBits;
+  // value >> shift is in [kSubBuckets, 2 * kSubBuckets)
+  return kSubBuckets * shift + (value >> shift);
+}
+
+uint64_t LatencyHistogram::getBucketValue(size_t index) {
+  if (index < 2 * kSubBuckets) return index;
+  const size_t shift = index / kSubBuckets - 1;
+  return uint64_t(index % kSubBuckets + kSubBuckets) << shift;
+}
+
+void LatencyHistogram::record(uint64_t microseconds) {
+  ++m_Buckets[getBucketIndex(microseconds)];
+  ++m_Count;
+  m_Sum += microseconds;
+  m_Min = std::min(m_Min, microseconds);
+  m_Max = std::max(m_Max, microseconds);
+}
+
+void LatencyHistogram::reset() {
+  m_Buckets.fill(0);
+  m_Count = 0;
+  m_Sum = 0;
+  m_Min = std::numeric_limits<uint64_t>::max();
+  m_Max = 0;
+}
+
+uint64_t LatencyHistogram::percentile(double percent) const {
+  if (m_Count == 0) return 0;
+  const uint64_t rank = std::max<uint64_t>(1, std::ceil(percent / 100 * m_Count));
+  if (rank >= m_Count) return m_Max;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBuckets; ++i) {
+    seen += m_Buckets[i];
+    if (seen >= rank) return std::min(std::max(getBucketValue(i), min()), m_Max);
+  }
+  return m_Max;
+}
+
+}  // namespace duke
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace duke {
+
+/**
+ * Streaming distribution of durations in microseconds.
+ * Values are stored in log-linear buckets, 32 per power of two, so any
+ * percentile is known within 3% whatever the number of samples. Recording
+ * is constant time and the histogram never allocates.
+ */
+class LatencyHistogram {
+ public:
+  static const size_t kSubBucketBits = 5;
+  static const size_t kSubBuckets = 1 << kSubBucketBits;
+  static const size_t kBuckets = kSubBuckets * (32 - kSubBucketBits + 1);  // up to 2^32 us
+
+  LatencyHistogram() { reset(); }
+
+  void record(uint64_t microseconds);
+  void reset();
+
+  uint64_t count() const { return m_Count; }
+  uint64_t min() const { return m_Count ? m_Min : 0; }
+  uint64_t max() const { return m_Max; }
+  double mean() const { return m_Count ? double(m_Sum) / m_Count : 0; }
+  // Value below which 'percent' of the samples fall, 0 when empty.
+  uint64_t percentile(double percent) const;
+
+  static size_t getBucketIndex(uint64_t microseconds);
+  // Smallest value falling in the bucket.
+  static uint64_t getBucketValue(size_t index);
+
+ private:
+  std::array<uint32_t, kBuckets> m_Buckets;
+  uint64_t m_Count;
+  uint64_t m_Sum;
+  uint64_t m_Min;
+  uint64_t m_Max;
+};
+
+/**
+ * The last N samples, oldest first, for drawing sparklines.
+ */
+template <size_t N>
+class SampleRing {
+ public:
+  void push(float value) {
+    m_Samples[m_Next] = value;
+    m_Next = (m_Next + 1) % N;
+    if (m_Size < N) ++m_Size;
+  }
+  size_t size() const { return m_Size; }
+  static size_t capacity() { return N; }
+  // index 0 is the oldest sample
+  float operator[](size_t index) const { return m_Samples[(m_Next + N - m_Size + index) % N]; }
+  float max() const {
+    float result = 0;
+    for (size_t i = 0; i < m_Size; ++i) result = m_Samples[i] > result ? m_Samples[i] : result;
+    return result;
+  }
+
+ private:
+  std::array<float, N> m_Samples;
+  size_t m_Next = 0;
+  size_t m_Size = 0;
+};
+
+} /* namespace duke */
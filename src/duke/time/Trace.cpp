@@ -0,0 +1,162 @@
+#include "Trace.hpp"
+
+#include <duke/time/Clock.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+namespace duke {
+namespace trace {
+
+std::atomic<bool> gEnabled(false);
+
+namespace {
+
+// Single producer ring, only the owning thread writes events and counts them.
+struct Ring {
+  Ring() : events(kEventsPerThread), written(0), sessionStart(0) {}
+  uint32_t thread = 0;  // of the current owner
+  std::vector<Event> events;
+  std::atomic<uint64_t> written;
+  // written when the tracer was last enabled, earlier events are discarded
+  std::atomic<uint64_t> sessionStart;
+};
+
+// Rings outlive their threads so events of finished workers can still be
+// dumped, a released ring is handed to the next thread recording events.
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<Ring>> rings;
+  std::vector<Ring*> released;
+  uint32_t threads = 0;
+
+  Ring* acquire() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (released.empty()) {
+      rings.emplace_back(new Ring());
+      released.push_back(rings.back().get());
+    }
+    Ring* const pRing = released.back();
+    released.pop_back();
+    pRing->thread = threads++;
+    return pRing;
+  }
+
+  void release(Ring* pRing) {
+    std::lock_guard<std::mutex> lock(mutex);
+    released.push_back(pRing);
+  }
+};
+
+// Never destroyed, pool threads joined at exit still release their ring.
+Registry& getRegistry() {
+  static Registry* const pRegistry = new Registry();
+  return *pRegistry;
+}
+
+// Gives the ring back when its thread exits.
+struct RingOwner {
+  RingOwner() : pRing(getRegistry().acquire()) {}
+  ~RingOwner() { getRegistry().release(pRing); }
+  Ring* const pRing;
+};
+
+Ring& getThreadRing() {
+  thread_local RingOwner owner;
+  return *owner.pRing;
+}
+
+struct Context {
+  int64_t frame = -1;
+  const void* pStream = nullptr;
+};
+
+thread_local Context gContext;
+
+const duke_clock::time_point gEpoch = duke_clock::now();
+
+}  // namespace
+
+void setEnabled(bool enabled) {
+  if (enabled) {
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    // the owners may be recording, their counters are left alone
+    for (auto& pRing : registry.rings)
+      pRing->sessionStart.store(pRing->written.load(std::memory_order_acquire), std::memory_order_relaxed);
+  }
+  gEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+uint64_t now() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duke_clock::now() - gEpoch).count();
+}
+
+void record(const char* pName, uint64_t begin, uint64_t end) {
+  Ring& ring = getThreadRing();
+  const uint64_t index = ring.written.load(std::memory_order_relaxed);
+  ring.events[index % kEventsPerThread] = {pName, begin, end - begin, gContext.frame, gContext.pStream, ring.thread};
+  ring.written.store(index + 1, std::memory_order_release);
+}
+
+std::vector<Event> collect() {
+  std::vector<Event> events;
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (const auto& pRing : registry.rings) {
+    const uint64_t written = pRing->written.load(std::memory_order_acquire);
+    const uint64_t sessionStart = pRing->sessionStart.load(std::memory_order_relaxed);
+    const uint64_t first = std::max(sessionStart, written > kEventsPerThread ? written - kEventsPerThread : 0);
+    for (uint64_t i = first; i < written; ++i) events.push_back(pRing->events[i % kEventsPerThread]);
+  }
+  // scopes starting on the same microsecond are nested, the enclosing one is longer
+  std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+    return a.begin < b.begin || (a.begin == b.begin && a.duration > b.duration);
+  });
+  return events;
+}
+
+void writeChromeTrace(std::ostream& stream, const std::vector<Event>& events) {
+  stream << "{\"traceEvents\":[";
+  bool first = true;
+  for (const Event& event : events) {
+    if (!first) stream << ',';
+    first = false;
+    stream << "\n{\"name\":\"" << event.pName << "\",\"cat\":\"duke\",\"ph\":\"X\",\"pid\":1"
+           << ",\"tid\":" << event.thread << ",\"ts\":" << event.begin << ",\"dur\":" << event.duration;
+    if (event.frame >= 0)
+      stream << ",\"args\":{\"frame\":" << event.frame << ",\"stream\":\"" << event.pStream << "\"}";
+    stream << '}';
+  }
+  stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+size_t getRingCount() {
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.rings.size();
+}
+
+bool dumpChromeTrace(const std::string& filename) {
+  std::ofstream file(filename);
+  if (!file) return false;
+  writeChromeTrace(file, collect());
+  return bool(file);
+}
+
+FrameContext::FrameContext(int64_t frame, const void* pStream)
+    : m_PreviousFrame(gContext.frame), m_pPreviousStream(gContext.pStream) {
+  gContext.frame = frame;
+  gContext.pStream = pStream;
+}
+
+FrameContext::~FrameContext() {
+  gContext.frame = m_PreviousFrame;
+  gContext.pStream = m_pPreviousStream;
+}
+
+}  // namespace trace
+}  // namespace duke
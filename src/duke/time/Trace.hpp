@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace duke {
+namespace trace {
+
+/**
+ * A timed section of code, recorded by the thread which executed it.
+ * - pName must be a string literal, it is never copied.
+ * - frame and pStream come from the enclosing FrameContext, if any.
+ */
+struct Event {
+  const char* pName;
+  uint64_t begin;     // microseconds since the first use of the tracer
+  uint64_t duration;  // microseconds
+  int64_t frame;      // -1 outside of a FrameContext
+  const void* pStream;
+  uint32_t thread;
+};
+
+// Number of events kept per thread, older events are overwritten.
+const size_t kEventsPerThread = 16384;
+
+extern std::atomic<bool> gEnabled;
+
+inline bool isEnabled() { return gEnabled.load(std::memory_order_relaxed); }
+
+// Enabling discards previously recorded events.
+void setEnabled(bool enabled);
+
+uint64_t now();
+void record(const char* pName, uint64_t begin, uint64_t end);
+
+// Events of all threads ordered by start time, enclosing scopes first. Collecting while threads are
+// recording may return events being overwritten, disable the tracer first.
+std::vector<Event> collect();
+
+// Rings allocated so far, rings of exited threads are reused so this is the
+// peak number of threads recording at the same time.
+size_t getRingCount();
+
+// Chrome trace event format, loads in chrome://tracing and ui.perfetto.dev.
+void writeChromeTrace(std::ostream& stream, const std::vector<Event>& events);
+bool dumpChromeTrace(const std::string& filename);
+
+// Tags the events of the current thread with a frame and a stream.
+class FrameContext {
+ public:
+  FrameContext(int64_t frame, const void* pStream);
+  ~FrameContext();
+
+ private:
+  const int64_t m_PreviousFrame;
+  const void* const m_pPreviousStream;
+};
+
+// Records the lifetime of the object, only costs a relaxed load when disabled.
+class Scope {
+ public:
+  explicit Scope(const char* pName) : m_pName(isEnabled() ? pName : nullptr), m_Begin(m_pName ? now() : 0) {}
+  ~Scope() {
+    if (m_pName) record(m_pName, m_Begin, now());
+  }
+
+ private:
+  const char* const m_pName;
+  const uint64_t m_Begin;
+};
+
+}  // namespace trace
+}  // namespace duke
+
+#define DUKE_TRACE_CONCAT_IMPL(a, b) a##b
+#define DUKE_TRACE_CONCAT(a, b) DUKE_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef DUKE_NO_TRACE
+#define DUKE_TRACE_SCOPE(NAME)
+#define DUKE_TRACE_FRAME(FRAME, STREAM)
+#else
+#define DUKE_TRACE_SCOPE(NAME) ::duke::trace::Scope DUKE_TRACE_CONCAT(dukeTraceScope, __LINE__)(NAME)
+#define DUKE_TRACE_FRAME(FRAME, STREAM) \
+  ::duke::trace::FrameContext DUKE_TRACE_CONCAT(dukeTraceFrame, __LINE__)(FRAME, STREAM)
+#endif
@@ -0,0 +1,18 @@
+#include <gtest/gtest.h>
+
+#include <duke/engine/BatchRender.hpp>
+
+using namespace duke;
+
+TEST(BatchRender, frameFilename) {
+  EXPECT_EQ(getFrameFilename("out/frame.####.tga", 12), "out/frame.0012.tga");
+  EXPECT_EQ(getFrameFilename("out/frame_#.tga", 12), "out/frame_12.tga");
+  EXPECT_EQ(getFrameFilename("out/frame.##.tga", 12345), "out/frame.12345.tga");
+  // only the last run is replaced
+  EXPECT_EQ(getFrameFilename("out#/frame.###.tga", 7), "out#/frame.007.tga");
+}
+
+TEST(BatchRender, frameFilenameWithoutPadding) {
+  EXPECT_EQ(getFrameFilename("out/frame.tga", 12), "out/frame.0012.tga");
+  EXPECT_EQ(getFrameFilename("out.d/frame", 12), "out.d/frame.0012");
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <duke/benchmark/BenchmarkReport.hpp>
+
+#include <sstream>
+#include <stdexcept>
+
+using namespace duke;
+
+TEST(BenchmarkReport, percentile) {
+  const std::vector<double> sorted = {1, 2, 3, 4, 5};
+  EXPECT_DOUBLE_EQ(1, percentile(sorted, 0));
+  EXPECT_DOUBLE_EQ(3, percentile(sorted, 50));
+  EXPECT_DOUBLE_EQ(5, percentile(sorted, 100));
+  EXPECT_DOUBLE_EQ(4.5, percentile(sorted, 87.5));
+  EXPECT_DOUBLE_EQ(0, percentile({}, 50));
+}
+
+TEST(BenchmarkReport, statistics) {
+  const auto statistics = computeStatistics({5, 1, 4, 2, 3});
+  EXPECT_EQ(5UL, statistics.count);
+  EXPECT_DOUBLE_EQ(1, statistics.min);
+  EXPECT_DOUBLE_EQ(5, statistics.max);
+  EXPECT_DOUBLE_EQ(3, statistics.mean);
+  EXPECT_DOUBLE_EQ(3, statistics.p50);
+  EXPECT_EQ(0UL, computeStatistics({}).count);
+}
+
+TEST(BenchmarkReport, format) {
+  EXPECT_EQ(ReportFormat::TEXT, getReportFormat("text"));
+  EXPECT_EQ(ReportFormat::JSON, getReportFormat("json"));
+  EXPECT_EQ(ReportFormat::CSV, getReportFormat("csv"));
+  EXPECT_THROW(getReportFormat("xml"), std::logic_error);
+}
+
+namespace {
+
+std::vector<BenchmarkRecord> getRecords() {
+  BenchmarkRecord first;
+  first.add("scenario", "pbo");
+  first.add("ms", 1.5);
+  BenchmarkRecord second;
+  second.add("scenario", "a \"quoted\", name");
+  second.add("ms", 2);
+  return {first, second};
+}
+
+std::string write(ReportFormat format, const std::vector<BenchmarkRecord>& records) {
+  std::ostringstream oss;
+  writeReport(oss, format, records);
+  return oss.str();
+}
+
+}  // namespace
+
+TEST(BenchmarkReport, json) {
+  EXPECT_EQ(
+      "[\n"
+      "  {\"scenario\": \"pbo\", \"ms\": 1.5},\n"
+      "  {\"scenario\": \"a \\\"quoted\\\", name\", \"ms\": 2}\n"
+      "]\n",
+      write(ReportFormat::JSON, getRecords()));
+  EXPECT_EQ("[\n]\n", write(ReportFormat::JSON, {}));
+}
+
+TEST(BenchmarkReport, csv) {
+  EXPECT_EQ(
+      "scenario,ms\n"
+      "pbo,1.5\n"
+      "\"a \"\"quoted\"\", name\",2\n",
+      write(ReportFormat::CSV, getRecords()));
+  EXPECT_EQ("", write(ReportFormat::CSV, {}));
+}
+
+TEST(BenchmarkReport, statisticsFields) {
+  BenchmarkRecord record;
+  record.add("upload", computeStatistics({1, 2}));
+  ASSERT_EQ(6UL, record.fields.size());
+  EXPECT_EQ("upload_min", record.fields[0].key);
+  EXPECT_EQ("1", record.fields[0].value);
+  EXPECT_TRUE(record.fields[0].numeric);
+  EXPECT_EQ("upload_max", record.fields[5].key);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <duke/engine/cache/CacheResidency.hpp>
+
+using namespace std;
+using namespace duke;
+
+namespace {
+
+Ranges getRanges(const FrameIntervalSet& set) {
+  Ranges ranges;
+  set.getRanges(ranges);
+  return ranges;
+}
+
+const IMediaStream* const pStreamA = reinterpret_cast<const IMediaStream*>(0x10);
+const IMediaStream* const pStreamB = reinterpret_cast<const IMediaStream*>(0x20);
+
+}  // namespace
+
+TEST(FrameIntervalSet, mergesNeighbours) {
+  FrameIntervalSet set;
+  set.add(1);
+  set.add(3);
+  EXPECT_EQ(Ranges({Range(1, 1), Range(3, 3)}), getRanges(set));
+  set.add(2);
+  EXPECT_EQ(Ranges({Range(1, 3)}), getRanges(set));
+  set.add(0);
+  set.add(4);
+  EXPECT_EQ(Ranges({Range(0, 4)}), getRanges(set));
+}
+
+TEST(FrameIntervalSet, splitsOnRemove) {
+  FrameIntervalSet set;
+  for (size_t i = 0; i < 5; ++i) set.add(i);
+  set.remove(2);
+  EXPECT_EQ(Ranges({Range(0, 1), Range(3, 4)}), getRanges(set));
+  set.remove(0);
+  set.remove(4);
+  EXPECT_EQ(Ranges({Range(1, 1), Range(3, 3)}), getRanges(set));
+  set.remove(1);
+  set.remove(3);
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(FrameIntervalSet, countsDuplicates) {
+  FrameIntervalSet set;
+  set.add(5);
+  set.add(5);
+  set.remove(5);
+  EXPECT_TRUE(set.contains(5));
+  EXPECT_EQ(1UL, set.rangeCount());
+  set.remove(5);
+  EXPECT_FALSE(set.contains(5));
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(CacheResidency, tokensTrackFrames) {
+  const auto pResidency = CacheResidency::create();
+  CacheResidency::State state;
+  EXPECT_EQ(0UL, pResidency->snapshot(state));
+  EXPECT_TRUE(state.empty());
+
+  auto token0 = pResidency->acquire(MediaFrameReference(pStreamA, 0), 10);
+  auto token1 = pResidency->acquire(MediaFrameReference(pStreamA, 1), 10);
+  auto token2 = pResidency->acquire(MediaFrameReference(pStreamB, 7), 5);
+  EXPECT_EQ(25UL, pResidency->snapshot(state));
+  EXPECT_EQ(2UL, state.size());
+  EXPECT_EQ(Ranges({Range(0, 1)}), state[pStreamA]);
+  EXPECT_EQ(Ranges({Range(7, 7)}), state[pStreamB]);
+
+  // copies keep the frame resident
+  auto copy = token0;
+  token0.reset();
+  token2.reset();
+  EXPECT_EQ(20UL, pResidency->snapshot(state));
+  EXPECT_EQ(1UL, state.size());
+  EXPECT_EQ(Ranges({Range(0, 1)}), state[pStreamA]);
+
+  copy.reset();
+  EXPECT_EQ(10UL, pResidency->snapshot(state));
+  EXPECT_EQ(Ranges({Range(1, 1)}), state[pStreamA]);
+}
+
+TEST(CacheResidency, tokenOutlivesResidency) {
+  auto pResidency = CacheResidency::create();
+  auto token = pResidency->acquire(MediaFrameReference(pStreamA, 0), 1);
+  pResidency.reset();
+  token.reset();
+}
@@ -20,6 +20,73 @@ TEST(CmdLine, fullscreen) {
   EXPECT_TRUE(build({"-f"}).fullscreen);
 }
 
+TEST(CmdLine, proxy) {
+  EXPECT_FALSE(build({}).proxyDecode);
+  EXPECT_TRUE(build({"--proxy"}).proxyDecode);
+}
+
+TEST(CmdLine, roi) {
+  EXPECT_FALSE(build({}).regionDecode);
+  EXPECT_TRUE(build({"--roi"}).regionDecode);
+}
+
+TEST(CmdLine, mipmap) {
+  EXPECT_FALSE(build({}).mipmapDisplay);
+  EXPECT_TRUE(build({"--mipmap"}).mipmapDisplay);
+}
+
+TEST(CmdLine, tileSize) {
+  EXPECT_EQ(0, build({}).textureTileSize);
+  EXPECT_EQ(1024, build({"--tile-size", "1024"}).textureTileSize);
+}
+
+TEST(CmdLine, probeFormats) {
+  EXPECT_FALSE(build({}).probeTextureFormats);
+  EXPECT_TRUE(build({"--probe-formats"}).probeTextureFormats);
+}
+
+TEST(CmdLine, benchmark) {
+  const auto defaults = build({});
+  EXPECT_TRUE(defaults.benchmarkScenarios.empty());
+  EXPECT_EQ(duke::ReportFormat::TEXT, defaults.benchmarkFormat);
+  EXPECT_FALSE(defaults.headless);
+  const auto parameters = build({"--benchmark", "--benchmark-scenarios", "sync,pbo", "--benchmark-repeat", "5",
+                                 "--benchmark-format", "json", "--headless"});
+  EXPECT_EQ(duke::ApplicationMode::BENCHMARK, parameters.mode);
+  EXPECT_EQ(std::vector<std::string>({"sync", "pbo"}), parameters.benchmarkScenarios);
+  EXPECT_EQ(5, parameters.benchmarkRepetitions);
+  EXPECT_EQ(duke::ReportFormat::JSON, parameters.benchmarkFormat);
+  EXPECT_TRUE(parameters.headless);
+  EXPECT_THROW(build({"--benchmark-format", "xml"}), std::logic_error);
+}
+
+TEST(CmdLine, playbackBenchmark) {
+  const auto defaults = build({});
+  EXPECT_EQ(100, defaults.benchmarkFrames);
+  EXPECT_EQ(2048, defaults.benchmarkWidth);
+  EXPECT_EQ(1556, defaults.benchmarkHeight);
+  const auto parameters =
+      build({"--playback-benchmark", "--benchmark-frames", "24", "--benchmark-resolution", "640x480"});
+  EXPECT_EQ(duke::ApplicationMode::PLAYBACK_BENCHMARK, parameters.mode);
+  EXPECT_EQ(24, parameters.benchmarkFrames);
+  EXPECT_EQ(640, parameters.benchmarkWidth);
+  EXPECT_EQ(480, parameters.benchmarkHeight);
+  EXPECT_THROW(build({"--benchmark-resolution", "640"}), std::logic_error);
+  EXPECT_THROW(build({"--benchmark-resolution", "0x480"}), std::logic_error);
+}
+
+TEST(CmdLine, metricsPort) {
+  EXPECT_EQ(0, build({}).metricsPort);
+  EXPECT_EQ(9464, build({"--metrics-port", "9464"}).metricsPort);
+  EXPECT_THROW(build({"--metrics-port", "70000"}), std::logic_error);
+}
+
+TEST(CmdLine, lutSize) {
+  EXPECT_EQ(33, build({}).lutEdgeSize);
+  EXPECT_EQ(65, build({"--lut-size", "65"}).lutEdgeSize);
+  EXPECT_THROW(build({"--lut-size", "32"}), std::logic_error);
+}
+
 TEST(CmdLine, threads) {
   EXPECT_GE(build({}).workerThreadDefault, 1);
   EXPECT_EQ(build({"--threads", "4"}).workerThreadDefault, 4);
@@ -65,3 +132,16 @@ TEST(CmdLine, framerate) {
   EXPECT_EQ(build({"--framerate", "29.97"}).defaultFrameRate, FrameDuration(100, 2997));
   EXPECT_EQ(build({"--framerate", "30000/1001"}).defaultFrameRate, FrameDuration::NTSC);
 }
+
+TEST(CmdLine, render) {
+  const auto parameters = build({"--render", "out/frame.####.tga", "file"});
+  EXPECT_EQ(parameters.mode, duke::ApplicationMode::RENDER);
+  EXPECT_EQ(parameters.renderOutput, "out/frame.####.tga");
+  EXPECT_EQ(parameters.renderWidth, 1920);
+  EXPECT_EQ(parameters.renderHeight, 1080);
+  const auto resized = build({"--render-resolution", "640x360"});
+  EXPECT_EQ(resized.renderWidth, 640);
+  EXPECT_EQ(resized.renderHeight, 360);
+  EXPECT_THROW(build({"--render-resolution", "640"}), std::logic_error);
+  EXPECT_THROW(build({"--render-resolution", "0x360"}), std::logic_error);
+}
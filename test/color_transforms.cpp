@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include "frame_fixtures.hpp"
+
+#include <duke/engine/ColorTransforms.hpp>
+#include <duke/gl/GL.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+using namespace duke;
+
+namespace {
+
+const duke::ColorSpace kAllColorSpaces[] = {
+    duke::ColorSpace::linear,  duke::ColorSpace::sRGB,        duke::ColorSpace::sRGBf,   duke::ColorSpace::rec709,
+    duke::ColorSpace::Cineon,  duke::ColorSpace::Panalog,     duke::ColorSpace::REDLog,  duke::ColorSpace::ViperLog,
+    duke::ColorSpace::AlexaV3LogC, duke::ColorSpace::PLogLin, duke::ColorSpace::SLog,    duke::ColorSpace::raw,
+    duke::ColorSpace::Gamma18, duke::ColorSpace::Gamma22};
+
+}  // namespace
+
+TEST(ColorTransforms, referenceValues) {
+  EXPECT_NEAR(0.214041f, toLinear(duke::ColorSpace::sRGB, .5f), 1e-5);
+  EXPECT_NEAR(0.259589f, toLinear(duke::ColorSpace::rec709, .5f), 1e-5);
+  EXPECT_NEAR(1.f, toLinear(duke::ColorSpace::Cineon, 685 / 1023.f), 1e-5);
+  EXPECT_NEAR(0.f, toLinear(duke::ColorSpace::Cineon, 95 / 1023.f), 1e-5);
+  EXPECT_NEAR(0.391453f, toLinear(duke::ColorSpace::Panalog, 512 / 1023.f), 1e-5);
+  EXPECT_NEAR(1.f, toLinear(duke::ColorSpace::REDLog, 1.f), 1e-5);
+  EXPECT_NEAR(1.f, toLinear(duke::ColorSpace::ViperLog, 1.f), 1e-5);
+  EXPECT_NEAR(0.18f, toLinear(duke::ColorSpace::PLogLin, 445 / 1023.f), 1e-5);
+  EXPECT_NEAR(0.391007f, fromLinear(duke::ColorSpace::AlexaV3LogC, 0.18f), 1e-5);
+  EXPECT_NEAR(0.359988f, fromLinear(duke::ColorSpace::SLog, 0.18f), 1e-5);
+  EXPECT_NEAR(0.217638f, toLinear(duke::ColorSpace::Gamma22, .5f), 1e-5);
+  EXPECT_EQ(.5f, toLinear(duke::ColorSpace::raw, .5f));
+}
+
+TEST(ColorTransforms, roundTrip) {
+  for (auto colorspace : kAllColorSpaces) {
+    for (float value = 0.05f; value < 1.f; value += 0.05f) {
+      EXPECT_NEAR(value, fromLinear(colorspace, toLinear(colorspace, value)), 1e-4)
+          << getColorspaceString(colorspace) << " " << value;
+    }
+  }
+}
+
+TEST(ColorTransforms, arraysMatchScalars) {
+  std::vector<float> values;
+  for (float value = 0; value <= 1.f; value += 0.01f) values.push_back(value);
+  for (const auto colorspace : kAllColorSpaces) {
+    auto converted = values;
+    toLinear(colorspace, converted.data(), converted.size());
+    for (size_t i = 0; i < values.size(); ++i) EXPECT_EQ(toLinear(colorspace, values[i]), converted[i]);
+  }
+}
+
+TEST(ColorTransforms, decode8Bits) {
+  const uint8_t data[] = {0, 128, 255, 255, 0, 0};
+  RgbaImage image;
+  decodeToLinear(makeFrame(2, 1, GL_RGB8, data, sizeof(data)), duke::ColorSpace::sRGB, image);
+  ASSERT_EQ(2, image.width);
+  ASSERT_EQ(1, image.height);
+  EXPECT_EQ(0.f, image.pixels[0]);
+  EXPECT_FLOAT_EQ(toLinear(duke::ColorSpace::sRGB, 128 / 255.f), image.pixels[1]);
+  EXPECT_EQ(1.f, image.pixels[2]);
+  EXPECT_EQ(1.f, image.pixels[3]);  // opaque
+  EXPECT_EQ(1.f, image.pixels[4]);
+}
+
+TEST(ColorTransforms, decodeGrayscaleAndAlpha) {
+  const uint8_t gray[] = {255};
+  RgbaImage image;
+  decodeToLinear(makeFrame(1, 1, GL_R8, gray, sizeof(gray)), duke::ColorSpace::linear, image);
+  EXPECT_EQ(std::vector<float>({1, 1, 1, 1}), image.pixels);
+
+  // alpha is never transformed
+  const float rgba[] = {0.5f, 0.5f, 0.5f, 0.5f};
+  decodeToLinear(makeFrame(1, 1, GL_RGBA32F, rgba, sizeof(rgba)), duke::ColorSpace::Gamma22, image);
+  EXPECT_FLOAT_EQ(toLinear(duke::ColorSpace::Gamma22, .5f), image.pixels[0]);
+  EXPECT_EQ(0.5f, image.pixels[3]);
+}
+
+TEST(ColorTransforms, decodeSwaps) {
+  const uint16_t big[] = {0xffff, 0x0080, 0x0000};  // 0xffff, 0x8000, 0 once swapped
+  auto frame = makeFrame(1, 1, GL_RGB16, big, sizeof(big));
+  frame.description.swapEndianness = true;
+  frame.description.swapRedAndBlue = true;
+  RgbaImage image;
+  decodeToLinear(frame, duke::ColorSpace::linear, image);
+  EXPECT_EQ(0.f, image.pixels[0]);
+  EXPECT_FLOAT_EQ(0x8000 / 65535.f, image.pixels[1]);
+  EXPECT_EQ(1.f, image.pixels[2]);
+}
+
+TEST(ColorTransforms, decodeDpx10Bits) {
+  const uint32_t word = (1023u << 22) | (512u << 12) | (0u << 2);
+  RgbaImage image;
+  decodeToLinear(makeFrame(1, 1, GL_RGB10_A2UI, &word, sizeof(word)), duke::ColorSpace::Cineon, image);
+  EXPECT_FLOAT_EQ(toLinear(duke::ColorSpace::Cineon, 1.f), image.pixels[0]);
+  EXPECT_FLOAT_EQ(toLinear(duke::ColorSpace::Cineon, 512 / 1023.f), image.pixels[1]);
+  EXPECT_FLOAT_EQ(toLinear(duke::ColorSpace::Cineon, 0.f), image.pixels[2]);
+}
+
+TEST(ColorTransforms, decodeIsThreadCountIndependent) {
+  const size_t width = 7, height = 33;
+  std::vector<uint16_t> data(width * height * 3);
+  for (size_t i = 0; i < data.size(); ++i) data[i] = uint16_t(i * 977);
+  const auto frame = makeFrame(width, height, GL_RGB16, data.data(), data.size() * 2);
+  RgbaImage single, multi;
+  decodeToLinear(frame, duke::ColorSpace::AlexaV3LogC, single, 1);
+  decodeToLinear(frame, duke::ColorSpace::AlexaV3LogC, multi, 4);
+  EXPECT_EQ(single.pixels, multi.pixels);
+}
+
+TEST(ColorTransforms, decodeErrors) {
+  const uint8_t data[] = {0, 0, 0, 0};
+  RgbaImage image;
+  EXPECT_THROW(decodeToLinear(makeFrame(1, 1, GL_RGB32UI, data, sizeof(data)), duke::ColorSpace::linear, image),
+               std::runtime_error);
+  EXPECT_THROW(decodeToLinear(makeFrame(2, 1, GL_RGB8, data, sizeof(data)), duke::ColorSpace::linear, image),
+               std::runtime_error);
+}
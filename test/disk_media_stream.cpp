@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <duke/attributes/AttributeKeys.hpp>
+#include <duke/engine/ImageLoadUtils.hpp>
+#include <duke/engine/streams/DiskMediaStream.hpp>
+#include <duke/filesystem/FsUtils.hpp>
+#include <duke/imageio/DukeIO.hpp>
+#include <sequence/Item.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+
+using namespace duke;
+
+namespace {
+
+std::atomic<int> gOpened(0);
+std::atomic<int> gDecoded(0);
+
+// Parses its header when constructed as the real readers do, counting the
+// files opened and decoded.
+class CountingReader : public IImageReader {
+ public:
+  CountingReader(const attribute::Attributes& options, const IIODescriptor* pDesc, const char* filename)
+      : IImageReader(options, pDesc) {
+    ++gOpened;
+    FILE* pFile = fopen(filename, "rb");
+    if (!pFile) {
+      m_Error = "unable to open file";
+      return;
+    }
+    fclose(pFile);
+    attribute::set<attribute::DpxImageOrientation>(m_ReaderAttributes, 4);
+  }
+
+  virtual bool doSetup(FrameDescription&, attribute::Attributes&) override {
+    ++gDecoded;
+    return false;
+  }
+};
+
+class CountingDescriptor : public IIODescriptor {
+  virtual const std::vector<std::string>& getSupportedExtensions() const override {
+    static std::vector<std::string> extensions = {"counting"};
+    return extensions;
+  }
+  virtual bool supports(Capability capability) const override {
+    return capability == Capability::READER_FILE_SEQUENCE;
+  }
+  virtual const char* getName() const override { return "Counting"; }
+  virtual IImageReader* getReaderFromFile(const attribute::Attributes& options, const char* filename) const override {
+    return new CountingReader(options, this, filename);
+  }
+};
+
+bool registrar = IODescriptors::instance().registerDescriptor(new CountingDescriptor());
+
+sequence::Item makeSequence(const std::string& pattern, int start, int end) {
+  sequence::Item item;
+  item.filename = pattern;
+  item.start = start;
+  item.end = end;
+  item.step = 1;
+  item.padding = 4;
+  return item;
+}
+
+}  // namespace
+
+TEST(DiskMediaStream, constructionDoesNoIO) {
+  const int opened = gOpened;
+  const DiskMediaStream stream({}, makeSequence("/nonexistent/frame.####.counting", 1, 10));
+  EXPECT_EQ(opened, gOpened);
+}
+
+TEST(DiskMediaStream, frameCountNeedsNoRead) {
+  const int opened = gOpened;
+  const DiskMediaStream stream({}, makeSequence("/nonexistent/frame.####.counting", 5, 24));
+  EXPECT_EQ(20, stream.getFrameCount());
+  EXPECT_EQ(opened, gOpened);
+}
+
+TEST(DiskMediaStream, unreadableFirstFrameSetsError) {
+  const DiskMediaStream stream({}, makeSequence("/nonexistent/frame.####.counting", 1, 10));
+  const auto& state = stream.getState();
+  EXPECT_TRUE(attribute::contains<attribute::Error>(state));
+  EXPECT_EQ(10, attribute::getWithDefault<attribute::MediaFrameCount>(state));
+}
+
+TEST(ImageLoadUtils, loadHeaderDoesNotDecode) {
+  const std::string directory = createTemporaryDirectory("duke-header");
+  const std::string filename = directory + "/frame.counting";
+  FILE* pFile = fopen(filename.c_str(), "wb");
+  ASSERT_TRUE(pFile);
+  fclose(pFile);
+  const int opened = gOpened;
+  const int decoded = gDecoded;
+  const ReadFrameResult header = loadHeader({}, filename.c_str());
+  removeDirectory(directory);
+  ASSERT_TRUE(header) << header.error;
+  EXPECT_EQ(4, attribute::getWithDefault<attribute::DpxImageOrientation>(header.readerAttributes));
+  EXPECT_FALSE(header.frame.pData);
+  EXPECT_EQ(opened + 1, gOpened);
+  EXPECT_EQ(decoded, gDecoded);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <duke/base/FlatMap.hpp>
+
+#include <string>
+
+using namespace std;
+
+typedef FlatMap<size_t, string> Map;
+
+TEST(FlatMap, keepsKeysSorted) {
+  Map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.insert(make_pair(5, "five")).second);
+  EXPECT_TRUE(map.insert(make_pair(1, "one")).second);
+  EXPECT_TRUE(map.emplace(3, "three").second);
+  EXPECT_EQ(3UL, map.size());
+  EXPECT_EQ(vector<size_t>({1, 3, 5}), map.keys());
+  auto itr = map.begin();
+  EXPECT_EQ("one", itr++->second);
+  EXPECT_EQ("three", itr++->second);
+  EXPECT_EQ("five", itr++->second);
+  EXPECT_EQ(map.end(), itr);
+  EXPECT_EQ("five", map.rbegin()->second);
+}
+
+TEST(FlatMap, doesNotOverwrite) {
+  Map map;
+  map.insert(make_pair(1, "one"));
+  const auto result = map.insert(make_pair(1, "uno"));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ("one", result.first->second);
+  map[1] = "uno";
+  EXPECT_EQ("uno", map.find(1)->second);
+  map[2];
+  EXPECT_EQ(2UL, map.size());
+}
+
+TEST(FlatMap, bounds) {
+  Map map;
+  EXPECT_EQ(map.end(), map.lower_bound(0));
+  EXPECT_EQ(map.end(), map.upper_bound(0));
+  map.insert(make_pair(2, "two"));
+  map.insert(make_pair(4, "four"));
+  EXPECT_EQ(map.begin(), map.lower_bound(2));
+  EXPECT_EQ(map.begin() + 1, map.upper_bound(2));
+  EXPECT_EQ(map.begin() + 1, map.lower_bound(3));
+  EXPECT_EQ(map.end(), map.upper_bound(4));
+  EXPECT_EQ(map.end(), map.find(3));
+  EXPECT_EQ(0UL, map.count(3));
+  EXPECT_EQ(1UL, map.count(4));
+}
+
+TEST(FlatMap, erase) {
+  Map map;
+  map.insert(make_pair(1, "one"));
+  map.insert(make_pair(2, "two"));
+  map.insert(make_pair(3, "three"));
+  EXPECT_EQ(1UL, map.erase(2));
+  EXPECT_EQ(0UL, map.erase(2));
+  EXPECT_EQ(vector<size_t>({1, 3}), map.keys());
+  EXPECT_EQ("three", map.erase(map.begin())->second);
+  EXPECT_EQ(vector<size_t>({3}), map.keys());
+  map.clear();
+  EXPECT_TRUE(map.empty());
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <duke/image/FrameData.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// Frame owning a copy of the pixels, shared by the tests decoding frames.
+inline duke::FrameData makeFrame(size_t width, size_t height, size_t glFormat, const void* pData, size_t dataSize) {
+  duke::FrameData frame;
+  frame.description.width = width;
+  frame.description.height = height;
+  frame.description.glFormat = glFormat;
+  frame.description.dataSize = dataSize;
+  frame.pData = std::shared_ptr<char>(new char[dataSize], std::default_delete<char[]>());
+  memcpy(frame.pData.get(), pData, dataSize);
+  return frame;
+}
+
+inline duke::FrameData makeFrame(size_t width, size_t height, size_t glFormat, const std::vector<uint8_t>& bytes) {
+  return makeFrame(width, height, glFormat, bytes.data(), bytes.size());
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <duke/engine/FramePacer.hpp>
+
+#include <vector>
+
+using namespace duke;
+using std::chrono::microseconds;
+
+namespace {
+
+// Refreshes spent on each of the first frames.
+std::vector<int> getCadence(const Time& refreshPeriod, const FrameDuration& frameDuration, size_t refreshes) {
+  const FramePacer pacer(refreshPeriod);
+  std::vector<int> cadence;
+  Time playbackTime;
+  FrameIndex::int_type lastFrame = 0;
+  int count = 0;
+  for (size_t i = 0; i < refreshes; ++i) {
+    const FrameIndex frame(playbackTime / frameDuration);
+    if (frame.round() != lastFrame) {
+      cadence.push_back(count);
+      count = 0;
+      lastFrame = frame.round();
+    }
+    ++count;
+    playbackTime += pacer.advance(1);
+  }
+  return cadence;
+}
+
+}  // namespace
+
+TEST(FramePacer, pulldown) {
+  EXPECT_EQ(std::vector<int>({3, 2, 3, 2, 3, 2}), getCadence(Time(1, 60), FrameDuration::FILM, 16));
+  EXPECT_EQ(std::vector<int>({3, 2, 3, 2, 3, 2}), getCadence(Time(1001, 60000), FrameDuration(1001, 24000), 16));
+  EXPECT_EQ(std::vector<int>({2, 2, 2, 2}), getCadence(Time(1, 50), FrameDuration::PAL, 9));
+  EXPECT_EQ(std::vector<int>({1, 1, 1, 1}), getCadence(Time(1, 25), FrameDuration::PAL, 5));
+}
+
+TEST(FramePacer, advance) {
+  const FramePacer pacer(Time(1, 60));
+  EXPECT_EQ(Time(1, 60), pacer.advance(1));
+  EXPECT_EQ(Time(1, 30), pacer.advance(2));
+}
+
+TEST(FramePacer, countRefreshes) {
+  FramePacer pacer(Time(1, 60));
+  EXPECT_EQ(1, pacer.countRefreshes(microseconds(0)));
+  EXPECT_EQ(1, pacer.countRefreshes(microseconds(16667)));
+  EXPECT_EQ(1, pacer.countRefreshes(microseconds(20000)));
+  EXPECT_EQ(2, pacer.countRefreshes(microseconds(33000)));
+  EXPECT_EQ(5, pacer.countRefreshes(microseconds(83000)));
+}
+
+TEST(FramePacer, snap) {
+  EXPECT_EQ(Time(1, 60), FramePacer::snapToStandardRate(Time(16667, 1000000)));
+  EXPECT_EQ(Time(1001, 60000), FramePacer::snapToStandardRate(Time(16683, 1000000)));
+  EXPECT_EQ(Time(1, 144), FramePacer::snapToStandardRate(Time(6944, 1000000)));
+  EXPECT_EQ(Time(1, 50), FramePacer::snapToStandardRate(Time(1, 50)));
+  // not a standard rate
+  EXPECT_EQ(Time(1, 53), FramePacer::snapToStandardRate(Time(1, 53)));
+}
+
+TEST(FramePacer, estimation) {
+  // the screen claims 60 Hz but refreshes at 59.94 Hz
+  FramePacer pacer(Time(1, 60));
+  for (int i = 0; i < 120; ++i) pacer.countRefreshes(microseconds(i % 2 ? 16673 : 16693));
+  EXPECT_EQ(Time(1001, 60000), pacer.getRefreshPeriod());
+  // missed refreshes are not used for the estimate
+  for (int i = 0; i < 120; ++i) pacer.countRefreshes(microseconds(i % 2 ? 16683 : 33366));
+  EXPECT_EQ(Time(1001, 60000), pacer.getRefreshPeriod());
+}
+
+TEST(FramePacer, exactPeriod) {
+  FramePacer pacer(Time(1, 60));
+  pacer.setRefreshPeriod(Time(1, 75));
+  for (int i = 0; i < 120; ++i) pacer.countRefreshes(microseconds(16667));
+  EXPECT_EQ(Time(1, 75), pacer.getRefreshPeriod());
+}
@@ -9,3 +9,15 @@ TEST(FsUtils, extension) {
   EXPECT_STREQ("", duke::fileExtension("."));
   EXPECT_STREQ("b", duke::fileExtension("a.b"));
 }
+
+TEST(FsUtils, createDirectories) {
+  const std::string root = duke::createTemporaryDirectory("duke-fsutils");
+  const std::string nested = root + "/a/b";
+  EXPECT_TRUE(duke::createDirectories(nested));
+  EXPECT_EQ(duke::FileStatus::DIRECTORY, duke::getFileStatus(nested.c_str()));
+  EXPECT_TRUE(duke::createDirectories(nested)) << "already existing";
+  EXPECT_FALSE(duke::createDirectories(""));
+  duke::removeDirectory(nested);
+  duke::removeDirectory(root + "/a");
+  duke::removeDirectory(root);
+}
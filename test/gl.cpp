@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <duke/gl/GlObjects.hpp>
+#include <duke/gl/RenderState.hpp>
 
 using namespace duke::gl;
 
@@ -28,3 +29,56 @@ TEST(GL, bindable) {
   EXPECT_EQ(2, bindable.boundCount);
   EXPECT_EQ(2, bindable.unboundCount);
 }
+
+// No context is current, the GL calls go to the no-op dispatch.
+const GLFWwindow* const pFirstContext = reinterpret_cast<const GLFWwindow*>(0x1000);
+const GLFWwindow* const pSecondContext = reinterpret_cast<const GLFWwindow*>(0x2000);
+
+TEST(RenderState, elidesRedundantBinds) {
+  RenderState& state = RenderState::forContext(pFirstContext);
+  state.invalidate();
+  EXPECT_TRUE(state.useProgram(3));
+  EXPECT_FALSE(state.useProgram(3));
+  EXPECT_TRUE(state.useProgram(4));
+  EXPECT_TRUE(state.activeTexture(1));
+  EXPECT_FALSE(state.activeTexture(1));
+  EXPECT_TRUE(state.bindTexture(GL_TEXTURE_2D, 5));
+  EXPECT_FALSE(state.bindTexture(GL_TEXTURE_2D, 5));
+  EXPECT_FALSE(state.bindTexture(1, GL_TEXTURE_2D, 5));
+  EXPECT_TRUE(state.bindTexture(1, GL_TEXTURE_RECTANGLE, 5)) << "another target";
+  EXPECT_TRUE(state.bindTexture(0, GL_TEXTURE_2D, 5)) << "another unit";
+  EXPECT_EQ(0, state.getActiveTexture());
+}
+
+TEST(RenderState, deletedNamesAreForgotten) {
+  RenderState& state = RenderState::forContext(pFirstContext);
+  state.invalidate();
+  EXPECT_TRUE(state.useProgram(3));
+  state.programDeleted(3);
+  EXPECT_TRUE(state.useProgram(3)) << "the name can be reused";
+  EXPECT_TRUE(state.bindTexture(0, GL_TEXTURE_2D, 5));
+  state.textureDeleted(5);
+  EXPECT_FALSE(state.bindTexture(0, GL_TEXTURE_2D, 0)) << "deleting unbinds";
+  EXPECT_TRUE(state.bindTexture(0, GL_TEXTURE_2D, 5));
+}
+
+TEST(RenderState, invalidate) {
+  RenderState& state = RenderState::forContext(pFirstContext);
+  state.useProgram(3);
+  state.bindTexture(0, GL_TEXTURE_2D, 5);
+  EXPECT_FALSE(state.useProgram(3));
+  state.invalidate();
+  EXPECT_TRUE(state.useProgram(3));
+  EXPECT_TRUE(state.activeTexture(0));
+  EXPECT_TRUE(state.bindTexture(0, GL_TEXTURE_2D, 5));
+}
+
+TEST(RenderState, invalidatedByContextSwitch) {
+  RenderState& state = RenderState::forContext(pFirstContext);
+  state.useProgram(3);
+  state.bindTexture(0, GL_TEXTURE_2D, 5);
+  EXPECT_FALSE(RenderState::forContext(pFirstContext).useProgram(3));
+  EXPECT_TRUE(RenderState::forContext(pSecondContext).useProgram(3)) << "bindings belong to each context";
+  EXPECT_TRUE(RenderState::forContext(pSecondContext).bindTexture(0, GL_TEXTURE_2D, 5));
+  EXPECT_TRUE(RenderState::forContext(pFirstContext).useProgram(3)) << "the other context may have changed";
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include <duke/math/HalfFloat.hpp>
+
+#include <cmath>
+#include <limits>
+
+using namespace duke;
+
+TEST(HalfFloat, exact) {
+  EXPECT_EQ(0x0000, toHalf(0.f));
+  EXPECT_EQ(0x8000, toHalf(-0.f));
+  EXPECT_EQ(0x3c00, toHalf(1.f));
+  EXPECT_EQ(0x3800, toHalf(.5f));
+  EXPECT_EQ(0xc000, toHalf(-2.f));
+  EXPECT_EQ(0x7bff, toHalf(65504.f));
+  EXPECT_EQ(0x0400, toHalf(std::ldexp(1.f, -14)));  // smallest normal
+  EXPECT_EQ(0x0001, toHalf(std::ldexp(1.f, -24)));  // smallest subnormal
+  EXPECT_EQ(0x0200, toHalf(std::ldexp(1.f, -15)));
+}
+
+TEST(HalfFloat, rounding) {
+  EXPECT_EQ(0x3555, toHalf(1.f / 3));
+  // 1 + 2^-11 is halfway between 1 and the next half, ties to even
+  EXPECT_EQ(0x3c00, toHalf(1.f + std::ldexp(1.f, -11)));
+  EXPECT_EQ(0x3c02, toHalf(1.f + 3 * std::ldexp(1.f, -11)));
+  EXPECT_EQ(0x3c01, toHalf(1.f + std::ldexp(1.f, -11) + std::ldexp(1.f, -20)));
+  EXPECT_EQ(0x0000, toHalf(std::ldexp(1.f, -25)));
+  EXPECT_EQ(0x0001, toHalf(std::ldexp(1.5f, -25)));
+  EXPECT_EQ(0x0400, toHalf(std::ldexp(1.f, -14) - std::ldexp(1.f, -26)));  // subnormal rounding up to normal
+}
+
+TEST(HalfFloat, roundTrip) {
+  for (uint32_t half = 0; half < 0x10000; ++half) {
+    if ((half & 0x7c00) == 0x7c00 && (half & 0x3ff)) continue;  // NaNs
+    ASSERT_EQ(half, toHalf(fromHalf(half))) << std::hex << half;
+  }
+  EXPECT_EQ(1.f, fromHalf(0x3c00));
+  EXPECT_EQ(std::ldexp(1.f, -24), fromHalf(0x0001));
+  EXPECT_TRUE(std::isnan(fromHalf(0x7e00)));
+}
+
+TEST(HalfFloat, special) {
+  EXPECT_EQ(0x7c00, toHalf(65520.f));
+  EXPECT_EQ(0x7c00, toHalf(1e10f));
+  EXPECT_EQ(0xfc00, toHalf(-std::numeric_limits<float>::infinity()));
+  const uint16_t nan = toHalf(std::numeric_limits<float>::quiet_NaN());
+  EXPECT_EQ(0x7c00, nan & 0x7c00);
+  EXPECT_NE(0, nan & 0x3ff);
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <duke/engine/rendering/ImageUniforms.hpp>
+#include <duke/engine/rendering/ShaderFactory.hpp>
+
+#include <vector>
+
+using namespace std;
+using namespace duke;
+
+namespace {
+
+vector<GLint> getSwizzle(bool grayscale, bool swapRedAndBlue, bool swapEndianness) {
+  ImageUniforms uniforms;
+  setSwizzle(uniforms, grayscale, swapRedAndBlue, swapEndianness);
+  return vector<GLint>(uniforms.swizzle, uniforms.swizzle + 4);
+}
+
+}  // namespace
+
+TEST(ImageUniforms, swizzle) {
+  EXPECT_EQ(vector<GLint>({0, 1, 2, 3}), getSwizzle(false, false, false));  // rgba
+  EXPECT_EQ(vector<GLint>({0, 0, 0, 3}), getSwizzle(true, false, false));   // rrra
+  EXPECT_EQ(vector<GLint>({2, 1, 0, 3}), getSwizzle(false, true, false));   // bgra
+  EXPECT_EQ(vector<GLint>({3, 2, 1, 0}), getSwizzle(false, false, true));   // abgr
+  EXPECT_EQ(vector<GLint>({3, 0, 1, 2}), getSwizzle(false, true, true));    // argb
+}
+
+TEST(ImageUniforms, alignedStride) {
+  EXPECT_EQ(96, getAlignedStride(sizeof(ImageUniforms), 0));
+  EXPECT_EQ(96, getAlignedStride(sizeof(ImageUniforms), 16));
+  EXPECT_EQ(256, getAlignedStride(sizeof(ImageUniforms), 256));
+  EXPECT_EQ(256, getAlignedStride(256, 256));
+}
+
+TEST(ImageUniforms, programKey) {
+  const auto rgb = ShaderDescription::createTextureDesc(false, false, false, false, duke::ColorSpace::linear,
+                                                        duke::ColorSpace::sRGB, "");
+  const auto bgr = ShaderDescription::createTextureDesc(true, true, true, false, duke::ColorSpace::Cineon,
+                                                        duke::ColorSpace::linear, "");
+  const auto tenBit = ShaderDescription::createTextureDesc(false, false, false, true, duke::ColorSpace::linear,
+                                                           duke::ColorSpace::sRGB, "");
+  const auto sameKey = [](const ShaderDescription& a, const ShaderDescription& b) {
+    return !(getProgramKey(a) < getProgramKey(b)) && !(getProgramKey(b) < getProgramKey(a));
+  };
+  EXPECT_TRUE(sameKey(rgb, bgr)) << "swizzling and colorspaces are not compiled in";
+  EXPECT_FALSE(sameKey(rgb, tenBit)) << "10 bits images use an integer sampler";
+  EXPECT_EQ(buildFragmentShaderSource(getProgramKey(rgb)), buildFragmentShaderSource(getProgramKey(bgr)));
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <duke/attributes/AttributeKeys.hpp>
+#include <duke/benchmark/SyntheticSequence.hpp>
+#include <duke/engine/ColorTransforms.hpp>
+#include <duke/engine/ImageLoadUtils.hpp>
+#include <duke/engine/SequenceWriter.hpp>
+#include <duke/filesystem/FsUtils.hpp>
+#include <duke/gl/GL.hpp>
+#include <duke/imageio/DukeIO.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+using namespace duke;
+
+namespace {
+
+// Writes the frame with the plugin writer and reads it back with the readers.
+struct RoundTrip : public ::testing::Test {
+  RoundTrip() : directory(createTemporaryDirectory("duke-writers")) {}
+  ~RoundTrip() { removeDirectory(directory); }
+
+  static bool canWrite(const char* pExtension) {
+    return IODescriptors::instance().findWriterDescriptor(pExtension) != nullptr;
+  }
+
+  ReadFrameResult writeAndRead(const char* pExtension, const FrameData& frame) {
+    const std::string filename = directory + "/frame." + pExtension;
+    writeImage(filename, frame);
+    ReadFrameResult result;
+    attribute::set<attribute::File>(result.attributes(), filename.c_str());
+    return load({}, [](FrameData& read, const void* pVolatileData) {
+                  if (read.pData.get() == pVolatileData) return;
+                  read.pData.reset(new char[read.description.dataSize], [](char* p) { delete[] p; });
+                  memcpy(read.pData.get(), pVolatileData, read.description.dataSize);
+                }, std::move(result));
+  }
+
+  // Compares in linear light, whatever layout and bit depth the reader picked.
+  static void expectSameImage(const FrameData& expected, const FrameData& read, float tolerance) {
+    ASSERT_EQ(expected.description.width, read.description.width);
+    ASSERT_EQ(expected.description.height, read.description.height);
+    RgbaImage expectedImage, readImage;
+    decodeToLinear(expected, ColorSpace::linear, expectedImage);
+    decodeToLinear(read, ColorSpace::linear, readImage);
+    const bool bottomUp = attribute::getWithDefault<attribute::DpxImageOrientation>(read.attributes) == 4;
+    const size_t height = readImage.height;
+    for (size_t y = 0; y < height; ++y) {
+      const float* pExpected = expectedImage.row(y);
+      const float* pRead = readImage.row(bottomUp ? height - 1 - y : y);
+      for (size_t i = 0; i < readImage.width * 4; ++i) ASSERT_NEAR(pExpected[i], pRead[i], tolerance) << "row " << y;
+    }
+  }
+
+  const std::string directory;
+};
+
+}  // namespace
+
+TEST_F(RoundTrip, dpx) {
+  if (!canWrite("dpx")) return;
+  const FrameData frame = makeSyntheticFrame(16, 8, 3, GL_RGB16);
+  const ReadFrameResult read = writeAndRead("dpx", frame);
+  ASSERT_TRUE(read) << read.error;
+  expectSameImage(frame, read.frame, 1 / 1023.f);
+}
+
+TEST_F(RoundTrip, dpxBottomUp) {
+  if (!canWrite("dpx")) return;
+  FrameData frame = makeSyntheticFrame(4, 3, 0, GL_RGB8);
+  attribute::set<attribute::DpxImageOrientation>(frame.attributes, 4);
+  const ReadFrameResult read = writeAndRead("dpx", frame);
+  ASSERT_TRUE(read) << read.error;
+  // the file is top to bottom, the first row written is the last in memory
+  FrameData expected = makeSyntheticFrame(4, 3, 0, GL_RGB8);
+  const size_t rowSize = 4 * 3;
+  for (size_t y = 0; y < 3; ++y)
+    memcpy(expected.pData.get() + y * rowSize, frame.pData.get() + (2 - y) * rowSize, rowSize);
+  expectSameImage(expected, read.frame, 1 / 255.f);
+}
+
+TEST_F(RoundTrip, tga) {
+  if (!canWrite("tga")) return;
+  const FrameData frame = makeSyntheticFrame(16, 8, 5, GL_RGB8);
+  const ReadFrameResult read = writeAndRead("tga", frame);
+  ASSERT_TRUE(read) << read.error;
+  expectSameImage(frame, read.frame, 0);
+}
+
+TEST_F(RoundTrip, exr) {
+  if (!canWrite("exr")) return;  // needs OpenImageIO
+  const FrameData frame = makeSyntheticFrame(16, 8, 7, GL_RGB16F);
+  const ReadFrameResult read = writeAndRead("exr", frame);
+  ASSERT_TRUE(read) << read.error;
+  expectSameImage(frame, read.frame, 0);
+}
+
+TEST_F(RoundTrip, unknownExtension) {
+  EXPECT_THROW(writeImage(directory + "/frame.unknown", FrameData()), std::runtime_error);
+}
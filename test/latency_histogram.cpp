@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <duke/time/LatencyHistogram.hpp>
+
+#include <cmath>
+
+using duke::LatencyHistogram;
+using duke::SampleRing;
+
+TEST(LatencyHistogram, empty) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(0, histogram.count());
+  EXPECT_EQ(0, histogram.min());
+  EXPECT_EQ(0, histogram.max());
+  EXPECT_EQ(0, histogram.mean());
+  EXPECT_EQ(0, histogram.percentile(50));
+}
+
+TEST(LatencyHistogram, buckets) {
+  // small values are exact
+  for (uint64_t value = 0; value < 64; ++value) {
+    EXPECT_EQ(value, LatencyHistogram::getBucketIndex(value));
+    EXPECT_EQ(value, LatencyHistogram::getBucketValue(value));
+  }
+  // larger values are within 1/32 of their bucket lower bound
+  uint64_t previousIndex = 63;
+  for (uint64_t value = 64; value < (1ULL << 32); value = value * 5 / 4) {
+    const size_t index = LatencyHistogram::getBucketIndex(value);
+    ASSERT_LT(index, LatencyHistogram::kBuckets);
+    EXPECT_GE(index, previousIndex);
+    const uint64_t lower = LatencyHistogram::getBucketValue(index);
+    EXPECT_LE(lower, value);
+    EXPECT_LE(value - lower, lower / 32);
+    previousIndex = index;
+  }
+  EXPECT_EQ(LatencyHistogram::kBuckets - 1, LatencyHistogram::getBucketIndex(~0ULL));
+}
+
+TEST(LatencyHistogram, percentiles) {
+  LatencyHistogram histogram;
+  for (uint64_t value = 1; value <= 10000; ++value) histogram.record(value);
+  EXPECT_EQ(10000, histogram.count());
+  EXPECT_EQ(1, histogram.min());
+  EXPECT_EQ(10000, histogram.max());
+  EXPECT_DOUBLE_EQ(5000.5, histogram.mean());
+  EXPECT_NEAR(5000, histogram.percentile(50), 5000 / 32.);
+  EXPECT_NEAR(9500, histogram.percentile(95), 9500 / 32.);
+  EXPECT_NEAR(9900, histogram.percentile(99), 9900 / 32.);
+  EXPECT_EQ(1, histogram.percentile(0));
+  EXPECT_EQ(10000, histogram.percentile(100));
+  histogram.reset();
+  EXPECT_EQ(0, histogram.count());
+}
+
+TEST(LatencyHistogram, singleValue) {
+  LatencyHistogram histogram;
+  histogram.record(40000);
+  EXPECT_EQ(40000, histogram.percentile(50));
+  EXPECT_EQ(40000, histogram.percentile(99));
+}
+
+TEST(SampleRing, wraps) {
+  SampleRing<3> ring;
+  EXPECT_EQ(0, ring.size());
+  ring.push(1);
+  ring.push(2);
+  EXPECT_EQ(2, ring.size());
+  EXPECT_EQ(1, ring[0]);
+  EXPECT_EQ(2, ring[1]);
+  ring.push(3);
+  ring.push(4);
+  EXPECT_EQ(3, ring.size());
+  EXPECT_EQ(2, ring[0]);
+  EXPECT_EQ(3, ring[1]);
+  EXPECT_EQ(4, ring[2]);
+  EXPECT_EQ(4, ring.max());
+}
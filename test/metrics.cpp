@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <duke/metrics/Metrics.hpp>
+#include <duke/metrics/MetricsServer.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+using namespace duke;
+
+namespace {
+
+std::string format(const MetricsSnapshot& snapshot) {
+  std::ostringstream stream;
+  writePrometheus(stream, snapshot);
+  return stream.str();
+}
+
+std::string get(uint16_t port, const std::string& path) {
+  const int client = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(port);
+  if (connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+    close(client);
+    return "";
+  }
+  const std::string request = "GET " + path + " HTTP/1.0\r\n\r\n";
+  send(client, request.data(), request.size(), 0);
+  std::string response;
+  char buffer[256];
+  for (ssize_t count; (count = recv(client, buffer, sizeof(buffer), 0)) > 0;) response.append(buffer, count);
+  close(client);
+  return response;
+}
+
+}  // namespace
+
+TEST(Metrics, empty) { EXPECT_EQ("", format(MetricsSnapshot())); }
+
+TEST(Metrics, gauge) {
+  MetricsSnapshot snapshot;
+  snapshot.add("duke_bytes", "Memory used.", MetricType::GAUGE, 524288000);
+  EXPECT_EQ(
+      "# HELP duke_bytes Memory used.\n"
+      "# TYPE duke_bytes gauge\n"
+      "duke_bytes 524288000\n",
+      format(snapshot));
+}
+
+TEST(Metrics, labels) {
+  MetricsSnapshot snapshot;
+  snapshot.add("duke_frames", "Frames.", MetricType::COUNTER, 1, {{"stream", "a"}});
+  snapshot.add("duke_frames", "Frames.", MetricType::COUNTER, 2.5, {{"stream", "b\"\\\n"}, {"kind", "x"}});
+  EXPECT_EQ(
+      "# HELP duke_frames Frames.\n"
+      "# TYPE duke_frames counter\n"
+      "duke_frames{stream=\"a\"} 1\n"
+      "duke_frames{stream=\"b\\\"\\\\\\n\",kind=\"x\"} 2.5\n",
+      format(snapshot));
+}
+
+TEST(Metrics, summary) {
+  MetricsSnapshot snapshot;
+  snapshot.addSummary("duke_decode_seconds", "Decode.", {{"format", "dpx"}}, {{0.5, 0.01}, {0.99, 0.02}}, 1.5, 100);
+  EXPECT_EQ(
+      "# HELP duke_decode_seconds Decode.\n"
+      "# TYPE duke_decode_seconds summary\n"
+      "duke_decode_seconds{format=\"dpx\",quantile=\"0.5\"} 0.01\n"
+      "duke_decode_seconds{format=\"dpx\",quantile=\"0.99\"} 0.02\n"
+      "duke_decode_seconds_sum{format=\"dpx\"} 1.5\n"
+      "duke_decode_seconds_count{format=\"dpx\"} 100\n",
+      format(snapshot));
+}
+
+TEST(Metrics, specialValues) {
+  MetricsSnapshot snapshot;
+  snapshot.add("a", "", MetricType::GAUGE, std::numeric_limits<double>::infinity());
+  snapshot.add("b", "", MetricType::GAUGE, std::numeric_limits<double>::quiet_NaN());
+  EXPECT_EQ("a +Inf\nb NaN\n", format(snapshot));
+}
+
+TEST(MetricsServer, serves) {
+  MetricsServer server(0);
+  ASSERT_NE(0, server.getPort());
+  EXPECT_TRUE(server.publish("duke_up 1\n"));
+  const std::string response = get(server.getPort(), "/metrics");
+  EXPECT_EQ(0, response.find("HTTP/1.0 200 OK\r\n"));
+  EXPECT_NE(std::string::npos, response.find("\r\n\r\nduke_up 1\n"));
+  EXPECT_EQ(0, get(server.getPort(), "/other").find("HTTP/1.0 404"));
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include <duke/OpenColorIO/OpenColorIOCpu.hpp>
+
+namespace OCIO = OCIO_NAMESPACE;
+using namespace duke;
+
+namespace {
+
+RgbaImage makeImage(size_t width, size_t height) {
+  RgbaImage image;
+  image.width = width;
+  image.height = height;
+  image.pixels.resize(width * height * 4);
+  for (size_t i = 0; i < image.pixels.size(); ++i) image.pixels[i] = i % 4 == 3 ? 1.f : i / 100.f;
+  return image;
+}
+
+OCIO::ConstProcessorRcPtr getOffsetProcessor(float red, float green, float blue) {
+  const OCIO::ConfigRcPtr config = OCIO::Config::Create();
+  const OCIO::MatrixTransformRcPtr transform = OCIO::MatrixTransform::Create();
+  const float offset[4] = {red, green, blue, 0.f};
+  transform->setOffset(offset);
+  return config->getProcessor(transform);
+}
+
+}  // namespace
+
+TEST(OpenColorIOCpu, appliesToEveryRow) {
+  const RgbaImage source = makeImage(3, 5);
+  for (const unsigned threads : {1u, 2u, 0u}) {
+    RgbaImage image = source;
+    applyProcessor(getOffsetProcessor(.25f, .5f, .75f), image, threads);
+    for (size_t i = 0; i < image.pixels.size(); i += 4) {
+      EXPECT_FLOAT_EQ(source.pixels[i] + .25f, image.pixels[i]) << "pixel " << i / 4;
+      EXPECT_FLOAT_EQ(source.pixels[i + 1] + .5f, image.pixels[i + 1]);
+      EXPECT_FLOAT_EQ(source.pixels[i + 2] + .75f, image.pixels[i + 2]);
+      EXPECT_FLOAT_EQ(1.f, image.pixels[i + 3]) << "alpha is kept";
+    }
+  }
+}
+
+TEST(OpenColorIOCpu, noOp) {
+  const RgbaImage source = makeImage(2, 2);
+  RgbaImage image = source;
+  const auto processor = getOffsetProcessor(0.f, 0.f, 0.f);
+  EXPECT_TRUE(processor->isNoOp());
+  applyProcessor(processor, image);
+  EXPECT_EQ(source.pixels, image.pixels);
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <duke/base/ParallelFor.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(ParallelFor, coversEachIndexOnce) {
+  for (const unsigned threads : {0u, 1u, 3u, 8u}) {
+    for (const size_t count : {0, 1, 5, 100}) {
+      std::vector<std::atomic<int> > visits(count);
+      for (auto& visit : visits) visit = 0;
+      parallelFor(count, threads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) ++visits[i];
+      });
+      for (const auto& visit : visits) EXPECT_EQ(1, visit);
+    }
+  }
+}
+
+TEST(ParallelFor, rethrows) {
+  EXPECT_THROW(parallelFor(10, 4,
+                           [](size_t begin, size_t) {
+                             if (begin > 0) throw std::runtime_error("failed");
+                           }),
+               std::runtime_error);
+}
+
+TEST(ParallelFor, reusesThreads) {
+  std::mutex mutex;
+  std::set<std::thread::id> ids;
+  for (int i = 0; i < 20; ++i)
+    parallelFor(64, 8, [&](size_t, size_t) {
+      std::lock_guard<std::mutex> lock(mutex);
+      ids.insert(std::this_thread::get_id());
+    });
+  EXPECT_LE(ids.size(), getPoolThreadCount() + 1) << "the pool threads and the caller";
+}
+
+TEST(ParallelFor, nested) {
+  std::atomic<int> visits(0);
+  parallelFor(8, 8, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      parallelFor(8, 8, [&](size_t innerBegin, size_t innerEnd) { visits += innerEnd - innerBegin; });
+  });
+  EXPECT_EQ(64, visits);
+}
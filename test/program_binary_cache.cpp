@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <duke/engine/rendering/ProgramBinaryCache.hpp>
+#include <duke/filesystem/FsUtils.hpp>
+
+#include <cstdio>
+#include <sstream>
+
+using namespace std;
+using namespace duke;
+
+TEST(ProgramBinaryCache, hash) {
+  const auto hash = hashProgramSources("driver", "vs", "fs");
+  EXPECT_EQ(hash, hashProgramSources("driver", "vs", "fs"));
+  EXPECT_NE(hash, hashProgramSources("other driver", "vs", "fs"));
+  EXPECT_NE(hash, hashProgramSources("driver", "vsf", "s"));
+}
+
+TEST(ProgramBinaryCache, binaryFile) {
+  const string directory = createTemporaryDirectory("duke-programs");
+  const string filename = directory + "/program.bin";
+  ProgramBinary binary;
+  EXPECT_FALSE(readProgramBinary(filename, binary));
+
+  binary.format = 0x1234;
+  binary.data = {'a', 'b', 'c'};
+  EXPECT_TRUE(writeProgramBinary(filename, binary));
+  ProgramBinary read;
+  EXPECT_TRUE(readProgramBinary(filename, read));
+  EXPECT_EQ(binary.format, read.format);
+  EXPECT_EQ(binary.data, read.data);
+
+  binary.data.clear();
+  EXPECT_TRUE(writeProgramBinary(filename, binary));
+  EXPECT_FALSE(readProgramBinary(filename, read)) << "empty binary";
+
+  FILE* pFile = fopen(filename.c_str(), "wb");
+  fputs("not a binary", pFile);
+  fclose(pFile);
+  EXPECT_FALSE(readProgramBinary(filename, read));
+  removeDirectory(directory);
+}
+
+TEST(ProgramBinaryCache, variants) {
+  const string directory = createTemporaryDirectory("duke-programs");
+  const ProgramBinaryCache cache(directory);
+  ASSERT_TRUE(cache.isEnabled());
+  EXPECT_TRUE(cache.loadVariants().empty());
+
+  auto texture = ShaderDescription::createTextureDesc(false, true, false, true, duke::ColorSpace::Cineon,
+                                                      duke::ColorSpace::sRGB,
+                                                      "vec4 OCIODisplay(vec4 inPixel)\n{\n}\n");
+  const vector<ShaderDescription> variants = {ShaderDescription::createSolidDesc(), texture};
+  cache.storeVariants(variants);
+  const auto loaded = cache.loadVariants();
+  ASSERT_EQ(2UL, loaded.size());
+  for (size_t i = 0; i < variants.size(); ++i) {
+    EXPECT_FALSE(variants[i] < loaded[i]);
+    EXPECT_FALSE(loaded[i] < variants[i]);
+  }
+  removeDirectory(directory);
+}
+
+TEST(ProgramBinaryCache, disabled) {
+  const ProgramBinaryCache cache("");
+  EXPECT_FALSE(cache.isEnabled());
+  EXPECT_TRUE(cache.loadVariants().empty());
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <duke/imageio/Region.hpp>
+
+using namespace duke;
+
+TEST(Region, defaultIsFull) {
+  EXPECT_TRUE(Region().isFull());
+  EXPECT_EQ(0UL, Region().left(100));
+  EXPECT_EQ(100UL, Region().right(100));
+  EXPECT_EQ(0UL, Region().top(50));
+  EXPECT_EQ(50UL, Region().bottom(50));
+}
+
+TEST(Region, fromNormalized) {
+  EXPECT_EQ(Region(), Region::fromNormalized(0, 0, 1, 1));
+  EXPECT_EQ(Region(), Region::fromNormalized(-1, -1, 2, 2));
+  EXPECT_EQ(Region(4, 4, 12, 12), Region::fromNormalized(.25, .25, .75, .75));
+  // cells are enlarged to cover the rectangle
+  EXPECT_EQ(Region(3, 4, 13, 12), Region::fromNormalized(.24, .25, .76, .75));
+}
+
+TEST(Region, neverEmpty) {
+  EXPECT_EQ(Region(15, 15, 16, 16), Region::fromNormalized(1, 1, 1, 1));
+  EXPECT_EQ(Region(0, 0, 1, 1), Region::fromNormalized(0, 0, 0, 0));
+}
+
+TEST(Region, pixels) {
+  const Region region(4, 8, 12, 16);
+  EXPECT_FALSE(region.isFull());
+  EXPECT_EQ(1024UL, region.left(4096));
+  EXPECT_EQ(3072UL, region.right(4096));
+  EXPECT_EQ(1080UL, region.top(2160));
+  EXPECT_EQ(2160UL, region.bottom(2160));
+}
+
+TEST(Region, contains) {
+  EXPECT_TRUE(Region().contains(Region(4, 4, 12, 12)));
+  EXPECT_FALSE(Region(4, 4, 12, 12).contains(Region()));
+  EXPECT_TRUE(Region(4, 4, 12, 12).contains(Region(4, 4, 12, 12)));
+}
+
+TEST(Region, attributes) {
+  attribute::Attributes attributes;
+  EXPECT_TRUE(getRegionOfInterest(attributes).isFull());
+  setRegionOfInterest(attributes, Region(1, 2, 3, 4));
+  EXPECT_EQ(Region(1, 2, 3, 4), getRegionOfInterest(attributes));
+}
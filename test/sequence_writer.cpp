@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <duke/engine/SequenceWriter.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+using namespace duke;
+
+namespace {
+
+FrameData getFrame(size_t width) {
+  FrameData frame;
+  frame.description.width = width;
+  frame.description.height = 1;
+  return frame;
+}
+
+}  // namespace
+
+TEST(SequenceWriter, writesAllFrames) {
+  std::mutex mutex;
+  std::set<std::string> written;
+  {
+    SequenceWriter writer(4, 0, [&](const std::string& filename, const FrameData&) {
+      std::lock_guard<std::mutex> lock(mutex);
+      written.insert(filename);
+    });
+    for (size_t i = 0; i < 100; ++i) writer.push(std::to_string(i), getFrame(i));
+    writer.finish();
+    EXPECT_EQ(100, writer.getWrittenCount());
+  }
+  EXPECT_EQ(100, written.size());
+}
+
+TEST(SequenceWriter, writesInParallel) {
+  std::atomic<int> running(0);
+  std::atomic<int> maxRunning(0);
+  SequenceWriter writer(4, 0, [&](const std::string&, const FrameData&) {
+    const int current = ++running;
+    for (int max = maxRunning; current > max && !maxRunning.compare_exchange_weak(max, current);) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    --running;
+  });
+  for (size_t i = 0; i < 16; ++i) writer.push(std::to_string(i), getFrame(i));
+  writer.finish();
+  EXPECT_GT(maxRunning, 1);
+  EXPECT_LE(maxRunning, 4);
+}
+
+TEST(SequenceWriter, boundsPendingFrames) {
+  std::atomic<size_t> pushed(0);
+  std::atomic<bool> release(false);
+  SequenceWriter writer(1, 2, [&](const std::string&, const FrameData&) {
+    while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  });
+  std::thread producer([&] {
+    for (size_t i = 0; i < 10; ++i, ++pushed) writer.push(std::to_string(i), getFrame(i));
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  // one frame being written and two queued
+  EXPECT_LE(pushed, 3);
+  release = true;
+  producer.join();
+  writer.finish();
+  EXPECT_EQ(10, writer.getWrittenCount());
+}
+
+TEST(SequenceWriter, rethrowsFirstError) {
+  SequenceWriter writer(2, 0, [](const std::string& filename, const FrameData&) {
+    if (filename == "3") throw std::runtime_error("unable to write 3");
+  });
+  // the error surfaces in whichever call comes after it
+  bool thrown = false;
+  try {
+    for (size_t i = 0; i < 8; ++i) writer.push(std::to_string(i), getFrame(i));
+    writer.finish();
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  EXPECT_TRUE(thrown);
+  EXPECT_NO_THROW(writer.finish());
+}
+
+TEST(SequenceWriter, noWriterForExtension) {
+  EXPECT_THROW(writeImage("frame.unknown_extension", getFrame(1)), std::runtime_error);
+  EXPECT_THROW(writeImage("no_extension", getFrame(1)), std::runtime_error);
+}
@@ -0,0 +1,20 @@
+#include <gtest/gtest.h>
+
+#include <duke/engine/rendering/ShaderPool.hpp>
+#include <duke/filesystem/FsUtils.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace duke;
+
+TEST(ShaderPool, keepsPreviousVariantsInItsDirectory) {
+  const string directory = createTemporaryDirectory("duke-programs");
+  const vector<ShaderDescription> variants = {ShaderDescription::createSolidDesc()};
+  ProgramBinaryCache(directory).storeVariants(variants);
+  { const ShaderPool pool(directory); }
+  // nothing was built, the previous session's variants are carried over
+  EXPECT_EQ(1UL, ProgramBinaryCache(directory).loadVariants().size());
+  removeDirectory(directory);
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <duke/benchmark/SyntheticSequence.hpp>
+#include <duke/filesystem/FsUtils.hpp>
+#include <duke/gl/GL.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+using namespace duke;
+
+namespace {
+
+bool same(const FrameData& a, const FrameData& b) {
+  return a.description.dataSize == b.description.dataSize &&
+         memcmp(a.pData.get(), b.pData.get(), a.description.dataSize) == 0;
+}
+
+}  // namespace
+
+TEST(SyntheticSequence, frame) {
+  const FrameData frame = makeSyntheticFrame(16, 8, 0, GL_RGB16);
+  EXPECT_EQ(16, frame.description.width);
+  EXPECT_EQ(8, frame.description.height);
+  EXPECT_EQ(GL_RGB16, frame.description.glFormat);
+  EXPECT_EQ(16 * 8 * 3 * 2, frame.description.dataSize);
+  EXPECT_EQ(16 * 8 * 3, makeSyntheticFrame(16, 8, 0, GL_RGB8).description.dataSize);
+  EXPECT_EQ(16 * 8 * 3 * 2, makeSyntheticFrame(16, 8, 0, GL_RGB16F).description.dataSize);
+  EXPECT_THROW(makeSyntheticFrame(16, 8, 0, GL_RGBA32F), std::invalid_argument);
+}
+
+TEST(SyntheticSequence, framesDiffer) {
+  for (const size_t format : {GL_RGB8, GL_RGB16, GL_RGB16F})
+    EXPECT_FALSE(same(makeSyntheticFrame(16, 8, 0, format), makeSyntheticFrame(16, 8, 1, format)));
+}
+
+TEST(SyntheticSequence, formats) { EXPECT_FALSE(isSyntheticFormatSupported("jpg")); }
+
+TEST(SyntheticSequence, writesAllFrames) {
+  if (!isSyntheticFormatSupported("dpx")) return;
+  const std::string directory = createTemporaryDirectory("duke-synthetic");
+  writeSyntheticSequence(directory, "dpx", 16, 8, 3);
+  for (const char* pName : {"/synthetic.0000.dpx", "/synthetic.0001.dpx", "/synthetic.0002.dpx"}) {
+    const std::string filename = directory + pName;
+    EXPECT_EQ(0, remove(filename.c_str())) << filename;
+  }
+  removeDirectory(directory);
+}
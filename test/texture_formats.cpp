@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <duke/gl/GLUtils.hpp>
+#include <duke/gl/TextureFormats.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+using namespace duke;
+
+TEST(TextureFormatTable, candidates) {
+  EXPECT_EQ(std::vector<GLint>({GL_RGB8, GL_RGBA8}), TextureFormatTable::getCandidates(GL_RGB8));
+  EXPECT_EQ(std::vector<GLint>({GL_RGBA16F}), TextureFormatTable::getCandidates(GL_RGBA16F));
+  EXPECT_EQ(std::vector<GLint>({GL_RGBA8UI}), TextureFormatTable::getCandidates(GL_RGB10_A2UI));
+}
+
+TEST(TextureFormatTable, defaultsToAdaptedFormat) {
+  TextureFormatTable table;
+  EXPECT_TRUE(table.empty());
+  EXPECT_EQ(GL_RGB8, table.get(GL_RGB8));
+  EXPECT_EQ(GL_RGBA8UI, table.get(GL_RGB10_A2UI));
+  table.set(GL_RGB8, GL_RGBA8);
+  EXPECT_EQ(GL_RGBA8, table.get(GL_RGB8));
+}
+
+TEST(TextureFormatTable, readOnlyThisDriver) {
+  std::stringstream stream;
+  stream << "A\t" << GL_RGB8 << '\t' << GL_RGBA8 << '\n';
+  stream << "AB\t" << GL_RGB16F << '\t' << GL_RGBA16F << '\n';
+  stream << "A\t" << GL_RGB16 << '\t' << GL_RGBA8 << '\n';  // not a candidate
+  stream << "garbage\n";
+  TextureFormatTable table;
+  table.read(stream, "A");
+  EXPECT_EQ(GL_RGBA8, table.get(GL_RGB8));
+  EXPECT_EQ(GL_RGB16F, table.get(GL_RGB16F));
+  EXPECT_EQ(GL_RGB16, table.get(GL_RGB16));
+}
+
+TEST(TextureFormatTable, writeKeepsOtherDrivers) {
+  std::stringstream previous;
+  previous << "A\t" << GL_RGB8 << '\t' << GL_RGB8 << '\n';
+  previous << "B\t" << GL_RGB8 << '\t' << GL_RGBA8 << '\n';
+  TextureFormatTable table;
+  table.set(GL_RGB8, GL_RGBA8);
+  std::stringstream written;
+  table.write(previous, written, "A");
+
+  const std::string content = written.str();
+  EXPECT_EQ(2, std::count(content.begin(), content.end(), '\n'));
+  TextureFormatTable readA, readB;
+  std::stringstream streamA(content), streamB(content);
+  readA.read(streamA, "A");
+  readB.read(streamB, "B");
+  EXPECT_EQ(GL_RGBA8, readA.get(GL_RGB8));
+  EXPECT_EQ(GL_RGBA8, readB.get(GL_RGB8));
+}
@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+
+#include "frame_fixtures.hpp"
+
+#include <duke/attributes/AttributeKeys.hpp>
+#include <duke/engine/Thumbnails.hpp>
+#include <duke/engine/overlay/ContactSheetOverlay.hpp>
+#include <duke/engine/streams/IMediaStream.hpp>
+#include <duke/engine/streams/MediaFrameReference.hpp>
+#include <duke/filesystem/FsUtils.hpp>
+#include <duke/gl/GL.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace duke;
+
+namespace {
+
+RgbaImage makeImage(size_t width, size_t height) {
+  RgbaImage image;
+  image.width = width;
+  image.height = height;
+  image.pixels.resize(width * height * 4);
+  for (size_t i = 0; i < image.pixels.size(); ++i) image.pixels[i] = float(i);
+  return image;
+}
+
+void writeFile(const std::string& filename, const char* pContent) {
+  FILE* pFile = fopen(filename.c_str(), "wb");
+  ASSERT_TRUE(pFile);
+  fputs(pContent, pFile);
+  fclose(pFile);
+}
+
+struct FakeStream : public IMediaStream {
+  FakeStream(size_t width, size_t height, bool error) : width(width), height(height), error(error) {}
+  ReadFrameResult process(const size_t, const attribute::Attributes& request) const override {
+    requestedProxyLevel = attribute::getWithDefault<attribute::ProxyLevel>(request);
+    ReadFrameResult result;
+    if (error) {
+      result.error = "unreadable";
+      return result;
+    }
+    result.frame = makeFrame(width, height, GL_RGB8, std::vector<uint8_t>(width * height * 3));
+    result.status = IOResult::SUCCESS;
+    return result;
+  }
+  bool isForwardOnly() const override { return false; }
+  const attribute::Attributes& getState() const override { return state; }
+
+  const size_t width, height;
+  const bool error;
+  attribute::Attributes state;
+  mutable uint8_t requestedProxyLevel = 0;
+};
+
+// Blocks its reader until released.
+struct BlockingStream : public FakeStream {
+  BlockingStream(const std::atomic<bool>& released) : FakeStream(8, 8, false), released(released) {}
+  ReadFrameResult process(const size_t frame, const attribute::Attributes& request) const override {
+    while (!released) std::this_thread::yield();
+    return FakeStream::process(frame, request);
+  }
+
+  const std::atomic<bool>& released;
+};
+
+}  // namespace
+
+TEST(Thumbnails, downscaleAveragesCoveredPixels) {
+  const RgbaImage source = makeImage(4, 2);
+  RgbaImage destination;
+  downscale(source, 2, 1, destination);
+  ASSERT_EQ(2, destination.width);
+  ASSERT_EQ(1, destination.height);
+  // first channel of pixels (0,0), (1,0), (0,1), (1,1)
+  EXPECT_FLOAT_EQ((0 + 4 + 16 + 20) / 4.f, destination.pixels[0]);
+  EXPECT_FLOAT_EQ((8 + 12 + 24 + 28) / 4.f, destination.pixels[4]);
+}
+
+TEST(Thumbnails, downscaleUnevenRatio) {
+  const RgbaImage source = makeImage(5, 1);
+  RgbaImage destination;
+  downscale(source, 2, 1, destination, 2);
+  // pixels 0 and 1 then 2, 3 and 4
+  EXPECT_FLOAT_EQ((0 + 4) / 2.f, destination.pixels[0]);
+  EXPECT_FLOAT_EQ((8 + 12 + 16) / 3.f, destination.pixels[4]);
+}
+
+TEST(Thumbnails, downscaleOnlyShrinks) {
+  const RgbaImage source = makeImage(2, 2);
+  RgbaImage destination;
+  EXPECT_THROW(downscale(source, 3, 2, destination), std::invalid_argument);
+  EXPECT_THROW(downscale(source, 0, 2, destination), std::invalid_argument);
+}
+
+TEST(Thumbnails, createKeepsAspectRatio) {
+  const FrameData frame = makeFrame(8, 4, GL_RGB8, std::vector<uint8_t>(8 * 4 * 3, 128));
+  const Thumbnail thumbnail = createThumbnail(frame, ColorSpace::sRGB, 4);
+  EXPECT_EQ(4, thumbnail.width);
+  EXPECT_EQ(2, thumbnail.height);
+  ASSERT_EQ(4 * 2 * 3, thumbnail.pixels.size());
+  for (const uint8_t value : thumbnail.pixels) EXPECT_EQ(128, value);
+}
+
+TEST(Thumbnails, createNeverEnlarges) {
+  const FrameData frame = makeFrame(2, 1, GL_RGB8, std::vector<uint8_t>(2 * 3, 255));
+  const Thumbnail thumbnail = createThumbnail(frame, ColorSpace::sRGB, 64);
+  EXPECT_EQ(2, thumbnail.width);
+  EXPECT_EQ(1, thumbnail.height);
+}
+
+TEST(Thumbnails, createAveragesInLinearLight) {
+  // black and white average to 0.5 linear, 188 once encoded in sRGB
+  const FrameData frame = makeFrame(2, 1, GL_RGB8, {0, 0, 0, 255, 255, 255});
+  const Thumbnail thumbnail = createThumbnail(frame, ColorSpace::sRGB, 1);
+  ASSERT_EQ(3, thumbnail.pixels.size());
+  EXPECT_EQ(188, thumbnail.pixels[0]);
+}
+
+TEST(Thumbnails, createFlipsBottomUpFrames) {
+  FrameData frame = makeFrame(1, 2, GL_RGB8, {0, 0, 0, 255, 255, 255});
+  attribute::set<attribute::DpxImageOrientation>(frame.attributes, 4);
+  const Thumbnail thumbnail = createThumbnail(frame, ColorSpace::sRGB, 2);
+  ASSERT_EQ(6, thumbnail.pixels.size());
+  EXPECT_EQ(255, thumbnail.pixels[0]);
+  EXPECT_EQ(0, thumbnail.pixels[3]);
+}
+
+TEST(ThumbnailEngine, generatesAllStreams) {
+  const FakeStream first(64, 32, false);
+  const FakeStream second(16, 16, true);
+  const FakeStream third(10, 40, false);
+  ThumbnailEngine engine({&first, &second, &third}, 8, ColorSpace::sRGB, "", 2);
+  std::vector<ThumbnailEngine::Result> results;
+  while (engine.isPending()) {
+    engine.collect(results);
+    std::this_thread::yield();
+  }
+  ASSERT_EQ(3, results.size());
+  std::sort(results.begin(), results.end(),
+            [](const ThumbnailEngine::Result& a, const ThumbnailEngine::Result& b) { return a.index < b.index; });
+  EXPECT_EQ(8, results[0].thumbnail.width);
+  EXPECT_EQ(4, results[0].thumbnail.height);
+  EXPECT_EQ("unreadable", results[1].error);
+  EXPECT_EQ(2, results[2].thumbnail.width);
+  EXPECT_EQ(8, results[2].thumbnail.height);
+  EXPECT_EQ(MAX_PROXY_LEVEL, first.requestedProxyLevel);
+}
+
+TEST(ThumbnailEngine, slowStreamHoldsOnlyItsThread) {
+  std::atomic<bool> released(false);
+  const BlockingStream slow(released);
+  const FakeStream first(8, 8, false);
+  const FakeStream second(8, 8, false);
+  const FakeStream third(8, 8, false);
+  ThumbnailEngine engine({&slow, &first, &second, &third}, 8, ColorSpace::sRGB, "", 2);
+  std::vector<ThumbnailEngine::Result> results;
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (results.size() < 3 && std::chrono::steady_clock::now() < deadline) {
+    engine.collect(results);
+    std::this_thread::yield();
+  }
+  // the other thread went through all the remaining streams
+  EXPECT_EQ(3, results.size());
+  released = true;
+  while (engine.isPending()) {
+    engine.collect(results);
+    std::this_thread::yield();
+  }
+  ASSERT_EQ(4, results.size());
+  EXPECT_EQ(0, results.back().index);
+}
+
+TEST(ThumbnailCache, roundTrip) {
+  const std::string directory = createTemporaryDirectory("duke-thumbnails");
+  const std::string media = directory + "/media.dpx";
+  writeFile(media, "first");
+  const ThumbnailCache cache(directory + "/cache");
+  ASSERT_TRUE(cache.isEnabled());
+  Thumbnail thumbnail;
+  thumbnail.width = 2;
+  thumbnail.height = 1;
+  thumbnail.pixels = {1, 2, 3, 4, 5, 6};
+  Thumbnail loaded;
+  EXPECT_FALSE(cache.load(media, 64, loaded));
+  EXPECT_TRUE(cache.store(media, 64, thumbnail));
+  ASSERT_TRUE(cache.load(media, 64, loaded));
+  EXPECT_EQ(thumbnail.width, loaded.width);
+  EXPECT_EQ(thumbnail.height, loaded.height);
+  EXPECT_EQ(thumbnail.pixels, loaded.pixels);
+  EXPECT_FALSE(cache.load(media, 128, loaded)) << "another thumbnail size";
+  writeFile(media, "edited");
+  EXPECT_FALSE(cache.load(media, 64, loaded)) << "the file size changed";
+  EXPECT_FALSE(cache.store(directory + "/missing.dpx", 64, thumbnail));
+  removeDirectory(directory + "/cache");
+  removeDirectory(directory);
+}
+
+TEST(ThumbnailCache, disabled) {
+  const ThumbnailCache cache("");
+  EXPECT_FALSE(cache.isEnabled());
+  Thumbnail thumbnail;
+  EXPECT_FALSE(cache.load("/", 64, thumbnail));
+}
+
+TEST(ContactSheet, atlasLayout) {
+  const AtlasLayout layout{1024, 256};
+  EXPECT_EQ(4, layout.getCellsPerRow());
+  EXPECT_EQ(16, layout.getCellsPerPage());
+  EXPECT_EQ(0, layout.getPage(15));
+  EXPECT_EQ(1, layout.getPage(16));
+  EXPECT_EQ(glm::ivec2(0, 0), layout.getOrigin(0));
+  EXPECT_EQ(glm::ivec2(768, 256), layout.getOrigin(7));
+  EXPECT_EQ(glm::ivec2(256, 0), layout.getOrigin(17));
+}
+
+TEST(ContactSheet, grid) {
+  const ContactSheetGrid grid{100, 10, 20};
+  EXPECT_EQ(1, grid.getColumns(50));
+  EXPECT_EQ(3, grid.getColumns(340));
+  EXPECT_EQ(2, grid.getColumns(339));
+  EXPECT_EQ(glm::ivec2(10, 10), grid.getOrigin(0, 340));
+  EXPECT_EQ(glm::ivec2(230, 140), grid.getOrigin(5, 340));
+  EXPECT_EQ(10, grid.getHeight(0, 340));
+  EXPECT_EQ(10 + 2 * 130, grid.getHeight(4, 340));
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <duke/engine/cache/TileLayout.hpp>
+
+using namespace duke;
+
+TEST(TileLayout, singleTile) {
+  const auto tiles = getTileLayout(100, 50, 128);
+  ASSERT_EQ(1UL, tiles.size());
+  EXPECT_EQ(0UL, tiles[0].x);
+  EXPECT_EQ(0UL, tiles[0].y);
+  EXPECT_EQ(100UL, tiles[0].width);
+  EXPECT_EQ(50UL, tiles[0].height);
+}
+
+TEST(TileLayout, lastRowAndColumnAreSmaller) {
+  const auto tiles = getTileLayout(300, 150, 128);
+  ASSERT_EQ(6UL, tiles.size());
+  // row major order
+  EXPECT_EQ(128UL, tiles[1].x);
+  EXPECT_EQ(0UL, tiles[1].y);
+  EXPECT_EQ(256UL, tiles[2].x);
+  EXPECT_EQ(44UL, tiles[2].width);
+  EXPECT_EQ(128UL, tiles[3].y);
+  EXPECT_EQ(22UL, tiles[3].height);
+  size_t area = 0;
+  for (const auto& tile : tiles) area += tile.width * tile.height;
+  EXPECT_EQ(300UL * 150UL, area);
+}
+
+TEST(TileLayout, empty) {
+  EXPECT_TRUE(getTileLayout(0, 0, 128).empty());
+  EXPECT_TRUE(getTileLayout(100, 100, 0).empty());
+}
+
+TEST(TileLayout, intersects) {
+  const TileRect tile{128, 128, 128, 128};
+  EXPECT_TRUE(tile.intersects(0, 0, 1000, 1000));
+  EXPECT_TRUE(tile.intersects(200, 200, 201, 201));
+  // bounds are excluded
+  EXPECT_FALSE(tile.intersects(0, 0, 128, 128));
+  EXPECT_FALSE(tile.intersects(256, 0, 512, 512));
+  EXPECT_FALSE(tile.intersects(0, 256, 512, 512));
+}
@@ -11,7 +11,7 @@ using namespace duke;
 
 class DummyMediaStream : public IMediaStream {
  public:
-  virtual ReadFrameResult process(const size_t frame) const override {
+  virtual ReadFrameResult process(const size_t frame, const attribute::Attributes& request) const override {
     ReadFrameResult result;
     result.status = IOResult::SUCCESS;
     return result;
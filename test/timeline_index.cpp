@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <duke/engine/TimelineIndex.hpp>
+#include <duke/engine/cache/TimelineIterator.hpp>
+#include <duke/engine/streams/IMediaStream.hpp>
+
+#include <random>
+
+using namespace std;
+using namespace duke;
+
+namespace {
+
+class IndexedMediaStream : public IMediaStream {
+ public:
+  virtual ReadFrameResult process(const size_t frame, const attribute::Attributes& request) const override {
+    return ReadFrameResult();
+  }
+  virtual bool isForwardOnly() const override { return false; }
+  virtual const attribute::Attributes& getState() const override {
+    static attribute::Attributes empty;
+    return empty;
+  }
+};
+
+vector<MediaFrameReference> scanTracks(const Timeline& timeline, size_t frame) {
+  vector<MediaFrameReference> references;
+  for (const Track& track : timeline) {
+    const auto mfr = track.getMediaFrameReferenceAt(frame);
+    if (mfr != MediaFrameReference()) references.push_back(mfr);
+  }
+  return references;
+}
+
+vector<MediaFrameReference> drain(TrackMediaFrameIterator& itr) {
+  vector<MediaFrameReference> references;
+  while (!itr.empty()) references.push_back(itr.next());
+  return references;
+}
+
+}  // namespace
+
+TEST(TimelineIndex, empty) {
+  EXPECT_TRUE(TimelineIndex().empty());
+  EXPECT_TRUE(TimelineIndex(Timeline()).getMediaRanges().empty());
+  Timeline timeline = {Track()};
+  timeline.back().add(0, Clip{10});
+  EXPECT_TRUE(TimelineIndex(timeline).empty()) << "clips without media are not indexed";
+}
+
+TEST(TimelineIndex, query) {
+  auto pStream = make_shared<IndexedMediaStream>();
+  Timeline timeline = {Track(), Track()};
+  timeline[0].add(0, Clip{10, pStream});
+  timeline[0].add(20, Clip{5, pStream});
+  timeline[1].add(8, Clip{4, pStream});
+  const TimelineIndex index(timeline);
+  EXPECT_EQ(Ranges({Range(0, 11), Range(20, 24)}), index.getMediaRanges());
+
+  vector<TimelineIndex::Entry> entries;
+  index.query(Range(12, 19), entries);
+  EXPECT_TRUE(entries.empty());
+  index.query(Range(9, 20), entries);
+  ASSERT_EQ(3UL, entries.size());
+  EXPECT_EQ(Range(0, 9), entries[0].range);
+  EXPECT_EQ(Range(20, 24), entries[1].range);
+  EXPECT_EQ(1UL, entries[2].track);
+  EXPECT_EQ(Range(8, 11), entries[2].range);
+}
+
+TEST(TimelineIndex, overlappingClips) {
+  auto pFirst = make_shared<IndexedMediaStream>();
+  auto pSecond = make_shared<IndexedMediaStream>();
+  auto pThird = make_shared<IndexedMediaStream>();
+  Timeline timeline = {Track()};
+  timeline[0].add(0, Clip{10, pFirst});
+  timeline[0].add(5, Clip{2, pSecond});
+  timeline[0].add(15, Clip{15, pThird});
+  timeline[0].add(20, Clip{5});  // without media
+  const TimelineIndex index(timeline);
+  EXPECT_EQ(Ranges({Range(0, 6), Range(15, 19)}), index.getMediaRanges());
+  TrackMediaFrameIterator itr;
+  const auto referencesAt = [&](size_t frame) {
+    itr.reset(&index, frame);
+    return drain(itr);
+  };
+  EXPECT_EQ(vector<MediaFrameReference>({MediaFrameReference(pFirst.get(), 4)}), referencesAt(4));
+  EXPECT_EQ(vector<MediaFrameReference>({MediaFrameReference(pSecond.get(), 0)}), referencesAt(5));
+  EXPECT_TRUE(referencesAt(8).empty()) << "the second clip hides the end of the first one";
+  EXPECT_EQ(vector<MediaFrameReference>({MediaFrameReference(pThird.get(), 1)}), referencesAt(16));
+  EXPECT_TRUE(referencesAt(22).empty()) << "a clip without media hides the clip below";
+  EXPECT_TRUE(referencesAt(27).empty());
+  for (size_t frame = 0; frame < 32; ++frame) EXPECT_EQ(scanTracks(timeline, frame), referencesAt(frame));
+}
+
+TEST(TimelineIndex, matchesTrackScan) {
+  mt19937 generator(42);
+  uniform_int_distribution<size_t> gap(0, 20);
+  uniform_int_distribution<size_t> length(1, 30);
+  uniform_int_distribution<size_t> overlap(0, 3);
+  vector<shared_ptr<IMediaStream>> streams;
+  Timeline tracks;
+  for (size_t track = 0; track < 12; ++track) {
+    tracks.emplace_back();
+    size_t start = gap(generator);
+    for (size_t clip = 0; clip < 20; ++clip) {
+      streams.push_back(make_shared<IndexedMediaStream>());
+      const size_t frames = length(generator);
+      tracks.back().add(start, Clip{frames, clip % 5 == 0 ? nullptr : streams.back()});
+      // one clip out of four overlaps the next one
+      start += overlap(generator) == 0 ? 1 + frames / 2 : frames + gap(generator);
+    }
+  }
+  const TimelineIndex index(tracks);
+  TrackMediaFrameIterator itr;
+  const Range range = tracks.getRange();
+  for (size_t frame = range.first; frame <= range.last + 1; ++frame) {
+    itr.reset(&index, frame);
+    EXPECT_EQ(scanTracks(tracks, frame), drain(itr)) << "frame " << frame;
+  }
+  // batches give the same references frame after frame
+  const vector<size_t> frames = {40, 41, 42, 43, 10, 11, 500, 3};
+  vector<MediaFrameReference> expected;
+  for (const size_t frame : frames)
+    for (const auto& mfr : scanTracks(tracks, frame)) expected.push_back(mfr);
+  itr.reset(&index, frames);
+  EXPECT_EQ(expected, drain(itr));
+}
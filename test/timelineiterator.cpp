@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <duke/engine/cache/TimelineIterator.hpp>
+#include <duke/engine/TimelineIndex.hpp>
 #include <duke/engine/Timeline.hpp>
 #include <duke/engine/streams/IMediaStream.hpp>
 
@@ -16,7 +17,7 @@ ostream &operator<<(ostream &stream, const Range &range) {
 
 class DummyMediaStream : public IMediaStream {
  public:
-  virtual ReadFrameResult process(const size_t frame) const override {
+  virtual ReadFrameResult process(const size_t frame, const attribute::Attributes &request) const override {
     ReadFrameResult result;
     result.status = IOResult::SUCCESS;
     return result;
@@ -39,7 +40,8 @@ TEST(TrackMediaFrameIterator, oneFrame) {
   Timeline timeline = {Track()};
   Track &track = timeline.back();
   track.add(0, Clip{1, pStream});
-  TrackMediaFrameIterator itr(&timeline, 0UL);
+  const TimelineIndex index(timeline);
+  TrackMediaFrameIterator itr(&index, 0UL);
   EXPECT_FALSE(itr.empty());
   EXPECT_EQ(MediaFrameReference(pStream.get(), 0UL), itr.next());
   EXPECT_TRUE(itr.empty());
@@ -49,7 +51,8 @@ TEST(TrackMediaFrameIterator, clear) {
   Timeline timeline = {Track()};
   Track &track = timeline.back();
   track.add(0, Clip{1, pStream});
-  TrackMediaFrameIterator itr(&timeline, 0UL);
+  const TimelineIndex index(timeline);
+  TrackMediaFrameIterator itr(&index, 0UL);
   EXPECT_FALSE(itr.empty());
   itr.clear();
   EXPECT_TRUE(itr.empty());
@@ -59,14 +62,16 @@ TEST(TrackMediaFrameIterator, outsideRange) {
   Timeline timeline = {Track()};
   Track &track = timeline.back();
   track.add(0, Clip{1, pStream});
-  EXPECT_TRUE(TrackMediaFrameIterator(&timeline, 1UL).empty());
+  const TimelineIndex index(timeline);
+  EXPECT_TRUE(TrackMediaFrameIterator(&index, 1UL).empty());
 }
 
 TEST(TrackMediaFrameIterator, noMedia) {
   Timeline timeline = {Track()};
   Track &track = timeline.back();
   track.add(0, Clip{1, nullptr});
-  EXPECT_TRUE(TrackMediaFrameIterator(&timeline, 0UL).empty());
+  const TimelineIndex index(timeline);
+  EXPECT_TRUE(TrackMediaFrameIterator(&index, 0UL).empty());
 }
 
 TEST(FrameIterator, emptiness) {
@@ -130,31 +135,44 @@ TEST(FrameIterator, limitedIterations) {
 TEST(TimelineIterator, emptiness) {
   EXPECT_TRUE(TimelineIterator().empty());
   Timeline timeline;
-  Ranges mediaRanges = getMediaRanges(timeline);
-  EXPECT_TRUE(TimelineIterator(&timeline, &mediaRanges, 0, IterationMode::FORWARD).empty());
+  TimelineIndex index(timeline);
+  EXPECT_TRUE(TimelineIterator(&index, 0, IterationMode::FORWARD).empty());
   timeline.emplace_back();  // adding an empty track
-  mediaRanges = getMediaRanges(timeline);
-  EXPECT_TRUE(TimelineIterator(&timeline, &mediaRanges, 0, IterationMode::FORWARD).empty());
+  index = TimelineIndex(timeline);
+  EXPECT_TRUE(TimelineIterator(&index, 0, IterationMode::FORWARD).empty());
 }
 
 TEST(TimelineIterator, oneFrameStartingFromTheFrame) {
   Timeline timeline = {Track()};
   Track &track = timeline.back();
   track.add(0, Clip{1, pStream});
-  const Ranges mediaRanges = getMediaRanges(timeline);
-  TimelineIterator itr(&timeline, &mediaRanges, 0, IterationMode::FORWARD);
+  const TimelineIndex index(timeline);
+  TimelineIterator itr(&index, 0, IterationMode::FORWARD);
   EXPECT_FALSE(itr.empty());
   EXPECT_EQ(MediaFrameReference(pStream.get(), 0), itr.next());
   EXPECT_TRUE(itr.empty());
 }
 
+TEST(TimelineIterator, proxyLevel) {
+  Timeline timeline = {Track()};
+  Track &track = timeline.back();
+  track.add(0, Clip{2, pStream});
+  const TimelineIndex index(timeline);
+  TimelineIterator itr(&index, 0, IterationMode::FORWARD, 2);
+  EXPECT_EQ(MediaFrameReference(pStream.get(), 0, 2), itr.next());
+  EXPECT_EQ(MediaFrameReference(pStream.get(), 1, 2), itr.next());
+  EXPECT_TRUE(itr.empty());
+  EXPECT_NE(MediaFrameReference(pStream.get(), 0, 2), MediaFrameReference(pStream.get(), 0));
+  EXPECT_TRUE(MediaFrameReference(pStream.get(), 0, 2).sameFrame(MediaFrameReference(pStream.get(), 0)));
+}
+
 TEST(TimelineIterator, oneFrameStartingFromElsewhere) {
   Timeline timeline = {Track()};
   Track &track = timeline.back();
   track.add(0, Clip{1, pStream});
-  const Ranges mediaRanges = getMediaRanges(timeline);
-  EXPECT_FALSE(mediaRanges.empty());
-  TimelineIterator itr(&timeline, &mediaRanges, 100, IterationMode::FORWARD);
+  const TimelineIndex index(timeline);
+  EXPECT_FALSE(index.getMediaRanges().empty());
+  TimelineIterator itr(&index, 100, IterationMode::FORWARD);
   EXPECT_FALSE(itr.empty());
   EXPECT_EQ(MediaFrameReference(pStream.get(), 0), itr.next());
   EXPECT_TRUE(itr.empty());
@@ -179,9 +197,9 @@ TEST(TimelineIterator, oneFrameStartingFromElsewhere) {
   const IMediaStream *pStream2 = track2.begin()->second.pStream.get();
   const IMediaStream *pStream3 = track3.begin()->second.pStream.get();
   const IMediaStream *pStream4 = track1.rbegin()->second.pStream.get();
-  const Ranges mediaRange = getMediaRanges(timeline);
+  const TimelineIndex index(timeline);
   {
-    TimelineIterator itr(&timeline, &mediaRange, 0, IterationMode::FORWARD);
+    TimelineIterator itr(&index, 0, IterationMode::FORWARD);
     EXPECT_FALSE(itr.empty());
     EXPECT_EQ(MediaFrameReference(pStream1, 0UL), itr.next());
     EXPECT_EQ(MediaFrameReference(pStream2, 0UL), itr.next());
@@ -193,7 +211,7 @@ TEST(TimelineIterator, oneFrameStartingFromElsewhere) {
     EXPECT_TRUE(itr.empty());
   }
   {
-    TimelineIterator itr(&timeline, &mediaRange, 1, IterationMode::FORWARD);
+    TimelineIterator itr(&index, 1, IterationMode::FORWARD);
     EXPECT_FALSE(itr.empty());
     EXPECT_EQ(MediaFrameReference(pStream2, 0UL), itr.next());
     EXPECT_EQ(MediaFrameReference(pStream2, 1UL), itr.next());
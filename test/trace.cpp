@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <duke/time/Trace.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace duke::trace;
+
+namespace {
+
+size_t countNamed(const std::vector<Event>& events, const std::string& name) {
+  return std::count_if(events.begin(), events.end(), [&](const Event& event) { return event.pName == name; });
+}
+
+}  // namespace
+
+TEST(Trace, disabled) {
+  setEnabled(true);
+  setEnabled(false);
+  { DUKE_TRACE_SCOPE("disabled"); }
+  EXPECT_EQ(0, countNamed(collect(), "disabled"));
+}
+
+TEST(Trace, scope) {
+  setEnabled(true);
+  {
+    DUKE_TRACE_FRAME(12, nullptr);
+    DUKE_TRACE_SCOPE("outer");
+    { DUKE_TRACE_SCOPE("inner"); }
+  }
+  { DUKE_TRACE_SCOPE("no frame"); }
+  setEnabled(false);
+  const auto events = collect();
+  ASSERT_EQ(3, events.size());
+  // ordered by start time, nested scopes start later
+  EXPECT_STREQ("outer", events[0].pName);
+  EXPECT_STREQ("inner", events[1].pName);
+  EXPECT_STREQ("no frame", events[2].pName);
+  EXPECT_EQ(12, events[0].frame);
+  EXPECT_EQ(12, events[1].frame);
+  EXPECT_EQ(-1, events[2].frame);
+  EXPECT_LE(events[1].duration, events[0].duration);
+}
+
+TEST(Trace, enablingDiscardsEvents) {
+  setEnabled(true);
+  { DUKE_TRACE_SCOPE("first"); }
+  setEnabled(true);
+  EXPECT_EQ(0, countNamed(collect(), "first"));
+  setEnabled(false);
+}
+
+TEST(Trace, enablingWhileRecordingKeepsLaterEvents) {
+  setEnabled(true);
+  std::atomic<bool> started(false);
+  std::atomic<bool> stop(false);
+  std::thread worker([&]() {
+    while (!stop) {
+      record("worker", 0, 1);
+      started = true;
+    }
+  });
+  while (!started) std::this_thread::yield();
+  setEnabled(true);  // discards the events so far, the worker keeps recording
+  record("main", 0, 1);
+  stop = true;
+  worker.join();
+  setEnabled(false);
+  const auto events = collect();
+  EXPECT_EQ(1, countNamed(events, "main"));
+  EXPECT_EQ(events.size(), countNamed(events, "worker") + 1);
+}
+
+TEST(Trace, ringKeepsLatestEvents) {
+  setEnabled(true);
+  for (size_t i = 0; i < kEventsPerThread + 10; ++i) record(i < 10 ? "old" : "new", i, i + 1);
+  setEnabled(false);
+  const auto events = collect();
+  EXPECT_EQ(kEventsPerThread, events.size());
+  EXPECT_EQ(0, countNamed(events, "old"));
+}
+
+TEST(Trace, threads) {
+  setEnabled(true);
+  std::thread worker([]() { DUKE_TRACE_SCOPE("worker"); });
+  worker.join();
+  { DUKE_TRACE_SCOPE("main"); }
+  setEnabled(false);
+  const auto events = collect();
+  ASSERT_EQ(2, events.size());
+  EXPECT_NE(events[0].thread, events[1].thread);
+}
+
+TEST(Trace, ringsOfExitedThreadsAreReused) {
+  setEnabled(true);
+  { DUKE_TRACE_SCOPE("main"); }
+  std::thread([]() { DUKE_TRACE_SCOPE("first worker"); }).join();
+  const size_t rings = getRingCount();
+  for (int i = 0; i < 8; ++i) std::thread([]() { DUKE_TRACE_SCOPE("worker"); }).join();
+  setEnabled(false);
+  EXPECT_EQ(rings, getRingCount());
+  // a reused ring still holds the events of its previous threads
+  const auto events = collect();
+  EXPECT_EQ(1, countNamed(events, "first worker"));
+  EXPECT_EQ(8, countNamed(events, "worker"));
+}
+
+TEST(Trace, chromeFormat) {
+  const int stream = 0;
+  std::vector<Event> events = {{"decode", 10, 5, 3, &stream, 1}, {"swap", 20, 1, -1, nullptr, 0}};
+  std::ostringstream oss;
+  writeChromeTrace(oss, events);
+  const std::string json = oss.str();
+  EXPECT_EQ(0, json.find("{\"traceEvents\":["));
+  EXPECT_NE(std::string::npos,
+            json.find("{\"name\":\"decode\",\"cat\":\"duke\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":10,\"dur\":5,"
+                      "\"args\":{\"frame\":3,"));
+  EXPECT_NE(std::string::npos, json.find("{\"name\":\"swap\",\"cat\":\"duke\",\"ph\":\"X\",\"pid\":1,\"tid\":0,"
+                                         "\"ts\":20,\"dur\":1}"));
+}